@@ -29,6 +29,7 @@ private:
   int_t          _npad;
 
   vector<real_t> _work;
+  vector<real_t> _swork;	// -- Sine-series traction, if symmetric.
 };
 
 void skewSymmetric    (Domain*,BCmgr*,AuxField**,AuxField**,FieldForce*);
@@ -38,4 +39,6 @@ void rotational1      (Domain*,BCmgr*,AuxField**,AuxField**,FieldForce*);
 void rotational2      (Domain*,BCmgr*,AuxField**,AuxField**,FieldForce*);
 void Stokes           (Domain*,BCmgr*,AuxField**,AuxField**,FieldForce*);
 
+void batchTransforms  (const bool);
+
 #endif
@@ -46,7 +46,6 @@ DNSAnalyser::DNSAnalyser (Domain* D   ,
     if (_wss) {
       // -- Set up to compute wall shear stresses.    
     
-      const int_t npr = Geometry::nProc();
       const int_t np  = Geometry::nP();
       const int_t nz  = Geometry::nZProc();
 
@@ -58,11 +57,15 @@ DNSAnalyser::DNSAnalyser (Domain* D   ,
 
       // -- Round up length for Fourier transform/exchange.
 
-      if   (npr > 1) _npad += 2 * npr - _npad % (2 * npr);
-      else           _npad += _npad % 2;
+      _npad = Geometry::padLength (_npad);
 
       _work.resize (_npad * nz);
 
+      // -- The spanwise traction is a sine series under symmetry, and
+      //    so is transformed separately from the other two.
+
+      if (Geometry::symmetric()) _swork.resize (_npad * nz);
+
       // -- Open file.
 
       ROOTONLY {
@@ -155,27 +158,51 @@ void DNSAnalyser::analyse (AuxField** work0,
 	const int_t    nZ  = Geometry::nZ();
 	const int_t    nZP = Geometry::nZProc();
 	const int_t    nPR = Geometry::nProc();
-	const int_t    nPP = _npad / nPR;
+	const int_t    nPP = Geometry::nBlock (_npad);
 	int_t          i, j, k;
 	real_t*        plane;
 	vector<real_t> buffer (_nline);
+	real_t*        stress;
 
 	// -- Load the local storage area.
 
 	Veclib::zero (_work.size(), &_work[0], 1);
+	if (Geometry::symmetric()) {
+	  Veclib::zero (_swork.size(), &_swork[0], 1);
+	  stress = &_swork[2*_nline];
+	} else
+	  stress = &_work [2*_nline];
 
 	if (NVEL == 3)
-	  Field::traction (&_work[0], &_work[_nline], &_work[2*_nline],
+	  Field::traction (&_work[0], &_work[_nline], stress,
 			   _nwall, _npad,
 			   _src->u[NADV], _src->u[0], _src->u[1], _src->u[2]);
 	else
-	  Field::traction (&_work[0], &_work[_nline], &_work[2*_nline],
+	  Field::traction (&_work[0], &_work[_nline], stress,
 			   _nwall, _npad,
 			   _src->u[NADV], _src->u[0], _src->u[1]);
 
 	// -- Inverse Fourier transform (like Field::bTransform).
 
-	if (nPR == 1) {
+	if (Geometry::symmetric()) {
+	  const int_t ntrn = (nPR == 1) ? _npad : nPP;
+
+	  if (nPR > 1) {
+	    Message::exchange (&_work [0], nZP, _npad, FORWARD);
+	    Message::exchange (&_swork[0], nZP, _npad, FORWARD);
+	  }
+	  Femlib::DCTr (&_work [0], nZ, ntrn, INVERSE);
+	  Femlib::DSTr (&_swork[0], nZ, ntrn, INVERSE);
+	  if (nPR > 1) {
+	    Message::exchange (&_work [0], nZP, _npad, INVERSE);
+	    Message::exchange (&_swork[0], nZP, _npad, INVERSE);
+	  }
+
+	  for (i = 0; i < nZP; i++)
+	    Veclib::copy (_nline, &_swork[i*_npad + 2*_nline], 1,
+			          &_work [i*_npad + 2*_nline], 1);
+
+	} else if (nPR == 1) {
 	  if (nZ > 1)
 	    if (nZ == 2)
 	      Veclib::copy (_npad, &_work[0], 1, &_work[_npad], 1);
@@ -242,7 +269,7 @@ void DNSAnalyser::analyse (AuxField** work0,
 				 "unable to write binary output", ERROR);
 	      }
 	      for (k = 1; k < nPR; k++)
-		for (i = 0; i < nZP; i++) {
+		for (i = 0; i < Geometry::nZProc (k); i++) {
 		  Message::recv (&buffer[0], _nline, k);
 		  _wss_strm.write(reinterpret_cast<char*>(&buffer[0]),
 				  static_cast<int_t>(_nline * sizeof(real_t))); 
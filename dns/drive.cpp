@@ -11,6 +11,28 @@
 //   -chk     ... turn off checkpoint field dumps [default: selected]
 //   -S|C|N   ... regular skew-symm || convective || Stokes advection
 //   -f       ... freeze velocity field (to advect scalar, only)
+//   -s       ... Newton--Krylov solve for steady state (see newton.cpp)
+//   -e <num> ... integrate an ensemble of num realisations in lockstep
+//
+// ENSEMBLES
+// ---------
+// With -e, num members (realisations) of the session are integrated
+// in lockstep by the one (set of) process(es).  They share elements,
+// mesh, boundary and numbering systems and (in integrate) matrix
+// factorisations, which are all made only once.  Each member has its
+// own Domain fields, field forcing, multistep and computed-BC history
+// and analyser.  Member k is named session.k: it restarts from
+// session.k.rst if that exists (else from session.rst) and writes
+// session.k.fld, session.k.his, etc.  Members thus differ by initial
+// condition or by the realisation of any random forcing.  All must
+// start at the same time, and D_T (see DT_ADAPT) is common to all.
+//
+// At each step, Fourier transforms of the nonlinear terms are made
+// for all members by a single call to the transform routine, and
+// direct Helmholtz solves by a single multiple-RHS solve for each
+// mode (see AuxField::transform, Field::solve).  Z derivatives in the
+// nonlinear terms, OIFS substeps and iterative solves are still made
+// member by member.  Open BCs are not available with ensembles.
 //
 // AUTHOR:
 // ------
@@ -42,14 +64,20 @@
   static char prog[] = "dns";
 #endif
 
-static void getargs    (int, char**, bool&, char*&);
+static void getargs    (int, char**, bool&, int_t&, char*&);
 static void preprocess (const char*, FEML*&, Mesh*&, vector<Element*>&,
 			BCmgr*&, Domain*&, FieldForce*&);
+static void ensemble   (const int_t, const char*, FEML*,
+			vector<Domain*>&, vector<FieldForce*>&);
 
 void integrate (void (*)
 		(Domain*, BCmgr*, AuxField**, AuxField**, FieldForce*),
-		Domain*, BCmgr*, DNSAnalyser*, FieldForce*);
+		vector<Domain*>&, BCmgr*, vector<DNSAnalyser*>&,
+		vector<FieldForce*>&);
 void AdvectDiffuse (Domain*, BCmgr*, DNSAnalyser*);
+void Newton (void (*)
+	     (Domain*, BCmgr*, AuxField**, AuxField**, FieldForce*),
+	     Domain*, BCmgr*, FieldForce*);
 
 
 int main (int    argc,
@@ -65,12 +93,12 @@ int main (int    argc,
   char*            session;
   int              nproc = 1, iproc = 0, npart2d = 1;  
   bool             freeze = false;
+  int_t            k, nmem = 1;
   vector<Element*> elmt;
   FEML*            file;
   Mesh*            mesh;
   BCmgr*           bman;
   Domain*          domain;
-  DNSAnalyser*     analyst;
   FieldForce*      FF;
 
   Femlib::init  ();
@@ -79,31 +107,67 @@ int main (int    argc,
   Femlib::ivalue ("I_PROC", iproc);
   Femlib::ivalue ("N_PROC", nproc);
 
-  getargs (argc, argv, freeze, session);
+  getargs (argc, argv, freeze, nmem, session);
 
   preprocess (session, file, mesh, elmt, bman, domain, FF);
 
+  Profile::init (domain -> name);
+
   if ((!domain -> hasScalar()) && freeze)
     Veclib::alert (prog, "need scalar declared if velocity is frozen", ERROR);
+  if (freeze && Geometry::symmetric())
+    Veclib::alert (prog, "SYMMETRY not available with frozen velocity", ERROR);
+  if (freeze && Femlib::ivalue ("NEWTON"))
+    Veclib::alert (prog, "can't find steady state with frozen velocity", ERROR);
+  if (nmem > 1 && (freeze || Femlib::ivalue ("NEWTON")))
+    Veclib::alert (prog, "ensembles are only for Navier--Stokes runs", ERROR);
+
+  void (*advection) (Domain*, BCmgr*, AuxField**, AuxField**, FieldForce*);
+
+  // -- Alternating between skew-symmetric forms from one call to the
+  //    next makes no sense within OIFS substeps, nor for a Newton
+  //    map that must not depend on its previous calls: use the full form.
+
+  if ((Femlib::ivalue ("OIFS") > 0 || Femlib::ivalue ("NEWTON")) &&
+      Femlib::ivalue ("ADVECTION") == 1)
+    Femlib::ivalue ("ADVECTION", 0);
+
+  switch (Femlib::ivalue ("ADVECTION")) {
+  case 0: advection =    skewSymmetric; break;
+  case 1: advection = altSkewSymmetric; break;
+  case 2: advection =       convective; break;
+  case 3: advection =      rotational1; break;
+  case 4: advection =      rotational2; break;
+  case 5: advection =           Stokes; break;
+  default:
+    Veclib::alert (prog, "ADVECTION must be in range [0--5]", ERROR);
+    break;
+  }
+
+  vector<Domain*>      D  (1, domain);
+  vector<FieldForce*>  F  (1, FF);
+  vector<DNSAnalyser*> A  (nmem);
 
-  analyst = new DNSAnalyser (domain, bman, file);
+  if (nmem > 1) ensemble (nmem, session, file, D, F);
 
-  domain -> restart ();
+  for (k = 0; k < nmem; k++) {
+    A[k] = new DNSAnalyser (D[k], bman, file);
+    D[k] -> restart ((nmem > 1) ? session : 0);
+    if (D[k] -> time != D[0] -> time)
+      Veclib::alert (prog, "ensemble members must restart at one time",
+		     ERROR);
+  }
 
   ROOTONLY domain -> report ();
   
   if (freeze) 
-    AdvectDiffuse (domain, bman, analyst); // -- Velocity field doesn't evolve.
-  else {
-    switch (Femlib::ivalue ("ADVECTION")) {
-    case 0: integrate (   skewSymmetric,domain,bman,analyst,FF); break;
-    case 1: integrate (altSkewSymmetric,domain,bman,analyst,FF); break;
-    case 2: integrate (      convective,domain,bman,analyst,FF); break;
-    case 3: integrate (     rotational1,domain,bman,analyst,FF); break;
-    case 4: integrate (     rotational2,domain,bman,analyst,FF); break;
-    case 5: integrate (          Stokes,domain,bman,analyst,FF); break;
-    }
-  }
+    AdvectDiffuse (domain, bman, A[0]); // -- Velocity doesn't evolve.
+  else if (Femlib::ivalue ("NEWTON"))
+    Newton    (advection, domain, bman, FF);
+  else
+    integrate (advection, D, bman, A, F);
+
+  Profile::report ();
 
   Message::stop ();
 
@@ -114,6 +178,7 @@ int main (int    argc,
 static void getargs (int    argc   ,
 		     char** argv   ,
 		     bool&  freeze ,
+		     int_t& nmem   ,
 		     char*& session)
 // ---------------------------------------------------------------------------
 // Install default parameters and options, parse command-line for optional
@@ -129,7 +194,9 @@ static void getargs (int    argc   ,
     "  -i       ... use iterative solver for viscous steps\n"
     "  -v[v...] ... increase verbosity level\n"
     "  -chk     ... turn off checkpoint field dumps [default: selected]\n"
-    "  -S|C|N   ... regular skew-symm || convective || Stokes advection\n";
+    "  -S|C|N   ... regular skew-symm || convective || Stokes advection\n"
+    "  -s       ... Newton--Krylov solve for steady state\n"
+    "  -e <num> ... integrate an ensemble of num realisations in lockstep\n";
 
   Femlib::ivalue ("ADVECTION", 1); // -- Default is alternating skew symmetric.
 
@@ -143,9 +210,14 @@ static void getargs (int    argc   ,
     case 'S': Femlib::ivalue ("ADVECTION", 0); break;
     case 'C': Femlib::ivalue ("ADVECTION", 2); break;
     case 'N': Femlib::ivalue ("ADVECTION", 5); break;
+    case 's': Femlib::ivalue ("NEWTON",    1); break;
     case 'f':
       freeze = true;
       break;
+    case 'e':
+      if (*++argv[0]) nmem = atoi (  *argv);
+      else { --argc;  nmem = atoi (*++argv); }
+      break;
     case 'i':
       do			// -- Only allowing ITERATIVE=1 (Viscous).
 	Femlib::ivalue ("ITERATIVE", 1);
@@ -267,3 +339,38 @@ static void preprocess (const char*       session,
   if (Femlib::ivalue ("SVV_MZ") > Geometry::nMode())
     Veclib::alert (routine, "SVV_MZ exceeds N_Z/2", ERROR);
 }
+
+
+static void ensemble (const int_t          nmem   ,
+		      const char*          session,
+		      FEML*                file   ,
+		      vector<Domain*>&     D      ,
+		      vector<FieldForce*>& FF     )
+// ---------------------------------------------------------------------------
+// Set up the nmem members of an ensemble.  On entry D and FF hold the
+// Domain and FieldForce made by preprocess, which go to member 0.
+// The others get a Domain of their own that shares elements,
+// boundary and numbering systems with the first (see Domain::Domain),
+// and field forcing for that Domain.  Member k is named session.k so
+// that member files are distinct.
+// ---------------------------------------------------------------------------
+{
+  char  name[StrMax];
+  int_t k;
+
+  D .resize (nmem);
+  FF.resize (nmem);
+
+  for (k = 0; k < nmem; k++) {
+    sprintf (name, "%s.%d", session, static_cast<int>(k));
+    if (k) {
+      D [k] = new Domain     (D[0], name);
+      FF[k] = new FieldForce (D[k], file);
+    } else {
+      delete [] D[0] -> name;
+      strcpy ((D[0] -> name = new char [strlen (name) + 1]), name);
+    }
+  }
+
+  ROOTONLY cout << "-- Ensemble members        : " << nmem << endl;
+}
@@ -32,7 +32,9 @@ static int_t NCOM; // -- Number of velocity components.
 
 FieldForce::FieldForce (Domain* D   ,
                         FEML*   file) :
-  _D (D)
+  _D           (D),
+  _suspended   (false),
+  _CFB_enabled (false)
 // ---------------------------------------------------------------------------
 // This constructor deals with <FORCING> section of FEML file.
 // It maintains a list of forcing subclasses, initialized here.
@@ -62,7 +64,6 @@ FieldForce::FieldForce (Domain* D   ,
   //    but it seems cleanest to bury it within the FieldForce class.
   //    See Blackburn, Lopez, Singh and Smits (2021).
 
-  _CFB_enabled  = false;
   _CFB_T_REF    = 0.0;
   _CFB_BETA_T   = 0.0;
   _CFB_no_hydro = 1;
@@ -122,9 +123,12 @@ void FieldForce::addPhysical (AuxField*          Ni ,
 // the forcing component.
 //
 // U contains NADV advected fields (here, supplied in physical space).
+//
+// While suspended (for advection-only evaluations of the nonlinear
+// terms, see OIFS in integrate.cpp) nothing is added.
 // ---------------------------------------------------------------------------
 {
-  if (!_enabled) return;
+  if (!_enabled || _suspended) return;
 
   // -- Clear summation buffer.
 
@@ -155,7 +159,7 @@ void FieldForce::subPhysical (AuxField*          Ni ,
 // contributions.
 // ---------------------------------------------------------------------------
 {
-  if (!_enabled) return;
+  if (!_enabled || _suspended) return;
 
   *buf = 0.0;
 
@@ -191,6 +195,33 @@ void FieldForce::writeAux (vector<AuxField *>& N)
 }
 
 
+void FieldForce::writeState (ostream& strm)
+// ---------------------------------------------------------------------------
+// Write the internal state of those body forcing classes that carry
+// any from step to step, for an exact warm restart.
+// ---------------------------------------------------------------------------
+{
+  if (!_enabled) return;
+
+  vector<VirtualForce*>::iterator p;
+  for (p = _classes.begin(); p != _classes.end(); p++)
+    (*p) -> writeState (strm);
+}
+
+
+void FieldForce::readState (istream& strm)
+// ---------------------------------------------------------------------------
+// Inverse of writeState.
+// ---------------------------------------------------------------------------
+{
+  if (!_enabled) return;
+
+  vector<VirtualForce*>::iterator p;
+  for (p = _classes.begin(); p != _classes.end(); p++)
+    (*p) -> readState (strm);
+}
+
+
 void FieldForce::canonicalSteadyBoussinesq (AuxField*          work ,
 					    vector<AuxField*>& Uphys,
 					    vector<AuxField*>& N    )
@@ -203,7 +234,7 @@ void FieldForce::canonicalSteadyBoussinesq (AuxField*          work ,
 //  within the FieldForce class.
 //  ---------------------------------------------------------------------------
 {
-  if (!_CFB_enabled) return;
+  if (!_CFB_enabled || _suspended) return;
 
   int_t i;
 
@@ -236,7 +267,7 @@ AuxField* VirtualForce::allocAuxField (Domain *D         ,
   const int_t nTotP = Geometry::nTotProc();
   const int_t nzP   = Geometry::nZProc();
 
-  return new AuxField (new real_t [(size_t)nTotP], nzP, D->elmt, type);
+  return new AuxField (Storage::allocate (nTotP, nzP), nzP, D->elmt, type);
 }
 
 
@@ -819,6 +850,7 @@ SFDForce::SFDForce (Domain* D   ,
 
   _enabled = false;
   _SFD_DELTA = _SFD_CHI = 0.0;
+  _nstep = 0;
 
   if (!(file -> valueFromSection (&_SFD_DELTA, "FORCE", "SFD_DELTA") &&
 	file -> valueFromSection (&_SFD_CHI,   "FORCE", "SFD_CHI"  ))) return;
@@ -856,13 +888,12 @@ void SFDForce::add (AuxField*          ff ,
   const char   routine[] = "SFDForce::add";
   const int_t  verbose   = Femlib::ivalue ("VERBOSE");
   const real_t dt        = Femlib::value  ("D_T");
-  static int_t step      = 0;  // -- Flag restart.
 
   if (!_enabled) return;
 
   // -- Restart qbar from previous velocity field.
   
-  if (step < NCOM) *_a[com] = *U[com];
+  if (_nstep < NCOM) *_a[com] = *U[com];
 
   // -- Subtract CHI*(u-ubar) from -nonlinear terms.
 
@@ -874,7 +905,36 @@ void SFDForce::add (AuxField*          ff ,
   *_a[com] *= 1.0 - dt / _SFD_DELTA;
   _a[com]  -> axpy (dt / _SFD_DELTA, *U[com]);
 
-  step++;
+  _nstep++;
+}
+
+
+void SFDForce::writeState (ostream& strm)
+// ---------------------------------------------------------------------------
+// Write filtered velocity qbar for an exact warm restart.
+// ---------------------------------------------------------------------------
+{
+  int_t i;
+
+  if (!_enabled) return;
+
+  for (i = 0; i < NCOM; i++) strm << *_a[i];
+}
+
+
+void SFDForce::readState (istream& strm)
+// ---------------------------------------------------------------------------
+// Inverse of writeState.  Since qbar is then already converged as far
+// as before, it is not restarted from the velocity field.
+// ---------------------------------------------------------------------------
+{
+  int_t i;
+
+  if (!_enabled) return;
+
+  for (i = 0; i < NCOM; i++) strm >> *_a[i];
+
+  _nstep = NCOM;
 }
 
 
@@ -12,8 +12,10 @@ public:
   AuxField* allocAuxField      (Domain*, char);
   void      readSteadyFromFile (char*, vector<AuxField*>&);
 
-  virtual void add      (AuxField*, const int_t, vector<AuxField*>&) {};
-  virtual void subtract (AuxField*, const int_t, vector<AuxField*>&) {};
+  virtual void add        (AuxField*, const int_t, vector<AuxField*>&) {};
+  virtual void subtract   (AuxField*, const int_t, vector<AuxField*>&) {};
+  virtual void writeState (ostream&) {};
+  virtual void readState  (istream&) {};
 
 protected:
   Domain*           _D;
@@ -34,6 +36,10 @@ public:
   void addPhysical (AuxField*, AuxField*, const int_t, vector<AuxField*>&);
   void subPhysical (AuxField*, AuxField*, const int_t, vector<AuxField*>&);
   void writeAux	   (vector<AuxField*>&);
+  void writeState  (ostream&);
+  void readState   (istream&);
+  void suspend     (const bool s) { _suspended = s; }
+  bool enabled     () const       { return _enabled; }
 
   void canonicalSteadyBoussinesq (AuxField*,
 				  vector<AuxField*>&, vector<AuxField*>&);
@@ -41,6 +47,7 @@ public:
 protected:
   Domain*		_D;
   bool			_enabled;
+  bool			_suspended; // -- Held off, see suspend().
   vector<VirtualForce*> _classes;   // -- Concrete body forcing classes.
 private:
   real_t _CFB_T_REF, _CFB_BETA_T;
@@ -179,9 +186,12 @@ class SFDForce : virtual public VirtualForce
 {
 public:
   SFDForce (Domain*, FEML*);
-  void add (AuxField*, const int_t, vector<AuxField*>&);
+  void add        (AuxField*, const int_t, vector<AuxField*>&);
+  void writeState (ostream&);
+  void readState  (istream&);
 private:
   real_t _SFD_DELTA, _SFD_CHI;
+  int_t  _nstep;		// -- Number of calls to add, flags restart.
 };
 
 
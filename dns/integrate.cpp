@@ -22,6 +22,18 @@
 //
 // Optionally integrate concentration of advected scalar field c.
 //
+// With OIFS set, advection is instead integrated by Runge--Kutta
+// substeps within each D_T, by operator-integration-factor splitting
+// [7], so that D_T is not held to the advective CFL limit.
+//
+// Several Domains (the members of an ensemble, see drive.cpp) may be
+// integrated together, in lockstep.
+//
+// With CHKPOINT set, a solver-state file session.sta is written with
+// every checkpoint dump.  If it is present and matches session.rst
+// on restart, the multistep history is taken from it and integration
+// carries on exactly, without low-order start-up steps.
+//
 // Copyright (c) 1994+, Hugh M Blackburn
 //
 // REFERENCES
@@ -41,6 +53,9 @@
 // [6] Blackburn, Lopez, Singh & Smits (2021) "On the Boussinesq
 //     approximation in arbitrarily accelerating frames of reference",
 //     JFM 924:R1.
+// [7] Maday, Patera & Ronquist (1990) "An operator-integration-factor
+//     splitting method for time-dependent problems: application to
+//     incompressible fluid flow", J Sci Comput 5:263--292.
 //w   
 ///////////////////////////////////////////////////////////////////////////////
 
@@ -52,17 +67,40 @@
 
 
 typedef ModalMatrixSys Msys;
+typedef void (*Advection) (Domain*, BCmgr*, AuxField**, AuxField**,
+			   FieldForce*);
 
 // -- File-scope constants and routines:
 
-static int_t NDIM, NCOM, NORD, NADV;
-static bool  C3D;
+static int_t  NDIM, NCOM, NORD, NADV;
+static int_t  NPRE;		// -- Steps taken before a warm restart.
+static int_t  RUNG;		// -- Index of D_T on DT_ADAPT ladder.
+static int_t  NSUB;		// -- OIFS advection substeps per D_T.
+static real_t DT0;		// -- D_T as set in session: top of ladder.
+static bool   C3D;
 
+static void   nonlinear (Advection, vector<Domain*>&, BCmgr*,
+			 vector<FieldForce*>&, vector<AuxField***>&,
+			 vector<AuxField***>&);
 static void   waveProp  (Domain*, const AuxField***, const AuxField***);
+static void   oifsProp  (Advection, Domain*, BCmgr*, FieldForce*,
+			 AuxField***, AuxField***, AuxField***, AuxField**);
+static void   advect    (Advection, Domain*, BCmgr*, FieldForce*,
+			 AuxField**, AuxField**, AuxField**, AuxField**);
 static void   setPForce (const AuxField**, AuxField**);
 static void   project   (const Domain*, AuxField**, AuxField**);
-static Msys** preSolve  (const Domain*);
-static void   Solve     (Domain*, const int_t, AuxField*, Msys*);
+static Msys** preSolve  (const Domain*, Msys*);
+static Msys** systems   (const Domain*);
+static real_t rung      (const int_t);
+static void   adaptStep (const Domain*, const vector<DNSAnalyser*>&);
+static void   Solve     (vector<Domain*>&, const int_t, AuxField**, Msys*);
+static void   dumpState (Domain*, BCmgr*, DNSAnalyser*, FieldForce*,
+			 AuxField***, AuxField***, AuxField***);
+static bool   readState (Domain*, BCmgr*, DNSAnalyser*, FieldForce*,
+			 AuxField***, AuxField***, AuxField***);
+
+void integrate (Advection, vector<Domain*>&, BCmgr*, vector<DNSAnalyser*>&,
+		vector<FieldForce*>&);
 
 
 void integrate (void (*advection) (Domain*    , 
@@ -75,164 +113,381 @@ void integrate (void (*advection) (Domain*    ,
                 DNSAnalyser* A ,
                 FieldForce*  FF)
 // ---------------------------------------------------------------------------
-// On entry, D contains storage (in the following order!) for:
+// Integrate the single Domain D, see below.  A may be NULL (as from
+// Newton), in which case results of each step are not analysed or
+// dumped.
+// ---------------------------------------------------------------------------
+{
+  vector<Domain*>      Dm (1, D);
+  vector<DNSAnalyser*> Am (1, A);
+  vector<FieldForce*>  Fm (1, FF);
+
+  integrate (advection, Dm, B, Am, Fm);
+}
+
+
+void integrate (void (*advection) (Domain*    , 
+                                   BCmgr*     ,
+                                   AuxField** , 
+                                   AuxField** ,
+                                   FieldForce*),
+                vector<Domain*>&      D ,
+                BCmgr*                B ,
+                vector<DNSAnalyser*>& A ,
+                vector<FieldForce*>&  FF)
+// ---------------------------------------------------------------------------
+// On entry, each D[m] contains storage (in the following order!) for:
 // -- velocity Fields 'u', 'v' (and 'w' if 2D3C or 3D),
 // -- optional scalar Field 'c',
 // -- constraint Field 'p'.
 //
 // Us is multi-level auxillary Field storage for velocities and
 // Uf is multi-level auxillary Field storage for nonlinear forcing terms.
+// With OIFS, Vs is multi-level storage for advected velocities and Ws
+// is workspace for their Runge--Kutta substeps.
+//
+// There is more than one Domain for an ensemble (see drive.cpp).  Its
+// members are stepped in lockstep, each having its own Us, Uf and Vs,
+// analyser A[m], forcing FF[m] and computed-BC storage in B (see
+// BCmgr::member).  Matrix systems are shared.  The Fourier transforms
+// of the nonlinear step are made for all members at once (see
+// nonlinear), as are the direct Helmholtz solves (see Solve).
 // ---------------------------------------------------------------------------
 {
-  NCOM = D -> nVelCmpt();              // -- Number of velocity components.
-  NADV = D -> nAdvect();               // -- Number of advected fields.
+  NCOM = D[0] -> nVelCmpt();           // -- Number of velocity components.
+  NADV = D[0] -> nAdvect();            // -- Number of advected fields.
   NDIM = Geometry::nDim();	       // -- Number of space dimensions.
   NORD = Femlib::ivalue ("N_TIME");    // -- Time integration order.
   C3D  = Geometry::cylindrical() && NDIM == 3;
   
-  int_t              i, j, k;
-  const real_t       dt    = Femlib:: value ("D_T");
-  const int_t        nStep = Femlib::ivalue ("N_STEP");
-  const int_t        nZ    = Geometry::nZProc();
-  static Msys**      MMS;
-  static AuxField*** Us;
-  static AuxField*** Uf;
-  Field*             Pressure = D -> u[NADV];
+  int_t                      i, j, k, m;
+  const int_t                nMem  = D.size();
+  const int_t                nStep = Femlib::ivalue ("N_STEP");
+  const int_t                nZ    = Geometry::nZProc();
+  static Msys**              MMS;
+  static vector<AuxField***> Us;
+  static vector<AuxField***> Uf;
+  static vector<AuxField***> Vs;
+  static AuxField**          Ws;
+  static bool                warm = true;
+  vector<Field*>             Pressure (nMem);
+  vector<AuxField*>          F        (nMem);
+
+  for (m = 0; m < nMem; m++) Pressure[m] = D[m] -> u[NADV];
 
   if (!MMS) {			// -- Initialise static storage.
 
     // -- Create multi-level storage for velocities (Us) and forcing (Uf).
 
-    const int_t ntot  = Geometry::nTotProc();
-    real_t*     alloc = new real_t [static_cast<size_t>(2 * NADV*NORD * ntot)];
-    Us                = new AuxField** [static_cast<size_t>(2 * NORD)];
-    Uf                = Us + NORD;
+    const int_t ntot = Geometry::nTotProc();
 
-    for (k = 0, i = 0; i < NORD; i++) {
-      Us[i] = new AuxField* [static_cast<size_t>(2 * NADV)];
-      Uf[i] = Us[i] + NADV;
-      for (j = 0; j < NADV; j++) {
-        Us[i][j] = new AuxField (alloc + k++ * ntot, nZ, D -> elmt);
-        Uf[i][j] = new AuxField (alloc + k++ * ntot, nZ, D -> elmt);
+    Us.resize (nMem);
+    Uf.resize (nMem);
+
+    for (m = 0; m < nMem; m++) {
+      real_t* alloc = Storage::allocate (2 * NADV*NORD * ntot,
+					 2 * NADV*NORD * nZ);
+      Us[m]         = new AuxField** [static_cast<size_t>(2 * NORD)];
+      Uf[m]         = Us[m] + NORD;
+
+      for (k = 0, i = 0; i < NORD; i++) {
+	Us[m][i] = new AuxField* [static_cast<size_t>(2 * NADV)];
+	Uf[m][i] = Us[m][i] + NADV;
+	for (j = 0; j < NADV; j++) {
+	  Us[m][i][j] = new AuxField (alloc + k++ * ntot, nZ, D[m] -> elmt);
+	  Uf[m][i][j] = new AuxField (alloc + k++ * ntot, nZ, D[m] -> elmt);
+	}
       }
     }
 
+    // -- Create multi-level storage for advected velocities (Vs)
+    //    and Runge--Kutta workspace (Ws) if OIFS is selected.
+
+    NSUB = Femlib::ivalue ("OIFS");
+
+    if (NSUB > 0) {
+      if (Geometry::cylindrical())
+	Veclib::alert ("integrate",
+		       "OIFS not available in cylindrical coordinates", ERROR);
+
+      Vs.resize (nMem);
+
+      for (m = 0; m < nMem; m++) {
+	real_t* work = Storage::allocate (NORD * NADV * ntot,
+					  NORD * NADV * nZ);
+	Vs[m]        = new AuxField** [static_cast<size_t>(NORD)];
+
+	for (k = 0, i = 0; i < NORD; i++) {
+	  Vs[m][i] = new AuxField* [static_cast<size_t>(NADV)];
+	  for (j = 0; j < NADV; j++)
+	    Vs[m][i][j] = new AuxField (work + k++ * ntot, nZ, D[m] -> elmt);
+	}
+      }
+
+      real_t* work = Storage::allocate (2 * NADV * ntot, 2 * NADV * nZ);
+      Ws           = new AuxField* [static_cast<size_t>(2 * NADV)];
+
+      for (j = 0; j < 2 * NADV; j++)
+	Ws[j] = new AuxField (work + j * ntot, nZ, D[0] -> elmt);
+    } else
+      Vs.assign (nMem, static_cast<AuxField***>(0));
+
     // -- Create global matrix systems.
 
-    MMS = preSolve (D);
+    DT0 = Femlib::value ("D_T");
+    MMS = systems (D[0]);
 
     // -- Create multi-level storage for pressure BCS.
 
-    B -> buildComputedBCs (Pressure, D -> hasScalar());
+    B -> buildComputedBCs (Pressure[0], D[0] -> hasScalar());
+    if (nMem > 1) B -> ensemble (nMem);
 
     // -- Apply coupling to radial & azimuthal velocity BCs.
 
-    if (C3D) Field::coupleBCs (D -> u[1], D -> u[2], FORWARD);
+    if (C3D)
+      for (m = 0; m < nMem; m++)
+	Field::coupleBCs (D[m] -> u[1], D[m] -> u[2], FORWARD);
   }
 
   // -- Because we may restart from scratch on each call, zero these:
 
-  *Pressure = 0.0;
+  for (m = 0; m < nMem; m++) {
+    *Pressure[m] = 0.0;
 
-  for (i = 0; i < NORD; i++)
-    for (j = 0; j < NADV; j++) {
-      *Us[i][j] = 0.0;
-      *Uf[i][j] = 0.0;
+    for (i = 0; i < NORD; i++)
+      for (j = 0; j < NADV; j++) {
+	*Us[m][i][j] = 0.0;
+	*Uf[m][i][j] = 0.0;
+	if (NSUB > 0) *Vs[m][i][j] = 0.0;
+      }
+  }
+
+  // -- On the first call only, pick up matching solver states, if
+  //    any.  Members of an ensemble must all have one, or none, and
+  //    they must be in step.
+
+  NPRE = 0;
+
+  if (warm) {
+    int_t nread = 0, npre = 0, krung = 0;
+
+    for (m = 0; m < nMem; m++) {
+      if (nMem > 1) B -> member (m);
+      if (!readState (D[m], B, A[m], FF[m], Us[m], Uf[m], Vs[m])) continue;
+      if (nread++ && (NPRE != npre || RUNG != krung))
+	Veclib::alert ("integrate",
+		       "solver states of ensemble members are not in step",
+		       ERROR);
+      npre  = NPRE;
+      krung = RUNG;
     }
 
+    if (nread && nread < nMem)
+      Veclib::alert ("integrate",
+		     "solver states found for only some ensemble members",
+		     ERROR);
+    warm = false;
+  }
+
 #if NONLIN_DIAGNOSTIC
   
   // -- Process input to generate nonlinear terms and quit (if nonzero).
   
-  advection (D, B, Us[0], Uf[0], FF);
-  D -> step += 1; D -> time += dt;
-  for (i = 0; i < NADV; i++) *D -> u[i] = *Uf[0][i];
-  A -> analyse (Us[0], Uf[0]);
+  for (m = 0; m < nMem; m++) {
+    advection (D[m], B, Us[m][0], Uf[m][0], FF[m]);
+    D[m] -> step += 1; D[m] -> time += Femlib::value ("D_T");
+    for (i = 0; i < NADV; i++) *D[m] -> u[i] = *Uf[m][0][i];
+    if (A[m]) A[m] -> analyse (Us[m][0], Uf[m][0]);
+  }
 
 #else  // -- Normal timestepping.
   
   // -- The following timestepping loop implements equations (15--18) in [5].
 
-  while (D -> step < nStep) {
+  while (D[0] -> step < nStep) {
+    const real_t dt = Femlib::value ("D_T");
 
     // -- Compute nonlinear terms from previous velocity field.
     //    Add physical space forcing, again at old time level.
     //    Outcomes are left in Uf[0], while the velocity fields
     //    for the last time level are left in Us[0].
 
-    advection (D, B, Us[0], Uf[0], FF);
+    Profile::start ("step");
+    Profile::start ("nonlinear");
+    nonlinear (advection, D, B, FF, Us, Uf);
+    Profile::stop  ("nonlinear");
 
-    D -> step += 1;
-    D -> time += dt;
-    Femlib::ivalue ("STEP", D -> step);
-    Femlib::value  ("t",    D -> time);
+    for (m = 0; m < nMem; m++) {
+      D[m] -> step += 1;
+      D[m] -> time += dt;
+    }
+    Integration::setStep (dt);
+    Femlib::ivalue ("STEP", D[0] -> step);
+    Femlib::value  ("t",    D[0] -> time);
 
     // -- Update high-order pressure BC storage, first in BCmgr, then
     //    in pressure Field BC area.
 
-    B -> maintainFourier (D -> step, Pressure,
-			  const_cast<const AuxField**>(Us[0]),
-			  const_cast<const AuxField**>(Uf[0]),
-			  NCOM, NADV);
-    Pressure -> evaluateBoundaries (Pressure, D -> step);
+    Profile::start ("pressure_bcs");
+    for (m = 0; m < nMem; m++) {
+      if (nMem > 1) B -> member (m);
+      B -> maintainFourier (D[m] -> step + NPRE, Pressure[m],
+			    const_cast<const AuxField**>(Us[m][0]),
+			    const_cast<const AuxField**>(Uf[m][0]),
+			    NCOM, NADV);
+      Pressure[m] -> evaluateBoundaries (Pressure[m], D[m] -> step + NPRE);
+    }
+    Profile::stop  ("pressure_bcs");
 
     // -- Complete unconstrained advective substep and compute
     //    pressure, which is left in D -> u[NADV].
 
-    if (Geometry::cylindrical()) { Us[0][0] -> mulY(); Us[0][1] -> mulY(); }
+    for (m = 0; m < nMem; m++) {
+      if (Geometry::cylindrical()) {
+	Us[m][0][0] -> mulY();
+	Us[m][0][1] -> mulY();
+      }
 
-    waveProp (D, const_cast<const AuxField***>(Us),
-	         const_cast<const AuxField***>(Uf));
-    for (i = 0; i < NADV; i++) AuxField::swapData (D -> u[i], Us[0][i]);
+      if (NSUB > 0)
+	oifsProp (advection, D[m], B, FF[m], Us[m], Uf[m], Vs[m], Ws);
+      else
+	waveProp (D[m], const_cast<const AuxField***>(Us[m]),
+		  const_cast<const AuxField***>(Uf[m]));
+      for (i = 0; i < NADV; i++) AuxField::swapData (D[m] -> u[i], Us[m][0][i]);
+
+      rollm     (Uf[m], NORD, NADV);
+      setPForce (const_cast<const AuxField**>(Us[m][0]), Uf[m][0]);
+      F[m] = Uf[m][0][0];
+    }
 
-    rollm     (Uf, NORD, NADV);
-    setPForce (const_cast<const AuxField**>(Us[0]), Uf[0]);
-    Solve     (D, NADV,  Uf[0][0], MMS[NADV]);
+    Profile::start ("pressure_solve");
+    Solve (D, NADV, &F[0], MMS[NADV]);
+    Profile::stop  ("pressure_solve");
 
-    // -- Correct velocities for pressure.
+    for (m = 0; m < nMem; m++) {
 
-    project   (D, Us[0], Uf[0]);
+      // -- Correct velocities for pressure.
 
-    // -- Update multilevel velocity storage.
+      project (D[m], Us[m][0], Uf[m][0]);
 
-    for (i = 0; i < NADV; i++) *Us[0][i] = *D -> u[i];
-    rollm (Us, NORD, NADV);
+      // -- Update multilevel velocity storage.
+
+      for (i = 0; i < NADV; i++) *Us[m][0][i] = *D[m] -> u[i];
+      rollm (Us[m], NORD, NADV);
+    }
 
     // -- Re-evaluate velocity (possibly time-dependent) BCs, some of
     //    which get made in physical space and then Fourier
-    //    transformed, while others (e.g. some computed types) may get
+    //    transformed (only those that vary in time are recomputed),
+    //    while others (e.g. some computed types) may get
     //    directly evaluated in Fourier space.  Whatever the method,
     //    the outcomes end up in the (Fourier-transformed) BC storage
     //    areas for the relevant Field.
 
-    for (i = 0; i < NADV; i++)  {
-      D -> u[i] -> evaluateBoundaries (NULL,     D -> step, false);
-      D -> u[i] -> bTransform         (FORWARD);
-      D -> u[i] -> evaluateBoundaries (Pressure, D -> step, true);
+    Profile::start ("velocity_bcs");
+    for (m = 0; m < nMem; m++) {
+      if (nMem > 1) B -> member (m);
+      for (i = 0; i < NADV; i++)  {
+	D[m] -> u[i] -> updateBoundaries   (D[m] -> step + NPRE);
+	D[m] -> u[i] -> evaluateBoundaries (Pressure[m], D[m] -> step + NPRE,
+					    true);
+      }
+      if (C3D) Field::coupleBCs (D[m] -> u[1], D[m] -> u[2], FORWARD);
     }
-    if (C3D) Field::coupleBCs (D -> u[1], D -> u[2], FORWARD);
+    Profile::stop  ("velocity_bcs");
 
     // -- Viscous correction substep to complete computation of
     //    velocity components (and, if relevant, scalar) for this time
     //    step.
 
-    if (C3D) {
-      AuxField::couple (Uf [0][1], Uf [0][2], FORWARD);
-      AuxField::couple (D -> u[1], D -> u[2], FORWARD);
-    }
-
+    if (C3D)
+      for (m = 0; m < nMem; m++) {
+	AuxField::couple (Uf[m][0][1], Uf[m][0][2], FORWARD);
+	AuxField::couple (D[m] -> u[1], D[m] -> u[2], FORWARD);
+      }
     
-    for (i = 0; i < NADV; i++) Solve (D, i, Uf[0][i], MMS[i]);
-    if (C3D) AuxField::couple (D -> u[1], D -> u[2], INVERSE);
+    // -- Matrix systems for the current D_T are only wanted (and
+    //    made, if new) once all the multistep history is at that D_T.
+
+    if (Integration::constantStep (NORD)) MMS = systems (D[0]);
+
+    Profile::start ("velocity_solve");
+    for (i = 0; i < NADV; i++) {
+      for (m = 0; m < nMem; m++) F[m] = Uf[m][0][i];
+      Solve (D, i, &F[0], MMS[i]);
+    }
+    if (C3D)
+      for (m = 0; m < nMem; m++)
+	AuxField::couple (D[m] -> u[1], D[m] -> u[2], INVERSE);
+    Profile::stop  ("velocity_solve");
 
     // -- Process results of this step.
 
-    A -> analyse (Us[0], Uf[0]);
+    Profile::start ("analyse");
+    if (A[0]) {
+      for (m = 0; m < nMem; m++) A[m] -> analyse (Us[m][0], Uf[m][0]);
+      adaptStep (D[0], A);
+      for (m = 0; m < nMem; m++) {
+	if (nMem > 1) B -> member (m);
+	dumpState (D[m], B, A[m], FF[m], Us[m], Uf[m], Vs[m]);
+      }
+    }
+    Profile::stop  ("analyse");
+    Profile::stop  ("step");
+    Profile::step  ();
   }
 #endif  
 }
 
 
+static void nonlinear (Advection             advection,
+		       vector<Domain*>&      D ,
+		       BCmgr*                B ,
+		       vector<FieldForce*>&  FF,
+		       vector<AuxField***>&  Us,
+		       vector<AuxField***>&  Uf)
+// ---------------------------------------------------------------------------
+// Compute nonlinear terms (and forcing) for each member of D, leaving
+// them in Uf[m][0] and a copy of the (Fourier) velocity in Us[m][0],
+// see nonlinear.cpp.
+//
+// For an ensemble, the transforms of velocity to physical space on
+// entry, and of nonlinear terms to Fourier space on exit, are made
+// for all members at once, one variable at a time (see
+// batchTransforms and AuxField::transform).
+// ---------------------------------------------------------------------------
+{
+  const int_t       nMem = D.size();
+  vector<AuxField*> F (nMem);
+  int_t             i, m;
+
+  if (nMem == 1) {
+    advection (D[0], B, Us[0][0], Uf[0][0], FF[0]);
+    return;
+  }
+
+  for (i = 0; i < NADV; i++) {
+    for (m = 0; m < nMem; m++) *Us[m][0][i] = *(F[m] = D[m] -> u[i]);
+    AuxField::transform (INVERSE, &F[0], nMem);
+  }
+
+  batchTransforms (true);
+  for (m = 0; m < nMem; m++) {
+    B -> member (m);
+    advection (D[m], B, Us[m][0], Uf[m][0], FF[m]);
+  }
+  batchTransforms (false);
+
+  for (i = 0; i < NADV; i++) {
+    for (m = 0; m < nMem; m++) F[m] = Uf[m][0][i];
+    AuxField::transform (FORWARD, &F[0], nMem);
+    for (m = 0; m < nMem; m++)
+      F[m] -> smooth (D[m] -> nGlobal(), D[m] -> assemblyNaive(),
+		      D[m] -> invMassNaive());
+  }
+}
+
+
 static void waveProp (Domain*           D ,
 		      const AuxField*** Us,
 		      const AuxField*** Uf)
@@ -255,12 +510,12 @@ static void waveProp (Domain*           D ,
     *H[i] = 0.0;
   }
 
-  const int_t    Je = min (D -> step, NORD);
+  const int_t    Je = min (D -> step + NPRE, NORD);
   vector<real_t> alpha (Integration::OrderMax + 1);
   vector<real_t> beta  (Integration::OrderMax);
 
-  Integration::StifflyStable (Je, &alpha[0]);
-  Integration::Extrapolation (Je, &beta [0]);
+  Integration::StifflyStable (Je, 0, &alpha[0]);
+  Integration::Extrapolation (Je, 0, &beta [0]);
   Blas::scal (Je, Femlib::value ("D_T"), &beta[0],  1);
 
   for (i = 0; i < NADV; i++)
@@ -271,6 +526,123 @@ static void waveProp (Domain*           D ,
 }
 
 
+static void oifsProp (Advection   advection,
+		      Domain*     D ,
+		      BCmgr*      B ,
+		      FieldForce* FF,
+		      AuxField*** Us,
+		      AuxField*** Uf,
+		      AuxField*** Vs,
+		      AuxField**  Ws)
+// ---------------------------------------------------------------------------
+// Operator-integration-factor alternative to waveProp [7].
+//
+// Each stored velocity level is carried forward to the new time level
+// under advection alone, i.e. the flow of dV/dt = N(V), so that the
+// nonlinear terms drop out of the stiffly-stable formula and only the
+// remaining forcing f = Uf - N is extrapolated:
+//
+//   u^ = - sum_q alpha_q V_q + D_T sum_q beta_q f_q.
+//
+// Since the advected levels V_q are samples of a smooth function of
+// time (the solution at t, advected on to the new time level), the
+// order of the scheme is unchanged.  Here V_0 starts from the newest
+// velocity in Us[0], while the older V_q were advected up to the
+// present time in previous steps and now need only one more D_T.
+//
+// On entry Uf[0] holds N + f at the old time; N is removed from it.
+// The advection routines need NADV fields of scratch for their copy
+// of the input velocity: the oldest level of Us serves, since only Vs
+// is used here.  (With N_TIME = 1 that is Us[0], already copied.)
+// ---------------------------------------------------------------------------
+{
+  int_t             i, q;
+  vector<AuxField*> H (NADV);
+
+  const int_t    Je = min (D -> step + NPRE, NORD);
+  vector<real_t> alpha (Integration::OrderMax + 1);
+  vector<real_t> beta  (Integration::OrderMax);
+
+  Integration::StifflyStable (Je, 0, &alpha[0]);
+  Integration::Extrapolation (Je, 0, &beta [0]);
+  Blas::scal (Je, Femlib::value ("D_T"), &beta[0],  1);
+
+  for (i = 0; i < NADV; i++) *Vs[0][i] = *Us[0][i];
+
+  Profile::start ("oifs");
+  FF -> suspend (true);
+  for (q = 0; q < Je; q++)
+    advect (advection, D, B, FF, Vs[q], Us[NORD - 1], Ws, (q) ? 0 : Uf[0]);
+  FF -> suspend (false);
+  Profile::stop  ("oifs");
+
+  for (i = 0; i < NADV; i++) {
+     H[i] = D -> u[i];
+    *H[i] = 0.0;
+    for (q = 0; q < Je; q++) {
+      H[i] -> axpy (-alpha[q + 1], *Vs[q][i]);
+      H[i] -> axpy ( beta [q]    , *Uf[q][i]);
+    }
+  }
+
+  rollm (Vs, NORD, NADV);
+}
+
+
+static void advect (Advection   advection,
+		    Domain*     D ,
+		    BCmgr*      B ,
+		    FieldForce* FF,
+		    AuxField**  V ,
+		    AuxField**  U ,
+		    AuxField**  W ,
+		    AuxField**  R )
+// ---------------------------------------------------------------------------
+// Advance V over D_T under advection alone, dV/dt = N(V), with NSUB
+// substeps of the classical fourth-order Runge--Kutta scheme.  U
+// (scratch for the advection routines) and W supply NADV and 2*NADV
+// AuxFields of workspace, and the field storage of D is overwritten.
+//
+// If R is given, it holds N(V) + f on entry (see oifsProp), and N(V)
+// is removed from it.  Without forcing, f = 0 and R is just the first
+// stage, so it is used as such rather than made again.  Otherwise it
+// must be: forcing can't be evaluated apart from N (it may carry state
+// from one call to the next, and CFB buoyancy scales N).
+// ---------------------------------------------------------------------------
+{
+  const real_t h    = Femlib::value ("D_T") / NSUB;
+  const real_t c[3] = { 0.5 * h, 0.5 * h, h };
+  const real_t b[4] = { h / 6.0, h / 3.0, h / 3.0, h / 6.0 };
+  const bool   keep = R && !FF -> enabled();
+  AuxField**   S    = W;		// -- Sum for V at end of substep.
+  AuxField**   N    = W + NADV;	// -- Stage nonlinear terms.
+  int_t        i, k, m;
+
+  for (k = 0; k < NSUB; k++) {
+    for (i = 0; i < NADV; i++) *S[i] = *D -> u[i] = *V[i];
+
+    for (m = 0; m < 4; m++) {
+      if (keep && !k && !m)
+	for (i = 0; i < NADV; i++) {
+	  AuxField::swapData (R[i], N[i]);
+	  *R[i] = 0.0;
+	}
+      else {
+	advection (D, B, U, N, FF);
+	if (R && !k && !m) for (i = 0; i < NADV; i++) *R[i] -= *N[i];
+      }
+
+      for (i = 0; i < NADV; i++) {
+	S[i] -> axpy (b[m], *N[i]);
+	if (m < 3) (*D -> u[i] = *V[i]) . axpy (c[m], *N[i]);
+      }
+    }
+
+    for (i = 0; i < NADV; i++) AuxField::swapData (S[i], V[i]);
+  }
+}
+
+
 static void setPForce (const AuxField** Us,
 		       AuxField**       Uf)
 // ---------------------------------------------------------------------------
@@ -326,11 +698,13 @@ static void project (const Domain* D ,
 }
 
 
-static Msys** preSolve (const Domain* D)
+static Msys** preSolve (const Domain* D,
+			Msys*         P)
 // ---------------------------------------------------------------------------
-// Set up ModalMatrixSystems for each Field of D.  If iterative solution
-// is selected for any Field, the corresponding ModalMatrixSystem pointer
-// is set to zero.
+// Set up ModalMatrixSystems for each Field of D, for the current D_T.
+// If iterative solution is selected for any Field, the corresponding
+// ModalMatrixSystem pointer is set to zero.  The pressure system does
+// not depend on D_T: if P is given, it is used again for pressure.
 //
 // ITERATIVE >= 1 selects iterative solver for velocity components,
 // ITERATIVE >= 2 selects iterative solver for non-zero pressure Fourier modes.
@@ -366,7 +740,9 @@ static Msys** preSolve (const Domain* D)
 
   // -- Pressure system.
 
-  if (itLev > 1)
+  if (P)
+    M[NADV] = P;
+  else if (itLev > 1)
     M[NADV] = new Msys
       (0.0, D -> VARKINVIS,  beta, base, nmodes, E, D -> b[NADV], D -> n[NADV], MIXED);
   else
@@ -377,37 +753,323 @@ static Msys** preSolve (const Domain* D)
 }
 
 
-static void Solve (Domain*     D,
-		   const int_t i,
-		   AuxField*   F,
-		   Msys*       M)
+static Msys** systems (const Domain* D)
 // ---------------------------------------------------------------------------
-// Solve Helmholtz problem for D -> u[i], using F as a forcing Field.
+// Return the matrix systems for the current D_T.  Those for each D_T
+// used are made by preSolve on first request and kept, so a return to
+// an earlier D_T (see adaptStep) costs nothing.
+// ---------------------------------------------------------------------------
+{
+  static map<real_t, Msys**>     cache;
+  const real_t                   dt = Femlib::value ("D_T");
+  map<real_t, Msys**>::iterator  p  = cache.find (dt);
+
+  if (p != cache.end()) return p -> second;
+
+  return cache[dt] =
+    preSolve (D, cache.empty() ? 0 : cache.begin() -> second[NADV]);
+}
+
+
+static real_t rung (const int_t k)
+// ---------------------------------------------------------------------------
+// Time step of rung k of the DT_ADAPT ladder.
+// ---------------------------------------------------------------------------
+{
+  return DT0 / pow (Femlib::value ("DT_RATIO"), static_cast<real_t>(k));
+}
+
+
+static void adaptStep (const Domain*               D,
+		       const vector<DNSAnalyser*>& A)
+// ---------------------------------------------------------------------------
+// With DT_ADAPT = n > 1, D_T is taken from the ladder of n time steps
+// D_T, D_T/DT_RATIO, ..., D_T/DT_RATIO^(n-1) (D_T as set in session)
+// so as to keep the peak CFL number, estimated every IO_CFL steps,
+// below CFL_MAX.  Steps down are taken at once, as far as needed.
+// Steps up are taken one rung at a time, only once the multistep
+// history is all at one D_T, and only if the CFL number would stay
+// below 0.8 * CFL_MAX.  Following a change, variable-step
+// coefficients are used (see Integration) until the history is all at
+// the new D_T, with temporary matrix systems (see Solve).
+//
+// The members of an ensemble (analysed by A) share D_T, which is set
+// by whichever has the highest CFL number.
+// ---------------------------------------------------------------------------
+{
+  const int_t nRung   = Femlib::ivalue ("DT_ADAPT");
+  const int_t cflStep = Femlib::ivalue ("IO_CFL");
+
+  if (nRung < 2 || !cflStep || D -> step % cflStep) return;
+
+  const real_t cflMax = Femlib::value ("CFL_MAX");
+  real_t       rate   = 0.0;
+  int_t        k      = RUNG;
+  int_t        m;
+
+  for (m = 0; m < A.size(); m++) rate = max (rate, 1.0 / A[m] -> dtMax());
+
+  if (rate * rung (k) > cflMax)
+    while (k < nRung - 1 && rate * rung (k) > cflMax) k++;
+  else if (k > 0 && Integration::constantStep (NORD) &&
+	   rate * rung (k - 1) < 0.8 * cflMax)
+    k--;
+
+  if (k == RUNG) return;
+
+  RUNG = k;
+  Femlib::value ("D_T", rung (RUNG));
+
+  ROOTONLY cout << "-- D_T set to " << rung (RUNG)
+		<< " (rung " << RUNG + 1 << " of " << nRung << ")" << endl;
+}
+
+
+static void Solve (vector<Domain*>& D,
+		   const int_t      i,
+		   AuxField**       F,
+		   Msys*            M)
+// ---------------------------------------------------------------------------
+// Solve Helmholtz problem for D[m] -> u[i], using F[m] as a forcing
+// Field, for each member m of D (together, see Field::solve).
 // Iterative or direct solver selected on basis of field type, step,
-// time order and command-line arguments.
+// time order, step size history and command-line arguments.
 // ---------------------------------------------------------------------------
 {
-  const int_t step = D -> step;
+  const int_t    nMem = D.size();
+  const int_t    step = D[0] -> step + NPRE;
+  vector<Field*> u (nMem);
+  int_t          m;
+
+  for (m = 0; m < nMem; m++) u[m] = D[m] -> u[i];
 
-  if (i < NADV && step < NORD) { // -- We need a temporary matrix system.
+  // -- We need a temporary matrix system while the time order or the
+  //    step size is not yet settled.
+
+  if (i < NADV && (step < NORD || !Integration::constantStep (NORD))) {
     const int_t Je     = min (step, NORD);
     const int_t base   = Geometry::baseMode();
     const int_t nmodes = Geometry::nModeProc();
 
     vector<real_t> alpha (Je + 1);
-    Integration::StifflyStable (Je, &alpha[0]);
+    Integration::StifflyStable (Je, 0, &alpha[0]);
     const real_t   lambda2 = (i == NCOM) ? // -- True for scalar diffusion.
       alpha[0] / Femlib::value ("D_T * KINVIS / PRANDTL") :
       alpha[0] / Femlib::value ("D_T * KINVIS");
     const real_t   beta    = Femlib::value ("BETA");
 
     Msys* tmp = new Msys
-      (lambda2, D -> VARKINVIS,  beta, base, nmodes, D -> elmt, D -> b[i], D -> n[i], JACPCG);
+      (lambda2, D[0] -> VARKINVIS,  beta, base, nmodes, D[0] -> elmt,
+       D[0] -> b[i], D[0] -> n[i], JACPCG);
 
-    D -> u[i] -> solve (F, tmp);
+    Field::solve (&u[0], F, nMem, tmp);
     delete tmp;
 
-  } else D -> u[i] -> solve (F, M);
+  } else Field::solve (&u[0], F, nMem, M);
 }
 
+static void dumpState (Domain*      D ,
+		       BCmgr*       B ,
+		       DNSAnalyser* A ,
+		       FieldForce*  FF,
+		       AuxField***  Us,
+		       AuxField***  Uf,
+		       AuxField***  Vs)
+// ---------------------------------------------------------------------------
+// With CHKPOINT set, at every field dump also write "name".sta (the
+// previous one is kept as "name".sta.bak).  This holds everything
+// needed to continue integration exactly from this step: all Domain
+// fields, the Us/Uf (and with OIFS, Vs) time levels, the computed-BC
+// storage of BCmgr, body-force filter state and running averages, all
+// exactly as held internally (mostly in Fourier space).  A short
+// header identifies the step, time and discretisation it belongs to.
+// See readState.
+// ---------------------------------------------------------------------------
+{
+  const int_t step     = D -> step;
+  const bool  periodic = !(step %  Femlib::ivalue ("IO_FLD"));
+  const bool  final    =   step == Femlib::ivalue ("N_STEP");
+
+  if (!(Femlib::ivalue ("CHKPOINT") && (periodic || final))) return;
+
+  const int_t nF = D -> nField();
+  int_t       i, j;
+  ofstream    output;
+
+  ROOTONLY {
+    const char routine[] = "dumpState";
+    char       statefl[StrMax], backup[StrMax], fmt[StrMax];
+
+    strcat (strcpy (statefl, D -> name), ".sta");
+    strcat (strcpy (backup,  D -> name), ".sta.bak");
+    rename (statefl, backup);	// -- Fails harmlessly if there is none.
+    output.open (statefl, ios::out);
+    if (!output) Veclib::alert (routine, "can't open state file", ERROR);
+
+    Veclib::describeFormat (fmt);
+    output << setprecision (17)
+	   << D -> name                  << " Solver state"      << endl
+	   << Geometry::nProc()  << " "  << Geometry::nElmt()    << " "
+	   << Geometry::nP()     << " "  << Geometry::nZ()       << " "
+	   << Geometry::symmetric()
+	   << " Processes, elements, size, planes, symmetry"      << endl
+	   << NORD << " " << Femlib::value ("D_T") << " " << NSUB
+	   << " Time order, time step, OIFS substeps"             << endl;
+    for (i = 0; i <= NORD; i++) output << Integration::step (i) << " ";
+    output << "Step history"                                      << endl
+	   << step + NPRE                << " Steps"             << endl
+	   << D -> time                  << " Time"              << endl
+	   << D -> field                 << " Fields"            << endl
+	   << fmt                                                 << endl;
+  }
+
+  for (i = 0; i < nF; i++) output << *D -> u[i];
+  for (i = 0; i < NORD; i++)
+    for (j = 0; j < NADV; j++) output << *Us[i][j] << *Uf[i][j];
+  if (NSUB > 0)
+    for (i = 1; i < NORD; i++)
+      for (j = 0; j < NADV; j++) output << *Vs[i][j];
+
+  B  -> writeState (output);
+  FF -> writeState (output);
+  A  -> writeState (output);
+
+  ROOTONLY output.close();
+}
+
+
+static bool readState (Domain*      D ,
+		       BCmgr*       B ,
+		       DNSAnalyser* A ,
+		       FieldForce*  FF,
+		       AuxField***  Us,
+		       AuxField***  Uf,
+		       AuxField***  Vs)
+// ---------------------------------------------------------------------------
+// Warm restart.  If "name".sta exists and was written at the time of
+// the restart file (i.e. alongside the checkpoint dump it came from)
+// by a run with the same discretisation, time step (or DT_ADAPT
+// ladder), order, use of OIFS and number of processes, load it over
+// the restart data and set NPRE to the number of steps already taken.
+// Integration then carries on at full order, exactly as if the
+// earlier run had not stopped, instead of taking low-order start-up
+// steps.  Otherwise the start is cold, as it always is when searching
+// for a steady state (dns -s).  Return true if the state was used.
+//
+// Only the root process opens and checks the file; its verdict and
+// the header values are broadcast so that all processes take the
+// same path (as for AuxField input, the data are then read by root
+// and distributed).
+// ---------------------------------------------------------------------------
+{
+  const char    routine[] = "readState";
+  const int_t   nF        = D -> nField();
+  const int_t   nRung     = max (1, Femlib::ivalue ("DT_ADAPT"));
+  char          statefl[StrMax];
+  int_t         i, j, k = 0, nstep = 0;
+  int_t         found = 0;	// -- 0: no file, 1: mismatch, 2: use it.
+  int_t         ihdr[3];
+  real_t        dt = 0.0, time = 0.0, h[Integration::OrderMax + 1];
+  real_t        rhdr[Integration::OrderMax + 3];
+  ifstream      file;
+
+  if (Femlib::ivalue ("NEWTON")) return false;
+
+  strcat (strcpy (statefl, D -> name), ".sta");
+
+  ROOTONLY {
+    char          s[StrMax], fmt[StrMax], fields[StrMax];
+    int_t         nproc, nel, np, nz, nord, nsub = 0, sym = 0;
+    string        ss;
+    istringstream sss;
+
+    file.open (statefl);
+    if (file) {
+      file.getline (s, StrMax).getline (s, StrMax);
+      sss.str (ss = s); sss >> nproc >> nel >> np >> nz >> sym;
+      file.getline (s, StrMax);
+      sss.clear(); sss.str (ss = s); sss >> nord >> dt >> nsub;
+      file.getline (s, StrMax);
+      sss.clear(); sss.str (ss = s);
+      for (i = 0; i <= min (nord, NORD); i++) sss >> h[i];
+      file.getline (s, StrMax);
+      sss.clear(); sss.str (ss = s); sss >> nstep;
+      file.getline (s, StrMax);
+      sss.clear(); sss.str (ss = s); sss >> time;
+      file.getline (s, StrMax);
+      sss.clear(); sss.str (ss = s); sss >> fields;
+      file.getline (s, StrMax);
+      Veclib::describeFormat (fmt);
+
+      for (k = 0; k < nRung && rung (k) != dt; k++);
+
+      found = (!file                             ||
+	       nproc != Geometry::nProc()        ||
+	       nel   != Geometry::nElmt()        ||
+	       np    != Geometry::nP()           ||
+	       nz    != Geometry::nZ()           ||
+	       sym   != Geometry::symmetric()    ||
+	       nord  != NORD                     ||
+	       (nsub > 0) != (NSUB > 0)          ||
+	       k     == nRung                    ||
+	       strcmp (fields, D -> field)       ||
+	       strcmp (s, fmt)                   ||
+	       fabs (time - D -> time) > 0.5 * dt) ? 1 : 2;
+    }
+  }
+
+  ihdr[0] = found; ihdr[1] = k; ihdr[2] = nstep;
+  Message::broadcast (ihdr, 3);
+  found = ihdr[0]; k = ihdr[1]; nstep = ihdr[2];
+
+  if (found == 0) return false;
+  if (found == 1) {
+    ROOTONLY Veclib::alert
+      (routine, "state file does not match restart, ignored", WARNING);
+    return false;
+  }
+
+  rhdr[0] = dt; rhdr[1] = time;
+  ROOTONLY Veclib::copy (NORD + 1, h, 1, rhdr + 2, 1);
+  Message::broadcast (rhdr, NORD + 3);
+  dt = rhdr[0]; time = rhdr[1];
+  Veclib::copy (NORD + 1, rhdr + 2, 1, h, 1);
+
+  ROOTONLY cout << "-- Solver state            : read from file "
+		<< statefl << endl;
+
+  for (i = 0; i < nF; i++) file >> *D -> u[i];
+
+  // -- Us/Uf/Vs take their z parity (if symmetric) from the Domain fields.
+
+  for (i = 0; i < NORD; i++)
+    for (j = 0; j < NADV; j++) {
+      *Us[i][j] = *D -> u[j]; file >> *Us[i][j];
+      *Uf[i][j] = *D -> u[j]; file >> *Uf[i][j];
+    }
+  if (NSUB > 0)
+    for (i = 1; i < NORD; i++)
+      for (j = 0; j < NADV; j++) {
+	*Vs[i][j] = *D -> u[j]; file >> *Vs[i][j];
+      }
+
+  B  -> readState (file);
+  FF -> readState (file);
+  A  -> readState (file);
+
+  ROOTONLY if (file.fail())
+    Veclib::alert (routine, "state file truncated", ERROR);
+
+  for (i = NORD; i >= 0; i--) Integration::setStep (h[i]);
+  RUNG = k;
+  Femlib::value ("D_T", dt);
+
+  NPRE      = nstep;
+  D -> time = time;
+  Femlib::value ("t", D -> time);
+
+  return true;
+}
+
+
 #undef NONLIN_DIAGNOSTIC
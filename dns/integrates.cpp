@@ -41,7 +41,7 @@ void AdvectDiffuse (Domain*      D,
   const int_t  nStep   = Femlib::ivalue ("N_STEP");
   const int_t  nZ      = Geometry::nZProc();
   const int_t  ntot    = Geometry::nTotProc();
-  real_t*      alloc   = new real_t [static_cast<size_t>(2*NORD*ntot)];
+  real_t*      alloc   = Storage::allocate (2*NORD*ntot, 2*NORD*nZ);
   Field        *scalar = D -> u[NCOM];
   AuxField     **Us,  **Uf;
 
@@ -81,8 +81,7 @@ void AdvectDiffuse (Domain*      D,
 
     // -- Re-evaluate (time-dependent) BCs?
 
-    scalar -> evaluateBoundaries (scalar, 0, false);
-    scalar -> bTransform (FORWARD);
+    scalar -> updateBoundaries (D -> step);
     D -> u[i] -> evaluateBoundaries (scalar, D -> step, true);
 
     // -- Diffusion substep.
@@ -148,6 +147,7 @@ static void advect (Domain*   D ,
   const int_t       nZ32   = Geometry::nZ32();
 #endif 
   const int_t       nTot32 = nZ32 * nP;
+  const int_t       nZT    = (nPR > 1) ? nZ : nZ32; // -- Planes in DFTs.
 
   Field*            master = D -> u[NCOM];
   AuxField*         N;
@@ -183,10 +183,10 @@ static void advect (Domain*   D ,
       if (nZ > 2) {
 	Veclib::copy       (nTot32, u32[NCOM], 1, tmp, 1);
 	Message::exchange   (tmp, nZ32,        nP, FORWARD);
-	Femlib::DFTr       (tmp, nZ32 * nPR, nPP, FORWARD);
+	Femlib::DFTr       (tmp, nZT,        nPP, FORWARD);
 	Veclib::zero       (nTot32 - nTot, tmp + nTot, 1);
 	master -> gradient (nZ, nPP, tmp, 2);
-	Femlib::DFTr       (tmp, nZ32 * nPR, nPP, INVERSE);
+	Femlib::DFTr       (tmp, nZT,        nPP, INVERSE);
 	Message::exchange   (tmp, nZ32,        nP, INVERSE);
 	Veclib::vvtvp      (nTot32, u32[2], 1, tmp, 1, n32, 1, n32, 1);
 	
@@ -206,10 +206,10 @@ static void advect (Domain*   D ,
       if (nZ > 2) {
 	Veclib::vmul       (nTot32, u32[NCOM], 1, u32[2], 1, tmp, 1);
 	Message::exchange   (tmp, nZ32,        nP, FORWARD);
-	Femlib::DFTr       (tmp, nZ32 * nPR, nPP, FORWARD);
+	Femlib::DFTr       (tmp, nZT,        nPP, FORWARD);
 	Veclib::zero       (nTot32 - nTot, tmp + nTot, 1);
 	master -> gradient (nZ, nPP, tmp, 2);
-	Femlib::DFTr       (tmp, nZ32 * nPR, nPP, INVERSE);
+	Femlib::DFTr       (tmp, nZT,        nPP, INVERSE);
 	Message::exchange   (tmp, nZ32,        nP, INVERSE);
 	Veclib::vadd       (nTot32, tmp, 1, n32, 1, n32, 1);
 
@@ -233,10 +233,10 @@ static void advect (Domain*   D ,
 	Veclib::copy (nTot32, u32[NCOM], 1, tmp,  1);
 	if (j == 2) {
 	  Message::exchange   (tmp, nZ32,        nP, FORWARD);
-	  Femlib::DFTr       (tmp, nZ32 * nPR, nPP, FORWARD);
+	  Femlib::DFTr       (tmp, nZT,        nPP, FORWARD);
 	  Veclib::zero       (nTot32 - nTot, tmp + nTot, 1);
 	  master -> gradient (nZ,  nPP, tmp, j);
-	  Femlib::DFTr       (tmp, nZ32 * nPR, nPP, INVERSE);
+	  Femlib::DFTr       (tmp, nZT,        nPP, INVERSE);
 	  Message::exchange   (tmp, nZ32,        nP, INVERSE);
 	} else {
 	  master -> gradient (nZ32, nP, tmp, j);
@@ -250,10 +250,10 @@ static void advect (Domain*   D ,
 	Veclib::vmul  (nTot32, u32[NCOM], 1, u32[j], 1, tmp,  1);
 	if (j == 2) {
 	  Message::exchange   (tmp, nZ32,        nP, FORWARD);
-	  Femlib::DFTr       (tmp, nZ32 * nPR, nPP, FORWARD);
+	  Femlib::DFTr       (tmp, nZT,        nPP, FORWARD);
 	  Veclib::zero       (nTot32 - nTot, tmp + nTot, 1);
 	  master -> gradient (nZ,  nPP, tmp, j);
-	  Femlib::DFTr       (tmp, nZ32 * nPR, nPP, INVERSE);
+	  Femlib::DFTr       (tmp, nZT,        nPP, INVERSE);
 	  Message::exchange   (tmp, nZ32,        nP, INVERSE);
 	} else {
 	  master -> gradient (nZ32, nP, tmp, j);
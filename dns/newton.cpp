@@ -0,0 +1,325 @@
+///////////////////////////////////////////////////////////////////////////////
+// newton.cpp: Newton--Krylov solution for steady states of the
+// Navier--Stokes equations.  These are found as fixed points x =
+// Phi(x) of the map Phi which advances the advected fields through
+// N_STEP time steps of integrate, i.e. as zeros of F(x) = Phi(x) - x
+// [1,2].
+//
+// Each Newton step solves (J - I) dx = -F(x), where J is the
+// Jacobian of Phi, by GMRES [3].  Products with J - I are made by
+// finite differences of F, each costing one call to integrate, so
+// the solver sees exactly the discrete map that dns time steps, with
+// all its boundary conditions and forcing.  Newton steps which fail
+// to reduce |F| are cut back by halving.
+//
+// Unlike selective frequency damping, this converges to unstable
+// steady states as well as stable ones, typically within a few dozen
+// applications of Phi.  Note that a fixed point of Phi could instead
+// be a periodic orbit of period N_STEP * D_T / k, k = 1, 2, ...
+//
+// Copyright (c) 1994+, Hugh M Blackburn
+//
+// REFERENCES
+// ----------
+// [1] Tuckerman & Barkley (2000) "Bifurcation analysis for
+//     timesteppers", in Numerical methods for bifurcation problems
+//     and large-scale dynamical systems, Springer, 453--466.
+// [2] Kelley (2003) "Solving nonlinear equations with Newton's
+//     method", SIAM.
+// [3] Saad & Schultz (1986) "GMRES: a generalized minimal residual
+//     algorithm for solving nonsymmetric linear systems", SIAM J Sci
+//     Stat Comput 7:856--869.
+///////////////////////////////////////////////////////////////////////////////
+
+#include <dns.h>
+
+typedef void (*Advection) (Domain*, BCmgr*, AuxField**, AuxField**,
+			   FieldForce*);
+
+void integrate (Advection, Domain*, BCmgr*, DNSAnalyser*, FieldForce*);
+
+static int_t  NADV, NTOT;
+static real_t T0;		// -- Time at which every integration starts.
+
+static void   pack     (const Domain*, real_t*);
+static void   unpack   (Domain*, const real_t*);
+static real_t norm     (const real_t*);
+static real_t dot      (const real_t*, const real_t*);
+static void   residual (Advection, Domain*, BCmgr*, FieldForce*,
+			const real_t*, real_t*);
+static int_t  gmres    (Advection, Domain*, BCmgr*, FieldForce*,
+			const real_t*, const real_t*, const real_t,
+			real_t*, real_t*);
+
+
+void Newton (Advection   advection,
+	     Domain*     D        ,
+	     BCmgr*      B        ,
+	     FieldForce* FF       )
+// ---------------------------------------------------------------------------
+// On entry, D holds the initial guess, as read from the restart file.
+// Iterate until |F| <= NEWT_TOL * |x| or NEWT_ITS Newton steps have
+// been taken, then write x to "name".fld, with the pressure of the
+// last integration from it.
+//
+// Vector x is the concatenated (Fourier-transformed) data of the
+// advected fields on this process; inner products are summed over
+// processes.  The multistep history is restarted on every call to
+// integrate, so no solver state is read.  Integrations are made
+// without an analyser: they would otherwise fill the history, modal
+// energy and flux files with repeated records for times T0 to T0 +
+// N_STEP * D_T, and overwrite "name".fld, once per application of Phi.
+// The only output is the final dump.
+// ---------------------------------------------------------------------------
+{
+  const char   routine[] = "Newton";
+  const int_t  nStep     = Femlib::ivalue ("N_STEP");
+  const int_t  nIts      = Femlib::ivalue ("NEWT_ITS");
+  const int_t  nHalf     = 4;	// -- Max cut-backs of a Newton step.
+  const real_t tol       = Femlib::value  ("NEWT_TOL");
+  int_t        i, j, nKry, nMap = 0;
+  real_t       fx, fo, fn, xn, eta, lambda;
+  char         s[StrMax];
+
+  if (Femlib::ivalue ("DT_ADAPT") > 1)
+    Veclib::alert (routine, "needs fixed D_T: unset DT_ADAPT", ERROR);
+
+  Femlib::ivalue ("CHKPOINT", 0);
+  Femlib::ivalue ("IO_FLD",   nStep);
+
+  NADV = D -> nAdvect();
+  NTOT = NADV * Geometry::nTotProc();
+  T0   = D -> time;
+
+  vector<real_t> work (4 * NTOT);
+  real_t*        x  = &work[0];
+  real_t*        f  = x  + NTOT;
+  real_t*        dx = f  + NTOT;
+  real_t*        xt = dx + NTOT;
+
+  pack (D, x);
+  residual (advection, D, B, FF, x, f); nMap++;
+  xn = norm (x);
+  fx = fo = norm (f);
+
+  for (i = 0; ; i++) {
+
+    ROOTONLY {
+      sprintf (s, "-- Newton step %3d : |F| / |x| = %.3e (%d integrations)",
+	       static_cast<int>(i), fx / xn, static_cast<int>(nMap));
+      cout << s << endl;
+    }
+
+    if (fx <= tol * xn) break;
+    if (i == nIts) {
+      ROOTONLY Veclib::alert (routine, "not converged", WARNING);
+      break;
+    }
+
+    // -- Inexact Newton: relative GMRES tolerance as in [2], sec 3.2.3,
+    //    but no tighter than needed to meet tol on this step.
+
+    eta = (i) ? min (0.1, 0.9 * sqr (fx / fo)) : 0.1;
+    eta = max (eta, 0.5 * tol * xn / fx);
+
+    nKry  = gmres (advection, D, B, FF, x, f, eta, dx, xt);
+    nMap += nKry;
+
+    // -- Take the step, halving it while that fails to reduce |F|.
+
+    for (lambda = 1.0, j = 0; ; j++, lambda *= 0.5) {
+      Veclib::copy (NTOT, x, 1, xt, 1);
+      Blas::axpy   (NTOT, lambda, dx, 1, xt, 1);
+      residual (advection, D, B, FF, xt, f); nMap++;
+      fn = norm (f);
+      if (fn < fx) break;
+      if (j == nHalf) {
+	ROOTONLY Veclib::alert (routine, "step does not reduce |F|", WARNING);
+	break;
+      }
+    }
+
+    ROOTONLY {
+      sprintf (s, "-- GMRES iterations : %d, step length %g",
+	       static_cast<int>(nKry), lambda);
+      cout << s << endl;
+    }
+
+    Veclib::copy (NTOT, xt, 1, x, 1);
+    xn = norm (x);
+    fo = fx;
+    fx = fn;
+  }
+
+  // -- Dump the fixed point itself, rather than its image under Phi.
+
+  unpack (D, x);
+  D -> step = nStep;
+  D -> time = T0;
+  D -> dump ();
+}
+
+
+static void residual (Advection     advection,
+		      Domain*       D        ,
+		      BCmgr*        B        ,
+		      FieldForce*   FF       ,
+		      const real_t* x        ,
+		      real_t*       f        )
+// ---------------------------------------------------------------------------
+// Return f = Phi(x) - x.
+// ---------------------------------------------------------------------------
+{
+  D -> step = 0;
+  D -> time = T0;
+  Femlib::ivalue ("STEP", 0);
+  Femlib::value  ("t",    T0);
+
+  unpack    (D, x);
+  integrate (advection, D, B, 0, FF);
+  pack      (D, f);
+
+  Blas::axpy (NTOT, -1.0, x, 1, f, 1);
+}
+
+
+static int_t gmres (Advection     advection,
+		    Domain*       D        ,
+		    BCmgr*        B        ,
+		    FieldForce*   FF       ,
+		    const real_t* x        ,
+		    const real_t* f        ,
+		    const real_t  eta      ,
+		    real_t*       dx       ,
+		    real_t*       xt       )
+// ---------------------------------------------------------------------------
+// Solve (J - I) dx = -f by GMRES from dx = 0, with Givens rotations to
+// keep the Hessenberg matrix upper-triangular [3].  Stop when the
+// residual falls below eta * |f| or after NEWT_KDIM iterations (no
+// restarts: the Newton iteration itself restarts).  Products are
+//
+//   (J - I) v = (F(x + e v) - f) / e,  |v| = 1,  e = 1e-7 max (|x|, 1).
+//
+// Return the number of iterations (i.e. integrations) taken.
+// ---------------------------------------------------------------------------
+{
+  const int_t    m    = Femlib::ivalue ("NEWT_KDIM");
+  const real_t   beta = norm (f);
+  const real_t   eps  = 1.0e-7 * max (norm (x), 1.0);
+  vector<real_t> work ((m + 1) * NTOT + (m + 1) * m + 4 * m + 1);
+  real_t*        V    = &work[0];		// -- Orthonormal Krylov basis.
+  real_t*        H    = V  + (m + 1) * NTOT;	// -- Hessenberg, column major.
+  real_t*        cs   = H  + (m + 1) * m;
+  real_t*        sn   = cs + m;
+  real_t*        y    = sn + m;
+  real_t*        g    = y  + m;
+  int_t          i, j, k = 0;
+  real_t         h, r, t;
+
+  Veclib::zero (NTOT, dx, 1);
+  if (beta == 0.0) return 0;
+
+  Veclib::smul (NTOT, -1.0 / beta, f, 1, V, 1);
+  g[0] = beta;
+
+  for (j = 0; j < m; j++) {
+    real_t* w  = V + (j + 1) * NTOT;
+    real_t* hj = H + j * (m + 1);
+
+    // -- Finite-difference product w = (J - I) V_j.
+
+    Veclib::copy (NTOT, x, 1, xt, 1);
+    Blas::axpy   (NTOT, eps, V + j * NTOT, 1, xt, 1);
+    residual (advection, D, B, FF, xt, w);
+    Blas::axpy   (NTOT, -1.0, f, 1, w, 1);
+    Blas::scal   (NTOT, 1.0 / eps, w, 1);
+
+    // -- Modified Gram--Schmidt.
+
+    for (i = 0; i <= j; i++) {
+      hj[i] = dot (w, V + i * NTOT);
+      Blas::axpy (NTOT, -hj[i], V + i * NTOT, 1, w, 1);
+    }
+    h = hj[j + 1] = norm (w);
+    if (h > 0.0) Blas::scal (NTOT, 1.0 / h, w, 1);
+
+    // -- Apply previous rotations to the new column, then eliminate
+    //    its subdiagonal.
+
+    for (i = 0; i < j; i++) {
+      t         =  cs[i] * hj[i] + sn[i] * hj[i + 1];
+      hj[i + 1] = -sn[i] * hj[i] + cs[i] * hj[i + 1];
+      hj[i]     =  t;
+    }
+    r         = hypot (hj[j], hj[j + 1]);
+    cs[j]     = hj[j]     / r;
+    sn[j]     = hj[j + 1] / r;
+    hj[j]     = r;
+    hj[j + 1] = 0.0;
+    g[j + 1]  = -sn[j] * g[j];
+    g[j]      =  cs[j] * g[j];
+
+    k = j + 1;
+    if (fabs (g[j + 1]) <= eta * beta || h == 0.0) break;
+  }
+
+  // -- Back-substitute for Krylov coefficients, form dx.
+
+  for (i = k - 1; i >= 0; i--) {
+    y[i] = g[i];
+    for (j = i + 1; j < k; j++) y[i] -= H[i + j * (m + 1)] * y[j];
+    y[i] /= H[i + i * (m + 1)];
+  }
+  for (i = 0; i < k; i++) Blas::axpy (NTOT, y[i], V + i * NTOT, 1, dx, 1);
+
+  return k;
+}
+
+
+static void pack (const Domain* D,
+		  real_t*       x)
+// ---------------------------------------------------------------------------
+// Copy advected fields into x.
+// ---------------------------------------------------------------------------
+{
+  const int_t ntot = Geometry::nTotProc();
+
+  for (int_t i = 0; i < NADV; i++)
+    Veclib::copy (ntot, D -> u[i] -> data(), 1, x + i * ntot, 1);
+}
+
+
+static void unpack (Domain*       D,
+		    const real_t* x)
+// ---------------------------------------------------------------------------
+// Inverse of pack.
+// ---------------------------------------------------------------------------
+{
+  const int_t ntot = Geometry::nTotProc();
+
+  for (int_t i = 0; i < NADV; i++)
+    Veclib::copy (ntot, x + i * ntot, 1, D -> u[i] -> getData(), 1);
+}
+
+
+static real_t dot (const real_t* a,
+		   const real_t* b)
+// ---------------------------------------------------------------------------
+// Inner product over all processes.
+// ---------------------------------------------------------------------------
+{
+  real_t sum = Blas::dot (NTOT, a, 1, b, 1);
+
+  if (Geometry::nProc() > 1) Message::sum (&sum, 1);
+
+  return sum;
+}
+
+
+static real_t norm (const real_t* a)
+// ---------------------------------------------------------------------------
+// 2-norm over all processes.
+// ---------------------------------------------------------------------------
+{
+  return sqrt (dot (a, a));
+}
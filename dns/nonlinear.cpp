@@ -17,6 +17,24 @@
 
 #define _KE_HYDROSTAT 0
 
+static bool Batched = false;	// -- See batchTransforms.
+
+
+void batchTransforms (const bool batch)
+// ---------------------------------------------------------------------------
+// With batch set, the Fourier transforms that the routines below make
+// on entry and exit are left to the caller, which makes those for all
+// members of an ensemble at once (see integrate.cpp).  On entry, the
+// velocity data of D are then already in physical space and Us holds
+// their Fourier-space copy; on exit, N(u) + f in Uf is left in
+// physical space, yet to be transformed and smoothed.  Transforms for
+// z derivatives, within the routines, are still made one by one.
+// ---------------------------------------------------------------------------
+{
+  Batched = batch;
+}
+
+
 
 void skewSymmetric (Domain*     D ,
 		    BCmgr*      B ,
@@ -87,6 +105,7 @@ void skewSymmetric (Domain*     D ,
     N[i]     = Uf[i];
     U[i]     = Us[i];
     *N[i]    = 0.0;
+    if (Batched) continue;
     *U[i]    = *Uphys[i];
     Uphys[i] -> transform (INVERSE);
   }
@@ -223,6 +242,8 @@ void skewSymmetric (Domain*     D ,
   }
 #endif
   
+  if (Batched) return;
+
   for (i = 0; i < NADV; i++) {
     N[i] -> transform (FORWARD);
     N[i] -> smooth (D -> nGlobal(), D -> assemblyNaive(), D -> invMassNaive());
@@ -280,13 +301,18 @@ void altSkewSymmetric (Domain*     D ,
   vector<AuxField*> U (NADV), N (NADV), Uphys (NADV);
   AuxField*         tmp = D -> u[NADV]; // -- Pressure is used for scratch.
   int_t             i, j;
-  static int        toggle = 1;            // -- Switch u.grad(u) or div(uu).
-  
+  static map<const Domain*, int> Toggle; // -- Switch u.grad(u) or div(uu)
+				         //    (for each ensemble member).
+  if (!Toggle.count (D)) Toggle[D] = 1;
+
+  int& toggle = Toggle[D];
+
   for (i = 0; i < NADV; i++) {
     Uphys[i] = D -> u[i];
     N[i]     = Uf[i];
     U[i]     = Us[i];
     *N[i]    = 0.0;
+    if (Batched) continue;
     *U[i]    = *Uphys[i];
     Uphys[i] -> transform (INVERSE);
   }
@@ -443,12 +469,14 @@ void altSkewSymmetric (Domain*     D ,
   }
 #endif
  
+  toggle = 1 - toggle;
+
+  if (Batched) return;
+
   for (i = 0; i < NADV; i++) {
     N[i] -> transform (FORWARD);
     N[i] -> smooth (D -> nGlobal(), D -> assemblyNaive(), D -> invMassNaive());
   }
-  
-  toggle = 1 - toggle;
 }
 
 
@@ -498,6 +526,7 @@ void convective (Domain*     D ,
     N[i]     = Uf[i];
     U[i]     = Us[i];
     *N[i]    = 0.0;
+    if (Batched) continue;
     *U[i]    = *Uphys[i];
     Uphys[i] -> transform (INVERSE);
   }
@@ -594,6 +623,8 @@ void convective (Domain*     D ,
   }
 #endif
 
+  if (Batched) return;
+
   for (i = 0; i < NADV; i++) {
     N[i] -> transform (FORWARD);
     N[i] -> smooth (D -> nGlobal(), D -> assemblyNaive(), D -> invMassNaive());
@@ -649,6 +680,7 @@ void rotational1 (Domain*     D ,
     N[i]     = Uf[i];
     U[i]     = Us[i];
     *N[i]    = 0.0;
+    if (Batched) continue;
     *U[i]    = *Uphys[i];
     Uphys[i] -> transform (INVERSE);
   }
@@ -908,6 +940,8 @@ void rotational1 (Domain*     D ,
     
 #endif
 
+  if (Batched) return;
+
   for (i = 0; i < NADV; i++) {
     N[i] -> transform (FORWARD);
     N[i] -> smooth (D -> nGlobal(), D -> assemblyNaive(), D -> invMassNaive());
@@ -966,6 +1000,7 @@ void rotational2 (Domain*     D ,
     N[i]     = Uf[i];
     U[i]     = Us[i];
     *N[i]    = 0.0;
+    if (Batched) continue;
     *U[i]    = *Uphys[i];
     Uphys[i] -> transform (INVERSE);
   }
@@ -1212,6 +1247,8 @@ void rotational2 (Domain*     D ,
   }
 #endif
 
+  if (Batched) return;
+
   for (i = 0; i < NADV; i++) {
     N[i] -> transform (FORWARD);
     N[i] -> smooth (D -> nGlobal(), D -> assemblyNaive(), D -> invMassNaive());
@@ -1242,6 +1279,7 @@ void Stokes (Domain*     D ,
     N[i]     = Uf[i];
     U[i]     = Us[i];
     *N[i]    = 0.0;
+    if (Batched) continue;
     *U[i]    = *Uphys[i];
     Uphys[i] -> transform (INVERSE);
   }
@@ -1297,6 +1335,8 @@ void Stokes (Domain*     D ,
   }
 #endif
 
+  if (Batched) return;
+
   for (i = 0; i < NADV; i++) {
     N[i] -> transform (FORWARD);
     N[i] -> smooth (D -> nGlobal(), D -> assemblyNaive(), D -> invMassNaive());
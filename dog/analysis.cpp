@@ -201,9 +201,10 @@ void Analyser::divergence (AuxField** Us) const
 }
 
 
-void Analyser::estimateCFL (AuxField* work) const
+real_t Analyser::estimateCFL (AuxField* work) const
 // ---------------------------------------------------------------------------
 // Estimate and print the peak CFL number, based on zero-mode velocities.
+// Return the corresponding largest stable time step.
 // ---------------------------------------------------------------------------
 {
   const int_t    pid     = Geometry::procID();
@@ -232,6 +233,11 @@ void Analyser::estimateCFL (AuxField* work) const
       elmt_i = elmt_k;
     }
   }
+
+  dt_max  = 1.0 / CFL_dt;
+  percent = static_cast<int_t>(100.0 * dt / dt_max);
+  vcmpt   = 'u' + static_cast<int_t>(cmpt_i);
+
   cout << setprecision (3)
        << "# CFL: "     << CFL_dt * dt
        << ", dt (max): " << dt_max
@@ -240,4 +246,6 @@ void Analyser::estimateCFL (AuxField* work) const
        << "%), field: "  << vcmpt 
        << ", elmt: "     << elmt_i + 1 << endl;
   // -- 1-based indexing as in session file.
+
+  return dt_max;
 }
@@ -40,6 +40,11 @@ Domain::Domain (FEML*             file   ,
   real_t*        alloc;
   vector<real_t> unity (Geometry::nTotElmt(), 1.0);
 
+  // -- Field::solve has no refinement for single-precision factors.
+
+  if (Femlib::ivalue ("MIXED_PREC"))
+    Veclib::alert (routine, "MIXED_PREC is not supported: set it to 0", ERROR);
+
   strcpy ((name = new char [strlen (file -> root()) + 1]), file -> root());
   Femlib::value ("t", time = 0.0);
   step = 0;
@@ -96,7 +101,7 @@ Domain::Domain (FEML*             file   ,
   u   .resize (nfield);
   udat.resize (nfield);
 
-  alloc = new real_t [static_cast<size_t> (nfield * ntot)];
+  alloc = Storage::allocate (nfield * ntot, nfield * nz);
   for (i = 0; i < nfield; i++) {
     udat[i] = alloc + i * ntot;
     u[i]    = new Field (udat[i], b[i], n[i], nz, elmt, field[i]);
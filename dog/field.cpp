@@ -231,6 +231,9 @@ Field& Field::solve (AuxField*        f,
 //
 //   The notation follows that used in Fig 2.5 of Barrett et al.,
 //   "Templates for the Solution of Linear Systems", netlib.
+//
+//   SCHPCG is the same except for the preconditioner, see
+//   MatrixSys::buildSchwarz.
 // ---------------------------------------------------------------------------
 {
   const char  routine[] = "Field::solve";
@@ -276,7 +279,10 @@ Field& Field::solve (AuxField*        f,
       
       // -- Solve for unknown global-node values (if any).
     
-      if (nsolve) Lapack::pbtrs("U",nsolve,nband-1,1,H,nband,RHS,nglobal,info);
+      if (M -> _LS)
+	M -> _LS -> solve (RHS);
+      else if (nsolve)
+	Lapack::pbtrs ("U",nsolve,nband-1,1,H,nband,RHS,nglobal,info);
       
       // -- Carry out Schur-complement solution for element-internal nodes.
       
@@ -294,7 +300,8 @@ Field& Field::solve (AuxField*        f,
     }
     break;
 
-    case JACPCG: {
+    case JACPCG:
+    case SCHPCG: {
       const int_t    StepMax = Femlib::ivalue ("STEP_MAX");
       const int_t    npts    = M -> _npts;
       real_t         alpha, beta, dotp, epsb2, r2, rho1, rho2 = 0.0;
@@ -345,7 +352,7 @@ Field& Field::solve (AuxField*        f,
       
 	// -- Preconditioner.
 
-	Veclib::vmul (npts, M -> _PC, 1, r, 1, z, 1);
+	M -> precon (r, z);
 	
 	rho1 = Blas::dot (npts, r, 1, z, 1);
 
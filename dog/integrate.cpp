@@ -71,7 +71,8 @@ void integrate (void      (*Advection)(Domain*, BCmgr*, AuxField**, AuxField**),
     // -- Create multi-level storage for velocities and forcing.
 
     const int_t ntot  = Geometry::nTotProc();
-    real_t*     alloc = new real_t [static_cast<size_t>(2*NPERT*NORD*ntot)];
+    real_t*     alloc = Storage::allocate (2*NPERT*NORD*ntot,
+					   2*NPERT*NORD*Geometry::nZProc());
 
     Us = new AuxField** [static_cast<size_t>(NORD)];
     Uf = new AuxField** [static_cast<size_t>(NORD)];
@@ -420,6 +421,10 @@ static void project (const Domain* D ,
 static MatrixSys** preSolve (const Domain* D)
 // ---------------------------------------------------------------------------
 // Set up ModalMatrixSystems for system with only 1 Fourier mode.
+//
+// Token ITERATIVE selects PCG for velocities (1) or all fields (2),
+// with the preconditioner chosen by PRECON and PRECON_P as for
+// ModalMatrixSys.
 // ---------------------------------------------------------------------------
 {
   vector<MatrixSys*> MSS;
@@ -443,7 +448,8 @@ static MatrixSys** preSolve (const Domain* D)
 
   cout << "-- Installing matrices     : " << flush;
 
-  method = (itLev < 1) ? DIRECT : JACPCG;
+  method = (itLev < 1)                 ? DIRECT :
+           (Femlib::ivalue ("PRECON")) ? SCHPCG : JACPCG;
 
   // -- Velocities, starting with u.
   cout << "*** Extracting AssemblyMap" << endl;
@@ -500,7 +506,8 @@ static MatrixSys** preSolve (const Domain* D)
     
   // -- Pressure.  No search because no installed MatrixSys has lambda2 = 0.
 
-  method = (itLev < 2) ? DIRECT : JACPCG;
+  method = (itLev < 2)                   ? DIRECT :
+           (Femlib::ivalue ("PRECON_P")) ? SCHPCG : JACPCG;
 
   betak2 = sqr (Field::modeConstant (D -> u[NPERT] -> name(), mode, beta));
   A      = D -> n[NPERT] -> getMap (bmode);
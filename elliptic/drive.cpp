@@ -87,12 +87,17 @@ int main (int    argc,
 
   domain -> restart();
 
+  Profile::init  (domain -> name);
+  Profile::start ("solve");
   Helmholtz (domain, forcefld);
+  Profile::stop  ("solve");
 
   ROOTONLY if (exact) domain -> u[0] -> errors (mesh, exact);
 
   domain -> dump();
 
+  Profile::report ();
+
   Message::stop();
 
   return EXIT_SUCCESS;
@@ -231,7 +236,8 @@ static void preprocess (const char*       session,
 
   VERBOSE cout << "Building forcing ...";
 
-  forcing = new AuxField(new real_t[(size_t)Geometry::nTotProc()],
+  forcing = new AuxField(Storage::allocate (Geometry::nTotProc(),
+					    Geometry::nZProc()),
 			 Geometry::nZProc(), elmt, 'f');
 
   VERBOSE cout << "done" << endl;
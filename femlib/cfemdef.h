@@ -44,6 +44,7 @@ typedef enum solver_kind {
   DIRECT,	/* Cholesky back-substitution.                           */
   NESTED,       /* Nested dissection.                                    */
   JACPCG,	/* Conjugate gradient, Jacobi (diagonal) preconditioner. */
+  SCHPCG,	/* Conjugate gradient, two-level Schwarz preconditioner. */
   MIXED         /* Direct for mode 0, iterative for all others.          */
 } SolverKind;
 
@@ -108,6 +108,14 @@ void sabandon (float**);
 
 int_t FamilySize (int_t*, int_t*, int_t*);
 
+/* -- Routines from fldindex.c: */
+
+void  fldidx_append (const char*, const long, const int_t, const real_t,
+		     const char*);
+int_t fldidx_build  (const char*);
+long  fldidx_offset (const char*, const int_t);
+int_t fldidx_find   (const char*, const real_t);
+
 /* -- Routines from sparsepak.F: */
 
 void genrcm_ (int_t*, int_t*, int_t*, int_t*, int_t*, int_t*);
@@ -194,6 +202,8 @@ rfft_(r,w,trigs,ifax,_vecIreg,_vecIreg+1,_vecDreg))
 
 void preFFT (const int_t);
 void dDFTr  (real_t*, const int_t, const int_t, const int_t);
+void dDCTr  (real_t*, const int_t, const int_t, const int_t);
+void dDSTr  (real_t*, const int_t, const int_t, const int_t);
 
 /* -- Routines from filter.c */
 
@@ -58,6 +58,10 @@ static struct {
   "DONG_UODELTA",   0.05   ,    /* -- Open boundary velocity scale.       */
   "DONG_DO"     ,   1.0    ,    /* -- Open boundary convection scale.     */
 
+  "CFL_MAX"     ,   0.5    ,    /* -- Peak CFL aimed at by DT_ADAPT.      */
+  "DT_RATIO"    ,   1.5    ,    /* -- Ratio of DT_ADAPT ladder steps.     */
+  "NEWT_TOL"    ,   1.0e-8 ,    /* -- Newton--Krylov tolerance, |F|/|x|.  */
+
   "LMA_BETA_T"  ,   0.0    ,	/* -- Thermal exp for Lopez Marques Avila.*/
   "LMA_T_REF"   ,   0.0    ,    /* -- Reference temp for LMA13 buoyancy.  */
 
@@ -73,6 +77,11 @@ static struct {
   "RANSEED"     ,   0   ,       /* -- Set wall-clock random seeding.      */
   "CENT_BUOY"   ,   0   ,       /* -- Set centrifugal buoyancy on/off.    */
   "ADVECTION"   ,   1   ,       /* -- Alternating skew-symmetric scheme.  */
+  "PROFILE"     ,   0   ,       /* -- Set phase timing/counter output.    */
+  "PRECON"      ,   0   ,       /* -- PCG preconditioner, velocity/scalar.*/
+  "PRECON_P"    ,   0   ,       /* -- PCG preconditioner, pressure.       */
+  "EXCHANGE"    ,   0   ,       /* -- Transpose: 0 flat, 1 node-aware.    */
+  "NEWTON"      ,   0   ,       /* -- Newton--Krylov steady state, dns -s.*/
   
   /* -- Default integer values. */
 
@@ -87,10 +96,19 @@ static struct {
   "N_STEP"      ,   1   ,	/* -- Number of timesteps to integrate.  */
   "STEP"        ,   0   ,	/* -- Index of current time step.        */
   "N_Z"         ,   1   ,	/* -- Number of planes of data.          */
+  "SYMMETRY"    ,   0   ,       /* -- z-reflection symmetric (cos/sin).  */
+  "DT_ADAPT"    ,   0   ,       /* -- No. of CFL-adaptive D_T rungs.     */
+  "OIFS"        ,   0   ,       /* -- RK4 advection substeps per D_T.    */
+  "NEWT_ITS"    ,   20  ,       /* -- Max Newton--Krylov iterations.     */
+  "NEWT_KDIM"   ,   40  ,       /* -- Max GMRES iterations per Newton.   */
   "N_PART"      ,   1   ,       /* -- Number of 2D domain partitions.    */
   "I_PROC"      ,   0   ,	/* -- Process index for parallel soln.   */
   "N_PROC"      ,   1   ,	/* -- Number of processes for parallel.  */
   "STEP_MAX"    ,   500 ,	/* -- Max number of iterations for PCG.  */
+  "N_PROJ"      ,   0   ,       /* -- Max PCG solution history vectors.  */
+  "MIXED_PREC"  ,   0   ,       /* -- Refinement steps, float factors.  */
+  "SPARSE_CHOL" ,   0   ,       /* -- Sparse N-D Cholesky for DIRECT.    */
+  "HUGEPAGE"    ,   0   ,       /* -- Huge pages for bulk storage, 0-2.  */
   "NR_MAX"      ,   20  ,       /* -- Max iterations for Newton-Raphson. */
   "ENUMERATION" ,   2   ,       /* -- Default RCM optimisation level.    */
   
@@ -121,10 +121,20 @@ void sabandon (float**);
 
 int_t  FamilySize (int_t*, int_t*, int_t*);
 
+// -- Routines from fldindex.c:
+
+void  fldidx_append (const char*, const long, const int_t, const real_t,
+		     const char*);
+int_t fldidx_build  (const char*);
+long  fldidx_offset (const char*, const int_t);
+int_t fldidx_find   (const char*, const real_t);
+
 // -- Routines from fourier.c:
 
 void preFFT (const int_t);
 void dDFTr  (real_t*, const int_t, const int_t, const int_t);
+void dDCTr  (real_t*, const int_t, const int_t, const int_t);
+void dDSTr  (real_t*, const int_t, const int_t, const int_t);
 
 // -- Routines from filter.c
 
@@ -335,6 +345,14 @@ public:
   static int_t fwords (int_t* ni, int_t* nd, int_t* ns)
     { return FamilySize (ni, nd, ns); }
 
+  static void  indexDump  (const char* f, const long o, const int_t n,
+			   const real_t t, const char* u)
+    { fldidx_append (f, o, n, t, u); }
+  static int_t buildIndex (const char* f)
+    { return fldidx_build (f); }
+  static long  dumpOffset (const char* f, const int_t n)
+    { return fldidx_offset (f, n); }
+
   static void fnroot (int_t& r, int_t* x, int_t* a, int_t* m,
 		      int_t& n, int_t* l, int_t* p) 
     { F77NAME(fnroot) (r, x, a, m, n, l, p); }
@@ -368,6 +386,12 @@ public:
   static void DFTr (real_t*  data, const int_t nz, const int_t np,
 		    const int_t sign)
     { dDFTr (data, nz, np, sign); }
+  static void DCTr (real_t*  data, const int_t nz, const int_t np,
+		    const int_t sign)
+    { dDCTr (data, nz, np, sign); }
+  static void DSTr (real_t*  data, const int_t nz, const int_t np,
+		    const int_t sign)
+    { dDSTr (data, nz, np, sign); }
 
   static void preft  (const int_t& n, int_t& nfax, int_t* ifax,
 		      real_t* trig)
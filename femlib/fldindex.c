@@ -0,0 +1,222 @@
+/*****************************************************************************
+ * fldindex.c: random-access index for multi-dump semtex field files.
+ *
+ * A field file written with IO_FLD in append mode is a concatenation
+ * of dumps, each a 10-line ASCII header followed by field data.  To
+ * get at dump N without parsing all the dumps that precede it, we
+ * keep a small ASCII sidecar file called "<fieldfile>.idx" with one
+ * line per dump:
+ *
+ *   # offset        step        time                 fields
+ *   0               100         0.1                  uvwp
+ *   1440351         200         0.2                  uvwp
+ *
+ * where offset is the byte position in the field file at which the
+ * dump's header starts.  Lines starting with '#' are comments.
+ *
+ * The index is maintained by Domain::dump as fields are written, and
+ * can be (re)built for an existing field file by the fldindex
+ * utility (which calls fldidx_build, below).  Appending to a field
+ * file that has no index rebuilds it, so that records stay numbered
+ * from the first dump in the file.
+ *
+ * An index is only ever a hint: fldidx_offset checks that the offset
+ * it returns lies within the field file and points at a dump header,
+ * and returns -1 if not (or if there is no index), in which case the
+ * caller should fall back to a sequential search.
+ *****************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+#include <float.h>
+#include <math.h>
+
+#include <cfemdef.h>
+#include <cveclib.h>
+#include <cfemlib.h>
+
+static FILE* idxopen  (const char*, const char*);
+static int_t hdrcheck (FILE*, const long);
+
+
+void fldidx_append (const char*  fname ,
+		    const long   offset,
+		    const int_t  step  ,
+		    const real_t time  ,
+		    const char*  fields)
+/* ------------------------------------------------------------------------- *
+ * Add a record for a dump starting at byte offset in field file
+ * fname.  If offset is zero the field file has just been (re)created,
+ * and so the index is restarted.  If offset is non-zero but there is
+ * no index (the field file predates it, or it was deleted), records
+ * for the earlier dumps would be missing, so instead the index is
+ * rebuilt by scanning the field file, which by now includes this dump.
+ * ------------------------------------------------------------------------- */
+{
+  FILE* fp;
+
+  if (offset && !(fp = idxopen (fname, "r"))) {
+    fldidx_build (fname);
+    return;
+  } else if (offset) fclose (fp);
+
+  if (!(fp = idxopen (fname, (offset) ? "a" : "w"))) return;
+
+  if (!offset) fprintf (fp, "# %-15s %-11s %-20s %s\n",
+			"offset", "step", "time", "fields");
+  fprintf (fp, "%-17ld %-11d %-20.14g %s\n", offset, (int) step, time, fields);
+
+  fclose (fp);
+}
+
+
+int_t fldidx_build (const char* fname)
+/* ------------------------------------------------------------------------- *
+ * Scan field file fname from the start and (re)write its index.
+ * Binary dumps are skipped over using the sizes given in their
+ * headers; ASCII dumps are skipped one line per mesh point.  Return
+ * the number of dumps indexed, or -1 if fname can't be read.
+ * ------------------------------------------------------------------------- */
+{
+  char   buf[STR_MAX], fields[STR_MAX];
+  int    n, nr, ns, nz, nel, step;
+  long   offset, npts, nfield, fsize;
+  int_t  ndump = 0;
+  double time;
+  FILE*  fp;
+
+  if (!(fp = fopen (fname, "r"))) return -1;
+
+  fseek (fp, 0, SEEK_END);
+  fsize = ftell (fp);
+  rewind (fp);
+
+  while ((offset = ftell (fp)) >= 0 && fgets (buf, STR_MAX, fp)) {
+    if (!strstr (buf, "Session")) break;
+    fgets (buf, STR_MAX, fp);
+    fgets (buf, STR_MAX, fp);
+    if (sscanf (buf, "%d%d%d%d", &nr, &ns, &nz, &nel) != 4) break;
+    fgets (buf, STR_MAX, fp);
+    if (sscanf (buf, "%d",  &step) != 1) break;
+    fgets (buf, STR_MAX, fp);
+    if (sscanf (buf, "%lf", &time) != 1) break;
+    for (n = 0; n < 4; n++) fgets (buf, STR_MAX, fp);
+    for (n = 0; isalnum (buf[n]); n++) fields[n] = buf[n];
+    fields[n] = '\0';
+    nfield    = n;
+    if (!fgets (buf, STR_MAX, fp)) break;
+
+    npts = (long) nr * ns * nz * nel;
+
+    if (strstr (buf, "binary") || strstr (buf, "BINARY")) {
+      npts *= nfield * sizeof (double);
+      if (ftell (fp) + npts > fsize)        break; /* -- Truncated dump. */
+      if (fseek (fp, npts, SEEK_CUR))       break;
+    } else {
+      for (; npts; npts--) if (!fgets (buf, STR_MAX, fp)) break;
+      if (npts)                             break;
+    }
+
+    fldidx_append (fname, offset, step, time, fields);
+    ndump++;
+  }
+
+  fclose (fp);
+
+  if (!ndump) {			/* -- Remove any stale index. */
+    sprintf (buf, "%s.idx", fname);
+    remove  (buf);
+  }
+
+  return ndump;
+}
+
+
+long fldidx_offset (const char* fname,
+		    const int_t dump )
+/* ------------------------------------------------------------------------- *
+ * Return the byte offset in field file fname at which dump number
+ * "dump" (1-based) starts, or -1 if that isn't known from an index
+ * or the index is stale.
+ * ------------------------------------------------------------------------- */
+{
+  char  buf[STR_MAX];
+  long  offset = -1;
+  int_t n = 0;
+  FILE* fp;
+
+  if (dump < 1 || !(fp = idxopen (fname, "r"))) return -1;
+
+  while (fgets (buf, STR_MAX, fp)) {
+    if (buf[0] == '#') continue;
+    if (++n == dump) { sscanf (buf, "%ld", &offset); break; }
+  }
+  fclose (fp);
+
+  if (offset < 0 || !(fp = fopen (fname, "r"))) return -1;
+  if (!hdrcheck (fp, offset)) offset = -1;
+  fclose (fp);
+
+  return offset;
+}
+
+
+int_t fldidx_find (const char*  fname,
+		   const real_t time )
+/* ------------------------------------------------------------------------- *
+ * Return the (1-based) number of the first dump in fname whose time
+ * is not less than the given time, to within round-off.  Return 0 if
+ * there is no index or no such dump.
+ * ------------------------------------------------------------------------- */
+{
+  char   buf[STR_MAX];
+  int    step;
+  long   offset;
+  double t;
+  int_t  n = 0, found = 0;
+  FILE*  fp;
+
+  if (!(fp = idxopen (fname, "r"))) return 0;
+
+  while (fgets (buf, STR_MAX, fp)) {
+    if (buf[0] == '#') continue;
+    if (sscanf (buf, "%ld%d%lf", &offset, &step, &t) != 3) break;
+    n++;
+    if (t >= time - 10.0 * FLT_EPSILON * (1.0 + fabs (time))) {
+      found = n;
+      break;
+    }
+  }
+  fclose (fp);
+
+  return found;
+}
+
+
+static FILE* idxopen (const char* fname,
+		      const char* mode )
+/* ------------------------------------------------------------------------- *
+ * Open index file corresponding to field file fname.
+ * ------------------------------------------------------------------------- */
+{
+  char idxname[STR_MAX];
+
+  sprintf (idxname, "%s.idx", fname);
+  return fopen (idxname, mode);
+}
+
+
+static int_t hdrcheck (FILE*      fp    ,
+		       const long offset)
+/* ------------------------------------------------------------------------- *
+ * Does a field dump header start at offset in fp?
+ * ------------------------------------------------------------------------- */
+{
+  char buf[STR_MAX];
+
+  if (fseek (fp, offset, SEEK_SET) || !fgets (buf, STR_MAX, fp)) return 0;
+
+  return strstr (buf, "Session") != 0;
+}
@@ -2,10 +2,12 @@
  * fourier.c
  *
  *
- * 1D Fourier transform routines for real data fields based on
- * FFTPACK, Temperton FFT routines (default), or vendor-supplied
- * alternatives.  NB: different restrictions may apply to input args
- * depending on compile-time options/FFT selection.
+ * 1D Fourier transform routines for real data fields.  The default
+ * is a self-sorting mixed-radix FFT (below), with FFTW3, Temperton
+ * FFT routines, FFTPACK, or vendor-supplied alternatives selected at
+ * compile time (FFTW3, TEMPERTON_FFT, DEBUG_FFT, _SX).  NB: different
+ * restrictions may apply to input args depending on compile-time
+ * options/FFT selection.
 
  * 1. Input data is to be Fourier transformed in the direction normal
  * to the most rapid traverse through memory, with sucessive points in
@@ -20,20 +22,24 @@
  * these signs and scaling definitions match those adopted in
  * Numerical Recipes.
  *
- * 3. The number of transforms, ntrn, must be even owing to the way
- * real-complex transforms are implemented in the default FFT (two
- * real vectors treated as a single complex one).
+ * 3. For the Temperton and vendor FFTs, the number of transforms,
+ * ntrn, must be even owing to the way real-complex transforms are
+ * implemented there (two real vectors treated as a single complex
+ * one).  The default FFT and FFTW3 accept any ntrn.
  *
  * 4. The transform length tlen also must be even, owing to the way
  * Fourier data are assumed to be packed (with Nyquist data packed in
- * as the imaginary part of mode 0).  The transform length is assumed
- * to stay fixed during execution.
+ * as the imaginary part of mode 0).  Temperton's FFT needs tlen to
+ * have prime factors 2, 3 and 5 only; the default FFT takes any even
+ * tlen, with specialised kernels for factors 2, 3 and 4 and a generic
+ * kernel for any odd factor (5, 7, ...).
  *
  * Copyright (c) 1999+, Hugh M Blackburn
  *****************************************************************************/
 
 #include <stdio.h>
 #include <stdlib.h>
+#include <math.h>
 
 #include <cfemdef.h>
 #include <cveclib.h>
@@ -209,7 +215,7 @@ void dDFTr (double*     data,
 }
 
 
-#else /* -- Temperton FFT routine, which is the default. */
+#elif defined(TEMPERTON_FFT) /* -- Temperton FFT routines. */
 
 static int_t   ip, iq, ir, ipqr2;
 static double* Wtab;
@@ -284,4 +290,766 @@ void dDFTr (double*     data,
   ntotLast = ntot;
 }
 
+
+#elif defined(FFTW3) /* -- FFTW3, if found at configure time. */
+
+#include <fftw3.h>
+
+#define NPLAN 8
+
+typedef struct {		/* -- Cached pair of FFTW plans: */
+  int_t         tlen, ntrn;	/*    transform shape,           */
+  fftw_plan     fwd, inv;	/*    forward and inverse plans, */
+  fftw_complex* cbuf;		/*    and complex data area.     */
+} Plan;
+
+static Plan plans[NPLAN];
+static int  nextPlan;
+
+
+static Plan* getPlan (const int_t tlen,
+		      const int_t ntrn)
+/* ------------------------------------------------------------------------- *
+ * Return FFTW plans for ntrn transforms of length tlen, creating them
+ * on first use.  Up to NPLAN shapes (e.g. nZ and 3nZ/2 planes, several
+ * ntrn) are cached; beyond that, the oldest is replaced.  Plans are
+ * made for unaligned data, since they are applied to any data area.
+ * ------------------------------------------------------------------------- */
+{
+  const int   ncplx = tlen / 2 + 1;
+  int         n     = tlen;
+  double*     rbuf;
+  Plan*       P;
+  int_t       i;
+
+  for (i = 0; i < NPLAN; i++)
+    if (plans[i].tlen == tlen && plans[i].ntrn == ntrn) return plans + i;
+
+  P = plans + nextPlan;
+  nextPlan = (nextPlan + 1) % NPLAN;
+
+  if (P -> cbuf) {
+    fftw_destroy_plan (P -> fwd);
+    fftw_destroy_plan (P -> inv);
+    fftw_free         (P -> cbuf);
+  }
+
+  P -> tlen = tlen;
+  P -> ntrn = ntrn;
+  P -> cbuf = fftw_alloc_complex (ncplx * ntrn);
+  rbuf      = fftw_alloc_real    (tlen  * ntrn);
+
+  P -> fwd = fftw_plan_many_dft_r2c (1, &n, ntrn,
+				     rbuf,    NULL, ntrn, 1,
+				     P -> cbuf, NULL, ntrn, 1,
+				     FFTW_ESTIMATE | FFTW_UNALIGNED);
+  P -> inv = fftw_plan_many_dft_c2r (1, &n, ntrn,
+				     P -> cbuf, NULL, ntrn, 1,
+				     rbuf,    NULL, ntrn, 1,
+				     FFTW_ESTIMATE | FFTW_UNALIGNED |
+				     FFTW_DESTROY_INPUT);
+  fftw_free (rbuf);
+
+  return P;
+}
+
+
+void preFFT (const int_t tlen)
+/* ------------------------------------------------------------------------- *
+ * Carry out FFT rule checks.
+ * ------------------------------------------------------------------------- */
+{
+  const char routine[] = "preFFT";
+  char       err[STR_MAX];
+
+  if (tlen < 1 || tlen & 1) {
+    sprintf (err, "transform length (%1d) must be even, and positive", tlen);
+    message (routine, err, ERROR);
+  }
+}
+
+
+void dDFTr (double*     data,
+	    const int_t tlen,
+	    const int_t ntrn,
+	    const int_t sign)
+/* ------------------------------------------------------------------------- *
+ * Carry out multiple 1D real--complex Fourier transforms of data.
+ * FFTW's output is unpacked to (and its input packed from) the layout
+ * used by the other transforms, with mode tlen/2 stored beside mode 0.
+ * ------------------------------------------------------------------------- */
+{
+  const int_t   M = tlen >> 1;
+  const double  scale = 1.0 / tlen;
+  Plan*         P;
+  fftw_complex* c;
+  int_t         j, k;
+
+  if (tlen < 2 || !ntrn) return;
+
+  preFFT (tlen);
+  P = getPlan (tlen, ntrn);
+  c = P -> cbuf;
+
+  if (sign == FORWARD) {
+    fftw_execute_dft_r2c (P -> fwd, data, c);
+    for (j = 0; j < ntrn; j++) {
+      data[j]        = scale * c[j][0];
+      data[ntrn + j] = scale * c[M * ntrn + j][0];
+    }
+    for (k = 1; k < M; k++)
+      for (j = 0; j < ntrn; j++) {
+	data[2 * k       * ntrn + j] = scale * c[k * ntrn + j][0];
+	data[(2 * k + 1) * ntrn + j] = scale * c[k * ntrn + j][1];
+      }
+  } else {
+    for (j = 0; j < ntrn; j++) {
+      c[j][0]            = data[j];
+      c[M * ntrn + j][0] = data[ntrn + j];
+      c[j][1] = c[M * ntrn + j][1] = 0.0;
+    }
+    for (k = 1; k < M; k++)
+      for (j = 0; j < ntrn; j++) {
+	c[k * ntrn + j][0] = data[2 * k       * ntrn + j];
+	c[k * ntrn + j][1] = data[(2 * k + 1) * ntrn + j];
+      }
+    fftw_execute_dft_c2r (P -> inv, c, data);
+  }
+}
+
+#undef NPLAN
+
+#else /* -- Self-sorting mixed-radix FFT, which is the default. */
+
+/* -------------------------------------------------------------------------
+ * A real transform of length tlen = 2M is computed as a complex
+ * transform of length M, with even- and odd-indexed points as real
+ * and imaginary parts, followed (or, for the inverse, preceded) by a
+ * split into the transforms of the two halves.  The complex transform
+ * uses the Stockham self-sorting algorithm: one pass per factor of M,
+ * alternating between data and a work area, with no bit reversal.
+ *
+ * Complex point m is held as two successive rows (real, imaginary) of
+ * ntrn values, which matches the packing of Fourier data in dDFTr, so
+ * the transform needs no reordering.  Every kernel works on whole
+ * rows, so that the innermost loops run with unit stride over the
+ * ntrn independent transforms, and vectorise.
+ *
+ * Kernels are specialised for factors 4, 2 and 3; other (odd) factors,
+ * including 5 and 7, use a kernel that sums symmetric pairs, costing
+ * about p^2/2 operations per point for factor p.
+ * ------------------------------------------------------------------------- */
+
+#define NPLAN  8		/* -- Number of cached plans.            */
+#define MAXFAC 64		/* -- Maximum number of factors of M.    */
+#define CHUNK  64		/* -- Row chunk for odd-factor kernel.   */
+
+typedef struct {		/* -- Cached transform plan:             */
+  int_t   tlen, ntrn;		/*    transform shape,                   */
+  int_t   nfac, fac[MAXFAC];	/*    factors of M = tlen / 2,           */
+  double* tw;			/*    twiddles for each pass,            */
+  double* split;		/*    w^k, w = exp (-2 PI i / tlen),     */
+  double* cs;			/*    and roots of unity for odd passes. */
+} Plan;
+
+static Plan    plans[NPLAN];
+static int     nextPlan;
+static double* work;		/* -- Shared by all plans: sized to the  */
+static int_t   nwork;		/*    largest tlen * ntrn yet planned.   */
+
+
+static Plan* getPlan (const int_t tlen,
+		      const int_t ntrn)
+/* ------------------------------------------------------------------------- *
+ * Return the plan for ntrn transforms of length tlen, creating it on
+ * first use.  Up to NPLAN shapes (e.g. nZ and 3nZ/2 planes, several
+ * ntrn) are cached; beyond that, the oldest is replaced.  The work
+ * area is not part of a plan, but is grown here to fit the largest.
+ * ------------------------------------------------------------------------- */
+{
+  const int_t M = tlen >> 1;
+  Plan*       P;
+  int_t       i, j, q, p, n, m, len, ntw, ncs;
+
+  for (i = 0; i < NPLAN; i++)
+    if (plans[i].tlen == tlen && plans[i].ntrn == ntrn) return plans + i;
+
+  P = plans + nextPlan;
+  nextPlan = (nextPlan + 1) % NPLAN;
+
+  if (P -> tw) {
+    free (P -> tw);
+    free (P -> split);
+    free (P -> cs);
+  }
+
+  P -> tlen = tlen;
+  P -> ntrn = ntrn;
+
+  /* -- Factorise M, fours first. */
+
+  P -> nfac = 0;
+  for (n = M; n % 4 == 0; n /= 4) P -> fac[P -> nfac++] = 4;
+  for (p = 2; n > 1; p++)
+    while (n % p == 0) { P -> fac[P -> nfac++] = p; n /= p; }
+
+  /* -- Twiddles w^(j r), w = exp (2 PI i / len), sign applied in use, for each pass. */
+
+  for (ntw = 0, len = M, i = 0; i < P -> nfac; len /= P -> fac[i++])
+    ntw += 2 * len;
+  P -> tw = (double*) malloc (ntw * sizeof (double));
+
+  for (q = 0, len = M, i = 0; i < P -> nfac; len /= P -> fac[i++]) {
+    p = P -> fac[i];
+    m = len / p;
+    for (j = 0; j < m; j++)
+      for (n = 0; n < p; n++, q += 2) {
+	P -> tw[q]     = cos (TWOPI * j * n / len);
+	P -> tw[q + 1] = sin (TWOPI * j * n / len);
+      }
+  }
+
+  P -> split = (double*) malloc ((M + 2) * sizeof (double));
+  for (i = 0; i <= M / 2; i++) {
+    P -> split[2 * i]     = cos (TWOPI * i / tlen);
+    P -> split[2 * i + 1] = -sin (TWOPI * i / tlen);
+  }
+
+  /* -- exp (2 PI i k / p), k = 0 .. p - 1, sign applied in use, for each odd pass. */
+
+  for (ncs = 0, i = 0; i < P -> nfac; i++)
+    if (P -> fac[i] > 4) ncs += 2 * P -> fac[i];
+  P -> cs = (double*) malloc ((ncs + 1) * sizeof (double));
+
+  for (q = 0, i = 0; i < P -> nfac; i++) {
+    if ((p = P -> fac[i]) < 5) continue;
+    for (n = 0; n < p; n++, q += 2) {
+      P -> cs[q]     = cos (TWOPI * n / p);
+      P -> cs[q + 1] = sin (TWOPI * n / p);
+    }
+  }
+
+  if (tlen * ntrn > nwork) {
+    free (work);
+    nwork = tlen * ntrn;
+    work  = (double*) malloc (nwork * sizeof (double));
+  }
+
+  return P;
+}
+
+
+static void pass2 (const int_t   m  ,
+		   const int_t   s  ,
+		   const int_t   nt ,
+		   const double* tw ,
+		   const double  sg ,
+		   const double* x  ,
+		   double*       y  )
+/* ------------------------------------------------------------------------- *
+ * Stockham pass for factor 2.  Input point q + s (j + r m), output
+ * point q + s (2 j + r), each two rows of nt values.
+ * ------------------------------------------------------------------------- */
+{
+  const int_t ld = 2 * nt;
+  int_t       j, q, c;
+
+  for (j = 0; j < m; j++, tw += 4) {
+    const double wr = tw[2], wi = sg * tw[3];
+    for (q = 0; q < s; q++) {
+      const double* restrict a0 = x + (q + s *  j)      * ld;
+      const double* restrict a1 = x + (q + s * (j + m)) * ld;
+      double*       restrict b0 = y + (q + s *  2 * j)      * ld;
+      double*       restrict b1 = y + (q + s * (2 * j + 1)) * ld;
+      for (c = 0; c < nt; c++) {
+	const double dr = a0[c]      - a1[c];
+	const double di = a0[c + nt] - a1[c + nt];
+	b0[c]      = a0[c]      + a1[c];
+	b0[c + nt] = a0[c + nt] + a1[c + nt];
+	b1[c]      = dr * wr - di * wi;
+	b1[c + nt] = dr * wi + di * wr;
+      }
+    }
+  }
+}
+
+
+static void pass3 (const int_t   m  ,
+		   const int_t   s  ,
+		   const int_t   nt ,
+		   const double* tw ,
+		   const double  sg ,
+		   const double* x  ,
+		   double*       y  )
+/* ------------------------------------------------------------------------- *
+ * Stockham pass for factor 3.
+ * ------------------------------------------------------------------------- */
+{
+  const int_t  ld = 2 * nt;
+  const double h  = sg * 0.86602540378443864676;
+  int_t        j, q, c;
+
+  for (j = 0; j < m; j++, tw += 6) {
+    const double w1r = tw[2], w1i = sg * tw[3];
+    const double w2r = tw[4], w2i = sg * tw[5];
+    for (q = 0; q < s; q++) {
+      const double* restrict a0 = x + (q + s *  j)          * ld;
+      const double* restrict a1 = x + (q + s * (j +     m)) * ld;
+      const double* restrict a2 = x + (q + s * (j + 2 * m)) * ld;
+      double*       restrict b0 = y + (q + s *  3 * j)      * ld;
+      double*       restrict b1 = y + (q + s * (3 * j + 1)) * ld;
+      double*       restrict b2 = y + (q + s * (3 * j + 2)) * ld;
+      for (c = 0; c < nt; c++) {
+	const double tr = a1[c]      + a2[c];
+	const double ti = a1[c + nt] + a2[c + nt];
+	const double ur = a0[c]      - 0.5 * tr;
+	const double ui = a0[c + nt] - 0.5 * ti;
+	const double vr = -h * (a1[c + nt] - a2[c + nt]);
+	const double vi =  h * (a1[c]      - a2[c]);
+	const double c1r = ur + vr, c1i = ui + vi;
+	const double c2r = ur - vr, c2i = ui - vi;
+	b0[c]      = a0[c]      + tr;
+	b0[c + nt] = a0[c + nt] + ti;
+	b1[c]      = c1r * w1r - c1i * w1i;
+	b1[c + nt] = c1r * w1i + c1i * w1r;
+	b2[c]      = c2r * w2r - c2i * w2i;
+	b2[c + nt] = c2r * w2i + c2i * w2r;
+      }
+    }
+  }
+}
+
+
+static void pass4 (const int_t   m  ,
+		   const int_t   s  ,
+		   const int_t   nt ,
+		   const double* tw ,
+		   const double  sg ,
+		   const double* x  ,
+		   double*       y  )
+/* ------------------------------------------------------------------------- *
+ * Stockham pass for factor 4.
+ * ------------------------------------------------------------------------- */
+{
+  const int_t ld = 2 * nt;
+  int_t       j, q, c;
+
+  for (j = 0; j < m; j++, tw += 8) {
+    const double w1r = tw[2], w1i = sg * tw[3];
+    const double w2r = tw[4], w2i = sg * tw[5];
+    const double w3r = tw[6], w3i = sg * tw[7];
+    for (q = 0; q < s; q++) {
+      const double* restrict a0 = x + (q + s *  j)          * ld;
+      const double* restrict a1 = x + (q + s * (j +     m)) * ld;
+      const double* restrict a2 = x + (q + s * (j + 2 * m)) * ld;
+      const double* restrict a3 = x + (q + s * (j + 3 * m)) * ld;
+      double*       restrict b0 = y + (q + s *  4 * j)      * ld;
+      double*       restrict b1 = y + (q + s * (4 * j + 1)) * ld;
+      double*       restrict b2 = y + (q + s * (4 * j + 2)) * ld;
+      double*       restrict b3 = y + (q + s * (4 * j + 3)) * ld;
+      for (c = 0; c < nt; c++) {
+	const double t0r = a0[c]      + a2[c],      t0i = a0[c + nt] + a2[c + nt];
+	const double t1r = a0[c]      - a2[c],      t1i = a0[c + nt] - a2[c + nt];
+	const double t2r = a1[c]      + a3[c],      t2i = a1[c + nt] + a3[c + nt];
+	const double t3r = -sg * (a1[c + nt] - a3[c + nt]);
+	const double t3i =  sg * (a1[c]      - a3[c]);
+	const double c1r = t1r + t3r, c1i = t1i + t3i;
+	const double c2r = t0r - t2r, c2i = t0i - t2i;
+	const double c3r = t1r - t3r, c3i = t1i - t3i;
+	b0[c]      = t0r + t2r;
+	b0[c + nt] = t0i + t2i;
+	b1[c]      = c1r * w1r - c1i * w1i;
+	b1[c + nt] = c1r * w1i + c1i * w1r;
+	b2[c]      = c2r * w2r - c2i * w2i;
+	b2[c + nt] = c2r * w2i + c2i * w2r;
+	b3[c]      = c3r * w3r - c3i * w3i;
+	b3[c + nt] = c3r * w3i + c3i * w3r;
+      }
+    }
+  }
+}
+
+
+static void passOdd (const int_t   p  ,
+		     const int_t   m  ,
+		     const int_t   s  ,
+		     const int_t   nt ,
+		     const double* tw ,
+		     const double* cs ,
+		     const double  sg ,
+		     const double* x  ,
+		     double*       y  )
+/* ------------------------------------------------------------------------- *
+ * Stockham pass for odd factor p.  With S_r = a_r + a_{p-r} and D_r =
+ * a_r - a_{p-r}, outputs k and p-k are A +/- i B, where A = a_0 + sum
+ * S_r cos (2 PI r k / p) and B = sg sum D_r sin (2 PI r k / p), summed
+ * over r = 1 .. (p-1)/2.  Rows are taken in chunks of CHUNK values.
+ * The cosines and sines are taken from cs, as built in getPlan.
+ * ------------------------------------------------------------------------- */
+{
+  const int_t ld = 2 * nt, h = (p - 1) / 2;
+  double      Ar[CHUNK], Ai[CHUNK], Br[CHUNK], Bi[CHUNK];
+  int_t       j, q, c, c0, nc, k, r;
+
+  for (j = 0; j < m; j++, tw += 2 * p)
+    for (q = 0; q < s; q++) {
+      const double* a0 = x + (q + s *  j)      * ld;
+      double*       b0 = y + (q + s *  p * j)  * ld;
+
+      for (c0 = 0; c0 < nt; c0 += CHUNK) {
+	nc = (nt - c0 < CHUNK) ? nt - c0 : CHUNK;
+
+	/* -- Output 0. */
+
+	for (c = 0; c < nc; c++) {
+	  Ar[c] = a0[c0 + c];
+	  Ai[c] = a0[c0 + c + nt];
+	}
+	for (r = 1; r < p; r++) {
+	  const double* ar = x + (q + s * (j + r * m)) * ld + c0;
+	  for (c = 0; c < nc; c++) { Ar[c] += ar[c]; Ai[c] += ar[c + nt]; }
+	}
+	for (c = 0; c < nc; c++) {
+	  b0[c0 + c]      = Ar[c];
+	  b0[c0 + c + nt] = Ai[c];
+	}
+
+	/* -- Outputs k and p - k. */
+
+	for (k = 1; k <= h; k++) {
+	  double* bk = y + (q + s * (p * j + k))     * ld + c0;
+	  double* bl = y + (q + s * (p * j + p - k)) * ld + c0;
+	  const double wkr = tw[2 * k],       wki = sg * tw[2 * k + 1];
+	  const double wlr = tw[2 * (p - k)], wli = sg * tw[2 * (p - k) + 1];
+
+	  for (c = 0; c < nc; c++) {
+	    Ar[c] = a0[c0 + c];
+	    Ai[c] = a0[c0 + c + nt];
+	    Br[c] = Bi[c] = 0.0;
+	  }
+	  for (r = 1; r <= h; r++) {
+	    const double* ar = x + (q + s * (j + r * m))       * ld + c0;
+	    const double* al = x + (q + s * (j + (p - r) * m)) * ld + c0;
+	    const int_t   rk = (r * k) % p;
+	    const double  cr = cs[2 * rk], sr = sg * cs[2 * rk + 1];
+	    for (c = 0; c < nc; c++) {
+	      Ar[c] += cr * (ar[c]      + al[c]);
+	      Ai[c] += cr * (ar[c + nt] + al[c + nt]);
+	      Br[c] += sr * (ar[c]      - al[c]);
+	      Bi[c] += sr * (ar[c + nt] - al[c + nt]);
+	    }
+	  }
+	  for (c = 0; c < nc; c++) {
+	    const double ckr = Ar[c] - Bi[c], cki = Ai[c] + Br[c];
+	    const double clr = Ar[c] + Bi[c], cli = Ai[c] - Br[c];
+	    bk[c]      = ckr * wkr - cki * wki;
+	    bk[c + nt] = ckr * wki + cki * wkr;
+	    bl[c]      = clr * wlr - cli * wli;
+	    bl[c + nt] = clr * wli + cli * wlr;
+	  }
+	}
+      }
+    }
+}
+
+
+static double* stockham (Plan*        P   ,
+		     double*      data,
+		     const double sg  )
+/* ------------------------------------------------------------------------- *
+ * Unnormalised complex transform of length M = tlen / 2, exponent sign
+ * sg, of data.  Returns the area (data or work) holding the result.
+ * ------------------------------------------------------------------------- */
+{
+  const int_t   nt = P -> ntrn;
+  const double* tw = P -> tw;
+  const double* cs = P -> cs;
+  double        *x = data, *y = work, *t;
+  int_t         i, p, m, s = 1, len = P -> tlen >> 1;
+
+  for (i = 0; i < P -> nfac; i++) {
+    p = P -> fac[i];
+    m = len / p;
+    switch (p) {
+    case 2:  pass2   (   m, s, nt, tw, sg, x, y); break;
+    case 3:  pass3   (   m, s, nt, tw, sg, x, y); break;
+    case 4:  pass4   (   m, s, nt, tw, sg, x, y); break;
+    default: passOdd (p, m, s, nt, tw, cs, sg, x, y); cs += 2 * p; break;
+    }
+    tw  += 2 * len;
+    s   *= p;
+    len  = m;
+    t = x; x = y; y = t;
+  }
+
+  return x;
+}
+
+
+void preFFT (const int_t tlen)
+/* ------------------------------------------------------------------------- *
+ * Carry out FFT rule checks.
+ * ------------------------------------------------------------------------- */
+{
+  const char routine[] = "preFFT";
+  char       err[STR_MAX];
+
+  if (tlen < 1 || tlen & 1) {
+    sprintf (err, "transform length (%1d) must be even, and positive", tlen);
+    message (routine, err, ERROR);
+  }
+}
+
+
+void dDFTr (double*     data,
+	    const int_t tlen,
+	    const int_t ntrn,
+	    const int_t sign)
+/* ------------------------------------------------------------------------- *
+ * Carry out multiple 1D real--complex Fourier transforms of data.
+ *
+ * With z_m = x_2m + i x_2m+1 and Z its length-M transform, the real
+ * transform is X_k = E_k + w^k O_k, w = exp (-2 PI i / tlen), where
+ * E_k = (Z_k + conj Z_M-k) / 2 and O_k = (Z_k - conj Z_M-k) / 2i.
+ * Modes k and M - k are formed together, in place.
+ * ------------------------------------------------------------------------- */
+{
+  const int_t  M  = tlen >> 1;
+  const double sg = (sign == FORWARD) ? -1.0 : 1.0;
+  Plan*        P;
+  double       *z, *zr, *zi, *xr, *xi;
+  int_t        c, k;
+
+  if (tlen < 2 || !ntrn) return;
+
+  preFFT (tlen);
+  P = getPlan (tlen, ntrn);
+
+  if (sign == FORWARD) {
+    const double scale = 1.0 / tlen;
+
+    z = stockham (P, data, sg);
+
+    for (c = 0; c < ntrn; c++) {
+      const double re = z[c], im = z[c + ntrn];
+      data[c]        = scale * (re + im);
+      data[c + ntrn] = scale * (re - im);
+    }
+
+    for (k = 1; k <= M / 2; k++) {
+      const double wr = P -> split[2 * k], wi = P -> split[2 * k + 1];
+      const double* ar = z + 2 * k       * ntrn;
+      const double* ai = ar + ntrn;
+      const double* br = z + 2 * (M - k) * ntrn;
+      const double* bi = br + ntrn;
+      double*       xk = data + 2 * k       * ntrn;
+      double*       xl = data + 2 * (M - k) * ntrn;
+      for (c = 0; c < ntrn; c++) {
+	const double er = 0.5 * (ar[c] + br[c]), ei = 0.5 * (ai[c] - bi[c]);
+	const double qr = 0.5 * (ai[c] + bi[c]), qi = 0.5 * (br[c] - ar[c]);
+	const double tr = wr * qr - wi * qi,    ti = wr * qi + wi * qr;
+	xk[c]        = scale * (er + tr);
+	xk[c + ntrn] = scale * (ei + ti);
+	if (k < M - k) {
+	  xl[c]        = scale * (er - tr);
+	  xl[c + ntrn] = scale * (ti - ei);
+	}
+      }
+    }
+
+  } else {
+
+    for (c = 0; c < ntrn; c++) {
+      const double x0 = data[c], xM = data[c + ntrn];
+      data[c]        = x0 + xM;
+      data[c + ntrn] = x0 - xM;
+    }
+
+    for (k = 1; k <= M / 2; k++) {
+      const double wr = P -> split[2 * k], wi = P -> split[2 * k + 1];
+      double* ar = data + 2 * k       * ntrn;
+      double* ai = ar + ntrn;
+      double* br = data + 2 * (M - k) * ntrn;
+      double* bi = br + ntrn;
+      for (c = 0; c < ntrn; c++) {
+	const double er = ar[c] + br[c], ei = ai[c] - bi[c];
+	const double dr = ar[c] - br[c], di = ai[c] + bi[c];
+	const double qr = dr * wr + di * wi, qi = di * wr - dr * wi;
+	ar[c] = er - qi;
+	ai[c] = ei + qr;
+	if (k < M - k) {
+	  br[c] = er + qi;
+	  bi[c] = qr - ei;
+	}
+      }
+    }
+
+    z = stockham (P, data, sg);
+    if (z != data) dcopy (tlen * ntrn, z, 1, data, 1);
+  }
+}
+
+#undef NPLAN
+#undef MAXFAC
+#undef CHUNK
+
 #endif
+
+
+/*****************************************************************************
+ * Real-to-real transforms for data with reflection symmetry about z = 0,
+ * sampled at the tlen points z_j = (j + 1/2) PI / (tlen BETA) of the
+ * half period.  Even data have a cosine series, odd data a sine series:
+ *
+ *   x_j =  c_0 + 2 sum_{k=1}^{tlen-1} c_k cos (PI k (j + 1/2) / tlen),
+ *   x_j = -s_0 (-1)^j - 2 sum_{k=1}^{tlen-1} s_k sin (PI k (j + 1/2) / tlen).
+ *
+ * With these scalings, c_k and s_k are the real and imaginary parts
+ * of mode k that dDFTr would give for the same data on the full
+ * period, so mode 0 is again the mean value.  Like the Nyquist data
+ * of dDFTr, s_0 (the sine mode tlen) is carried but does not evolve.
+ *
+ * Both are computed with a real FFT of length tlen (Makhoul 1980,
+ * IEEE Trans ASSP 28:27), so tlen must be even.  FORWARD takes x to
+ * c (or s), INVERSE the reverse, in place, for ntrn columns.
+ *****************************************************************************/
+
+static double* rwork;
+static int_t   rsize;
+
+
+static double* rrWork (const int_t n)
+/* ------------------------------------------------------------------------- *
+ * Return work area of at least n words, retained between calls.
+ * ------------------------------------------------------------------------- */
+{
+  if (n > rsize) {
+    free (rwork);
+    rwork = (double*) malloc (n * sizeof (double));
+    rsize = n;
+  }
+
+  return rwork;
+}
+
+
+void dDCTr (double*     data,
+	    const int_t tlen,
+	    const int_t ntrn,
+	    const int_t sign)
+/* ------------------------------------------------------------------------- *
+ * Cosine transform (DCT-II forward, DCT-III inverse) of data.
+ *
+ * The even-indexed points, then the odd-indexed ones in reverse, form
+ * v, whose transform V gives c_k = Re (exp (-i PI k / 2 tlen) V_k).
+ * Modes k and tlen - k come from the same V_k, and are made together.
+ * ------------------------------------------------------------------------- */
+{
+  const int_t  h = tlen >> 1;
+  double*      v;
+  int_t        c, j, k;
+
+  if (tlen < 2 || !ntrn) return;
+
+  preFFT (tlen);
+  v = rrWork (tlen * ntrn);
+
+  if (sign == FORWARD) {
+
+    for (j = 0; j < h; j++) {
+      dcopy (ntrn, data + 2 * j       * ntrn, 1, v + j              * ntrn, 1);
+      dcopy (ntrn, data + (2 * j + 1) * ntrn, 1, v + (tlen - 1 - j) * ntrn, 1);
+    }
+
+    dDFTr (v, tlen, ntrn, FORWARD);
+
+    dcopy (ntrn, v, 1, data, 1);
+    dsmul (ntrn, sqrt (0.5), v + ntrn, 1, data + h * ntrn, 1);
+
+    for (k = 1; k < h; k++) {
+      const double  C  = cos (M_PI * k / (2 * tlen));
+      const double  S  = sin (M_PI * k / (2 * tlen));
+      const double* Re = v + 2 * k * ntrn;
+      const double* Im = Re + ntrn;
+      double*       ck = data + k          * ntrn;
+      double*       cl = data + (tlen - k) * ntrn;
+      for (c = 0; c < ntrn; c++) {
+	ck[c] = C * Re[c] + S * Im[c];
+	cl[c] = S * Re[c] - C * Im[c];
+      }
+    }
+
+  } else {
+
+    dcopy (ntrn, data, 1, v, 1);
+    dsmul (ntrn, sqrt (2.0), data + h * ntrn, 1, v + ntrn, 1);
+
+    for (k = 1; k < h; k++) {
+      const double  C  = cos (M_PI * k / (2 * tlen));
+      const double  S  = sin (M_PI * k / (2 * tlen));
+      const double* ck = data + k          * ntrn;
+      const double* cl = data + (tlen - k) * ntrn;
+      double*       Re = v + 2 * k * ntrn;
+      double*       Im = Re + ntrn;
+      for (c = 0; c < ntrn; c++) {
+	Re[c] = C * ck[c] + S * cl[c];
+	Im[c] = S * ck[c] - C * cl[c];
+      }
+    }
+
+    dDFTr (v, tlen, ntrn, INVERSE);
+
+    for (j = 0; j < h; j++) {
+      dcopy (ntrn, v + j              * ntrn, 1, data + 2 * j       * ntrn, 1);
+      dcopy (ntrn, v + (tlen - 1 - j) * ntrn, 1, data + (2 * j + 1) * ntrn, 1);
+    }
+  }
+}
+
+
+static void reverse (double*     data,
+		     const int_t tlen,
+		     const int_t ntrn)
+/* ------------------------------------------------------------------------- *
+ * Negate rows of data, and exchange rows k and tlen - k, 0 < k < tlen.
+ * ------------------------------------------------------------------------- */
+{
+  int_t c, k;
+
+  for (k = 0; k <= tlen >> 1; k++) {
+    double* a = data + k                            * ntrn;
+    double* b = data + ((tlen - k) % tlen) * ntrn;
+    for (c = 0; c < ntrn; c++) {
+      const double t = a[c];
+      a[c] = -b[c];
+      b[c] = -t;
+    }
+  }
+}
+
+
+void dDSTr (double*     data,
+	    const int_t tlen,
+	    const int_t ntrn,
+	    const int_t sign)
+/* ------------------------------------------------------------------------- *
+ * Sine transform (DST-II forward, DST-III inverse) of data.  Since
+ * sin (PI (tlen - k) (j + 1/2) / tlen) = (-1)^j cos (PI k (j + 1/2) /
+ * tlen), this is the cosine transform of (-1)^j x_j, with the modes
+ * in reverse order.
+ * ------------------------------------------------------------------------- */
+{
+  int_t j;
+
+  if (tlen < 2 || !ntrn) return;
+
+  if (sign == FORWARD) {
+    for (j = 1; j < tlen; j += 2) dneg (ntrn, data + j * ntrn, 1);
+    dDCTr   (data, tlen, ntrn, FORWARD);
+    reverse (data, tlen, ntrn);
+  } else {
+    reverse (data, tlen, ntrn);
+    dDCTr   (data, tlen, ntrn, INVERSE);
+    for (j = 1; j < tlen; j += 2) dneg (ntrn, data + j * ntrn, 1);
+  }
+}
@@ -56,6 +56,10 @@ extern "C" {
 			const int_t& kd, const int_t& nrhs,
 			const float*  ab, const int_t& ldab,
 			float*  b, const int_t& ldb, int_t& info);
+  void F77NAME(dpotrf) (const char* uplo, const int_t& n,
+			double* a, const int_t& lda, int_t& info);
+  void F77NAME(spotrf) (const char* uplo, const int_t& n,
+			float*  a, const int_t& lda, int_t& info);
   void F77NAME(dpptrf) (const char* uplo, const int_t& n,
 			double* ap, int_t& info);
   void F77NAME(spptrf) (const char* uplo, const int_t& n, 
@@ -197,6 +201,17 @@ public:
     F77NAME(spbtrs) (uplo,n,kd,nrhs,ab,ldab,b,ldb,info);
   }
 
+  // -- Cholesky factor a real P-D symmetric matrix (full storage).
+
+  static void potrf (const char *uplo, const int_t& n,
+		     double *a, const int_t& lda, int_t& info) {
+    F77NAME(dpotrf) (uplo,n,a,lda,info);
+  }
+  static void potrf (const char *uplo, const int_t& n,
+		     float  *a, const int_t& lda, int_t& info) {
+    F77NAME(spotrf) (uplo,n,a,lda,info);
+  }
+
   // -- Cholesky factor a real P-D packed-symmetric matrix.
 
   static void pptrf (const char *uplo, const int_t& n,
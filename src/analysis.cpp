@@ -28,9 +28,12 @@ Analyser::Analyser (Domain* D   ,
 //
 // Output is of the same form, called session.trk. Time is the time at
 // which the information was dumped, ctime the time at which the
-// particle was created.
+// particle was created.  Particles are integrated with a fixed step,
+// so cannot be combined with DT_ADAPT.
 //
-// NB: Particle tracking does not work for multiprocessor runs.
+// Particle tracking works on multiprocessor runs: every process
+// integrates all the particles, with velocity evaluation shared over
+// processes by Fourier plane (see ParticleSet, AuxField::probe).
 //
 // History points are also set up here.  They are nominated in the
 // optional HISTORY section of the session file.  Output is to
@@ -43,7 +46,8 @@ Analyser::Analyser (Domain* D   ,
 // them declared in the unshifted/unscaled coordinates.
 //  
 // ---------------------------------------------------------------------------
-  _src (D)
+  _src   (D),
+  _dtMax (0.0)
 {
   const char   routine[] = "Analyser::Analyser";
   char         str[StrMax];
@@ -55,40 +59,43 @@ Analyser::Analyser (Domain* D   ,
 #endif
   cout << setprecision (6);
 
-  // -- Set up for particle tracking.
+  // -- Set up for particle tracking.  All processes hold all particles.
 
-  ROOTONLY {
+  ifstream pfile (strcat (strcpy (str, _src -> name), ".par"));
+
+  if (pfile.fail())
+    _particle = 0;
 
-    // -- Open particle track file, create particles.
+  else {
+    const int_t add = Femlib::ivalue ("SPAWN");
+    int_t       id, i = 0;
+    Point       P, *I;
 
-    ifstream pfile (strcat (strcpy (str, _src -> name), ".par"));
+    if (Femlib::ivalue ("DT_ADAPT") > 1)
+      Veclib::alert (routine, "particle tracking needs fixed D_T", ERROR);
 
-    if (!pfile.fail()) {
-      const int_t    add = Femlib::ivalue ("SPAWN");
-      int_t          id, i = 0;
-      Point          P, *I;
-      FluidParticle* F;
+    _particle = new ParticleSet (_src);
 
+    ROOTONLY {
       _par_strm.open (strcat (strcpy (str, _src -> name), ".trk"));
       _par_strm.setf (ios::scientific, ios::floatfield);
       _par_strm.precision (6);
+    }
 
-      while (pfile >> id >> P.x >> P.x >> P.x >> P.y >> P.z) {
+    while (pfile >> id >> P.x >> P.x >> P.x >> P.y >> P.z) {
 #if 0
-        P.x = (P.x + x_shft) * x_scal;  // -- shft and scal default to 0 and 1
-        P.y = (P.y + y_shft) * y_scal;
+      P.x = (P.x + x_shft) * x_scal;  // -- shft and scal default to 0 and 1
+      P.y = (P.y + y_shft) * y_scal;
 #endif
-	F = new FluidParticle (_src, ++i, P);
-	if (!(F -> inMesh())) {
+      if (!_particle -> add (++i, P)) {
+	ROOTONLY {
 	  sprintf (str, "Particle at (%f, %f, %f) not in mesh", P.x, P.y, P.z);
 	  Veclib::alert (routine, str, WARNING);
-	} else
-	  _particle.push_back (F);
-	if (add && F -> inMesh()) {
-	  I = new Point;
-	  I -> x = P.x; I -> y = P.y; I -> z = P.z;
-	  _initial.insert (_initial.end(), I);
 	}
+      } else if (add) {
+	I = new Point;
+	I -> x = P.x; I -> y = P.y; I -> z = P.z;
+	_initial.insert (_initial.end(), I);
       }
     }
   }
@@ -196,8 +203,6 @@ void Analyser::analyse (AuxField** work0, // -- Us[0].
   const bool  add     = Femlib::ivalue ("SPAWN"  ) &&
     ! (_src -> step   % Femlib::ivalue ("SPAWN"  ));
 
-  list<FluidParticle*>::iterator p;
-
   // -- Step-by-step updates.
 
   ROOTONLY {
@@ -207,30 +212,31 @@ void Analyser::analyse (AuxField** work0, // -- Us[0].
     // -- Run information update.
 
     cout << "Step: " << _src -> step << "  Time: " << _src -> time << endl;
+  }
 
-    // -- Track particles.
+  // -- Track particles.
 
+  if (_particle) {
     if (add) {
-      FluidParticle *F;
-      Point          P, *I;
-      int_t          i = 0, j;
-      const int_t    N = _initial.size();
+      Point       P, *I;
+      int_t       i = 0, j;
+      const int_t N = _initial.size();
 
       for (j = 0; j < N; j++) {
 	I = _initial[j];
 	P.x = I -> x; P.y = I -> y; P.z = I -> z;
-	_particle.push_back (F = new FluidParticle (_src, ++i, P));
+	_particle -> add (++i, P);
       }
     }
 
-    for (p = _particle.begin(); p != _particle.end(); p++) (*p) -> integrate();
+    _particle -> integrate();
   }
 
   // -- CFL, divergence information.
 
   if (cflstep && !(_src -> step % cflstep)) {
     ROOTONLY this -> divergence (work0);
-    this -> estimateCFL (work0[0]);
+    _dtMax = this -> estimateCFL (work0[0]);
   }    
 
   // -- Phase averaging.
@@ -258,51 +264,43 @@ void Analyser::analyse (AuxField** work0, // -- Us[0].
 
   if (state) {
 
-    ROOTONLY {			// -- Output particle locations.
-      Point          P;
-      FluidParticle* F;
-
-      for (p = _particle.begin(); p != _particle.end(); p++) {
-	F = *p;
-	if (F -> inMesh()) {
-	  P = F -> location();
-	  _par_strm
-	    << setw (6) << F -> ID()
-	    << setw(14) << _src -> time
-	    << setw(14) << F -> ctime()
-	    << setw(14) << P.x
-	    << setw(14) << P.y
-	    << setw(14) << P.z
-	    << endl;
-	}
-      }
-    }
+    ROOTONLY			// -- Output particle locations.
+      if (_particle) _particle -> write (_par_strm);
 
     // -- Output history point data.
 
-    int_t             i, j;
-    const int_t       NH = _history.size();
-    const int_t       NF = _src-> u.size();
-    HistoryPoint*     H;
-    vector<real_t>    tmp (NF);
-    vector<AuxField*> u   (NF);
+    int_t                  i, j;
+    const int_t            NH = _history.size();
+    const int_t            NF = _src-> u.size();
+    HistoryPoint*          H;
+    vector<real_t>         tmp (NH * NF), r (NH), s (NH), z (NH);
+    vector<const Element*> E   (NH);
+    vector<AuxField*>      u   (NF);
 
     for (i = 0; i < NF; i++) u[i] = _src -> u[i];
 
+    // -- All points at once: one collective operation for parallel runs.
+
     for (i = 0; i < NH; i++) {
-      H = _history[i];
+      H    = _history[i];
+      E[i] = H -> elmt();
+      r[i] = H -> r();
+      s[i] = H -> s();
+      z[i] = H -> z();
+    }
 
-      H -> extract (u, &tmp[0]);
+    if (NH) AuxField::probe (u, NH, &E[0], &r[0], &s[0], &z[0], &tmp[0]);
 
-      ROOTONLY {
-	_his_strm << setw(4) << H->ID()
-		  << setprecision(8) << setw(15)
-		  << _src->time
-		  << setprecision(6);
-	for (j = 0; j < NF-1; j++) _his_strm << setw(14) << tmp[j];
-	_his_strm<< setprecision(11)<< setw(19)<< tmp[NF-1]<< setprecision(6);
-	_his_strm << endl;
-      }
+    ROOTONLY for (i = 0; i < NH; i++) {
+      H = _history[i];
+      _his_strm << setw(4) << H->ID()
+		<< setprecision(8) << setw(15)
+		<< _src->time
+		<< setprecision(6);
+      for (j = 0; j < NF-1; j++) _his_strm << setw(14) << tmp[j*NH + i];
+      _his_strm<< setprecision(11)<< setw(19)<< tmp[(NF-1)*NH + i]
+	       << setprecision(6);
+      _his_strm << endl;
     }
   }
 
@@ -328,6 +326,26 @@ void Analyser::analyse (AuxField** work0, // -- Us[0].
 }
 
 
+void Analyser::writeState (ostream& strm)
+// ---------------------------------------------------------------------------
+// Write running-average state (if any) for an exact warm restart.
+// Phase averages are kept in their own files between updates, so need
+// nothing here.
+// ---------------------------------------------------------------------------
+{
+  if (_stats) _stats -> writeState (strm);
+}
+
+
+void Analyser::readState (istream& strm)
+// ---------------------------------------------------------------------------
+// Inverse of writeState.
+// ---------------------------------------------------------------------------
+{
+  if (_stats) _stats -> readState (strm);
+}
+
+
 void Analyser::modalEnergy ()
 // ---------------------------------------------------------------------------
 // Print out modal energies per unit area, output by root processor.
@@ -355,10 +373,12 @@ void Analyser::modalEnergy ()
 		  << endl;
 
       for (i = 1; i < nProc; i++) {
-	Message::recv (&ek[0], N, i);
-	for (m = 0; m < N; m++)
+	const int_t nm = Geometry::nModeProc (i);
+	ek.resize (nm);
+	Message::recv (&ek[0], nm, i);
+	for (m = 0; m < nm; m++)
 	  _mdl_strm << setw(10) << _src -> time
-		    << setw( 5) << m + i * N
+		    << setw( 5) << m + Geometry::baseMode (i)
 		    << setw(16) << ek[m]
 		    << endl;
       }
@@ -420,9 +440,10 @@ void Analyser::divergence (AuxField** work) const
 }
 
 
-void Analyser::estimateCFL (AuxField* work) const
+real_t Analyser::estimateCFL (AuxField* work) const
 // ---------------------------------------------------------------------------
-// Estimate and print the peak CFL number.
+// Estimate and print the peak CFL number.  Return the corresponding
+// largest stable time step (on all processes).
 // References:
 //     SEM:     Karniadakis and Sherwin (2005), section 6.3.1
 //     Fourier: Canuto, Hussaini, Quarteroni and Zhang, vol. 1 (2006), 
@@ -436,7 +457,7 @@ void Analyser::estimateCFL (AuxField* work) const
   static vector<int_t>  maxCmpt (nProc);
 
   const real_t dt = Femlib::value ("D_T");  
-  real_t       CFL_dt, dt_max;
+  real_t       CFL_dt, dt_max = 0.0;
   int_t        i, percent, elmt_i, elmt_j, cmpt_i;
   real_t       CFL_i[3];
 
@@ -504,4 +525,8 @@ void Analyser::estimateCFL (AuxField* work) const
          << ", elmt: "     << elmt_i + 1 << endl;
          // -- 1-based indexing as in session file.
   }
+
+  if (nProc > 1) Message::sum (&dt_max, 1);
+
+  return dt_max;
 }
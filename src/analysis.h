@@ -12,7 +12,11 @@ public:
   Analyser  (Domain*, FEML*);
   ~Analyser () { }
 
-  void analyse (AuxField**, AuxField**);
+  void analyse    (AuxField**, AuxField**);
+  void writeState (ostream&);
+  void readState  (istream&);
+
+  real_t dtMax    () const { return _dtMax; }
 
 protected:
   Domain*               _src      ; // Source information.
@@ -20,14 +24,15 @@ protected:
   ofstream              _his_strm ; // File for history points.
   ofstream              _mdl_strm ; // File for modal energies.
   vector<HistoryPoint*> _history  ; // Locations, etc. of history points.
-  list<FluidParticle*>  _particle ; // List of fluid particles.
+  ParticleSet*          _particle ; // Fluid particles, if any.
   vector<Point*>        _initial  ; // Starting locations of particles.
   Statistics*           _stats    ; // Field average statistics.
   Statistics*           _ph_stats ; // Phase-average field statistics.
+  real_t                _dtMax    ; // Largest stable D_T, last estimate.
 
-  void modalEnergy ();
-  void divergence  (AuxField**) const;
-  void estimateCFL (AuxField*)  const;
+  void   modalEnergy ();
+  void   divergence  (AuxField**) const;
+  real_t estimateCFL (AuxField*) const;
 };
 
 #endif
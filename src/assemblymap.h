@@ -68,6 +68,8 @@ public:
   const int_t* emask () const { return &_emask[0];         }
   const int_t* btog  () const { return &_btog[0];          }  // Assembly map.
   int_t        fmask () const { return _nglobal - _nsolve; }
+
+  int_t buildAdjncySC   (vector<int_t>&, vector<int_t>&, const int_t = 0) const;
   
 private:
   int_t _optlev ;	  // Optimization level used for btog.
@@ -85,7 +87,6 @@ private:
   vector<pair<char, int_t>* > _tag; // Field name and mode tag pairs for *this.
 
   int_t sortGid         (vector<int_t>&, const vector<int_t>&);
-  int_t buildAdjncySC   (vector<int_t>&, vector<int_t>&, const int_t = 0) const;
   int_t globalBandwidth () const;
   void  connectivSC     (vector<vector<int_t> >&, const int_t*,
 			 const int_t*, const int_t) const;
@@ -22,7 +22,8 @@ AuxField::AuxField (real_t*           alloc, // -- Amount of storage per proc.
   _elmt (elmt),
   _nz   (nz),
   _size (nz * Geometry::planeSize()),
-  _data (alloc)
+  _data (alloc),
+  _odd  (Geometry::symmetric() && name == 'w')
 {
   const char  routine[] = "AuxField::AuxField";
   const int_t nP = Geometry::planeSize();
@@ -44,7 +45,7 @@ AuxField& AuxField::operator = (const real_t val)
 // ---------------------------------------------------------------------------
 {
   if   (val == 0.0) Veclib::zero (_size,      _data, 1);
-  else              Veclib::fill (_size, val, _data, 1);
+  else {            Veclib::fill (_size, val, _data, 1); _odd = false; }
 
   return *this;
 }
@@ -103,6 +104,7 @@ AuxField& AuxField::operator = (const AuxField& f)
 // --------------------------------------------------------------------------
 {
   Veclib::copy (_size, f._data, 1, _data, 1);
+  _odd = f._odd;
   
   return *this;
 }
@@ -114,6 +116,7 @@ AuxField& AuxField::operator - (const AuxField& f)
 // --------------------------------------------------------------------------
 {
   Veclib::vneg (_size, f._data, 1, _data, 1);
+  _odd = f._odd;
   
   return *this;
 }
@@ -125,6 +128,7 @@ AuxField& AuxField::operator += (const AuxField& f)
 // --------------------------------------------------------------------------
 {
   Veclib::vadd (_size, _data, 1, f._data, 1, _data, 1);
+  _odd = f._odd;
 
   return *this;
 }
@@ -136,6 +140,7 @@ AuxField& AuxField::operator -= (const AuxField& f)
 // --------------------------------------------------------------------------
 {
   Veclib::vsub (_size, _data, 1, f._data, 1, _data, 1);
+  _odd = f._odd;
 
   return *this;
 }
@@ -147,6 +152,7 @@ AuxField& AuxField::operator *= (const AuxField& f)
 // --------------------------------------------------------------------------
 {
   Veclib::vmul (_size, _data, 1, f._data, 1, _data, 1);
+  _odd ^= f._odd;
 
   return *this;
 }
@@ -160,6 +166,7 @@ AuxField& AuxField::operator /= (const AuxField& f)
 // --------------------------------------------------------------------------
 {
   Veclib::vdiv (_size, _data, 1, f._data, 1, _data, 1);
+  _odd ^= f._odd;
 
   return *this;
 }
@@ -175,12 +182,11 @@ AuxField& AuxField::operator = (const char* function)
   const int_t  kb  = Geometry::basePlane();
   const int_t  nP  = Geometry::nPlane();
   const int_t  NP  = Geometry::planeSize();
-  const real_t dz  = Femlib::value ("TWOPI / BETA / N_Z");
   int_t        i, k;
   real_t*      p;
 
   for (k = 0; k < _nz; k++) {
-    Femlib::value ("z", (kb + k) * dz);
+    Femlib::value ("z", Geometry::zPlane (kb + k));
     for (p = _plane[k], i = 0; i < nel; i++, p += np2)
       _elmt[i] -> evaluate (function, p);
     Veclib::zero (NP-nP, _plane[k] + nP, 1);
@@ -238,6 +244,7 @@ AuxField& AuxField::innerProduct (const vector <AuxField*>& a   ,
 
   for (i = 0; i < NCOM; i++)
     Veclib::vvtvp (_size, a[i]->_data, 1, b[i]->_data, 1, _data, 1, _data, 1);
+  _odd = a[0]->_odd ^ b[0]->_odd;
 
   return *this;
 }
@@ -382,7 +389,6 @@ AuxField& AuxField::crossXPlus (const int             com,
   vector<real_t> alocal = a;
   real_t         theta;
   real_t         zp;	// z position
-  const real_t   beta = Femlib::value ("BETA");
 
   // WATCH OUT:  nz == total number of z-planes
   //           _nz == number of z-planes per process
@@ -399,7 +405,7 @@ AuxField& AuxField::crossXPlus (const int             com,
       alocal[2] = -sin(theta) * a[1] + cos(theta) * a[2];
       zp = 0.;
     } else
-      zp = z * TWOPI / (beta * nz);
+      zp = Geometry::zPlane (z);
 
     for (p = _plane[k], i = 0; i < nel; i++, p += npnp)
       _elmt[i] -> crossXPlus (com, zp, alocal, p);
@@ -421,6 +427,7 @@ AuxField& AuxField::times (const AuxField& a,
     Veclib::alert (routine, "non-congruent inputs", ERROR);
   
   Veclib::vmul (_size, a._data, 1, b._data, 1, _data, 1);
+  _odd = a._odd ^ b._odd;
 
   return *this;
 }
@@ -439,6 +446,7 @@ AuxField& AuxField::divide (const AuxField& a,
     Veclib::alert (routine, "non-congruent inputs", ERROR);
   
   Veclib::vdiv (_size, a._data, 1, b._data, 1, _data, 1);
+  _odd = a._odd ^ b._odd;
 
   return *this;
 }
@@ -457,6 +465,7 @@ AuxField& AuxField::timesPlus (const AuxField& a,
     Veclib::alert (routine, "non-congruent inputs", ERROR);
 
   Veclib::vvtvp (_size, a._data, 1, b._data, 1, _data, 1, _data, 1);
+  _odd = a._odd ^ b._odd;
 
   return *this;
 }
@@ -475,6 +484,7 @@ AuxField& AuxField::timesMinus (const AuxField& a,
     Veclib::alert (routine, "non-congruent inputs", ERROR);
 
   Veclib::vvvtm (_size, _data, 1, a._data, 1, b._data, 1, _data, 1);
+  _odd = a._odd ^ b._odd;
 
   return *this;
 }
@@ -491,6 +501,7 @@ AuxField& AuxField::axpy (const real_t    alpha,
   if (_size != x._size) Veclib::alert (routine, "non-congruent inputs", ERROR);
 
   Blas::axpy (_size, alpha, x._data, 1, _data, 1);
+  _odd = x._odd;
 
   return *this;
 }
@@ -513,8 +524,25 @@ AuxField& AuxField::gradient (const int_t dir)
 // Operate on AuxField to produce the nominated index of the gradient.
 // dir == 0 ==> gradient in first direction, 1 ==> 2nd, 2 ==> 3rd.
 // AuxField is presumed to have been Fourier transformed in 3rd direction.
+//
+// For a symmetric representation, d/dz takes cosine mode k to beta k
+// times sine mode k, and sine mode k to -beta k times cosine mode k.
 // --------------------------------------------------------------------------
 {
+  if (dir == 2 && Geometry::symmetric()) {
+    const int_t  nP   = Geometry::planeSize();
+    const int_t  base = Geometry::baseMode();
+    const real_t beta = Femlib::value ("BETA");
+    const real_t sgn  = (_odd) ? -1.0 : 1.0;
+    int_t        k;
+
+    for (k = 0; k < _nz; k++)
+      Blas::scal (nP, sgn * beta * (k + base), _plane[k], 1);
+    _odd = !_odd;
+
+    return *this;
+  }
+
 #if defined (_VECTOR_ARCH)	// -- Use vectorised grad2 routines.
 
   const char      routine[] = "AuxField::gradient";
@@ -523,7 +551,7 @@ AuxField& AuxField::gradient (const int_t dir)
   const int_t     npnp = np  * np;
   const int_t     ntot = nel * npnp;
   const int_t     nP   = Geometry::planeSize();
-  vector<real_t>  work;
+  Workspace::Vector work (2 * nP);
   real_t *xr, *xs, *tmp;
   int_t  i, k;
   const real_t    *DV, *DT;
@@ -534,7 +562,6 @@ AuxField& AuxField::gradient (const int_t dir)
   switch (dir) {
 
   case 0:
-    work.resize (2 * nP);
     xr = &work[0];
     xs = xr + nP;
 
@@ -553,7 +580,6 @@ AuxField& AuxField::gradient (const int_t dir)
     break;
 
   case 1:
-    work.resize (2 * nP);
     xr = &work[0];
     xs = xr + nP;
 
@@ -577,7 +603,6 @@ AuxField& AuxField::gradient (const int_t dir)
     const real_t beta   = Femlib::value ("BETA");
     int_t        Re, Im, klo;
 
-    work.resize (nP);
     xr = &work[0];
 
     if (base == 0) { // -- We have real_t & Nyquist planes, to be set zero.
@@ -607,13 +632,12 @@ AuxField& AuxField::gradient (const int_t dir)
   const int_t    ntot = nel * npnp;
   const int_t    nP   = Geometry::planeSize();
   int_t          i, k;
-  vector<real_t> work;
+  Workspace::Vector work (max (2 * npnp, nP));
   real_t         *tmp;
 
   switch (dir) {
 
   case 0:
-    work.resize (2 * npnp);
     for (k = 0; k < _nz; k++) {
      tmp = _plane[k];
      for (i = 0; i < nel; i++, tmp += npnp)
@@ -622,7 +646,6 @@ AuxField& AuxField::gradient (const int_t dir)
     break;
 
   case 1:
-    work.resize (2 * npnp);
     for (k = 0; k < _nz; k++) {
       tmp = _plane[k];
       for (i = 0; i < nel; i++, tmp += npnp)
@@ -636,7 +659,6 @@ AuxField& AuxField::gradient (const int_t dir)
     const real_t beta   = Femlib::value ("BETA");
     int_t        Re, Im, klo;
 
-    work.resize (nP);
 
     if (base == 0) { // -- We have real & Nyquist planes, to be set zero.
       klo = 1; Veclib::zero (2 * nP, _data, 1);
@@ -685,7 +707,7 @@ void AuxField::gradient (const int_t nZ ,
   const int_t     npnp = np  * np;
   const int_t     ntot = nel * npnp;
   int_t  i, k;
-  vector<real_t>  work;
+  Workspace::Vector work (2 * nP);
   real_t *plane, *xr, *xs, *Re, *Im;
   const real_t    *DV, *DT;
 
@@ -695,7 +717,6 @@ void AuxField::gradient (const int_t nZ ,
   switch (dir) {
 
   case 0:
-    work.resize (2 * nP);
     xr = &work[0];
     xs = xr + nP;
 
@@ -713,7 +734,6 @@ void AuxField::gradient (const int_t nZ ,
     break;
 
   case 1:
-    work.resize (2 * nP);
     xr = &work[0];
     xs = xr + nP;
 
@@ -736,7 +756,6 @@ void AuxField::gradient (const int_t nZ ,
     const int_t  nmodes = nZ >> 1;
     const real_t beta = Femlib::value ("BETA");
 
-    work.resize (nP);
     xr = &work[0];
 
     Veclib::zero (2 * nP, src, 1);
@@ -762,20 +781,18 @@ void AuxField::gradient (const int_t nZ ,
   const int_t    npnp = np  * np;
   const int_t    ntot = nel * npnp;
   int_t          i, k;
-  vector<real_t> work;
+  Workspace::Vector work (max (2 * npnp, nP));
   real_t         *plane, *Re, *Im;
 
   switch (dir) {
 
   case 0:
-    work.resize (2 * npnp);
     for (plane = src, k = 0; k < nZ; k++, plane += nP)
       for (Re = plane, i = 0; i < nel; i++, Re += npnp)
 	_elmt[i] -> grad (Re, 0, &work[0]);
     break;
 
   case 1:
-    work.resize (2 * npnp);
     for (plane = src, k = 0; k < nZ; k++, plane += nP)
       for (Re = plane, i = 0; i < nel; i++, Re += npnp)
 	_elmt[i] -> grad (0, Re, &work[0]);
@@ -787,7 +804,6 @@ void AuxField::gradient (const int_t nZ ,
     const int_t  nmodes = nZ >> 1;
     const real_t beta   = Femlib::value ("BETA");
 
-    work.resize  (nP);
     Veclib::zero (2 * nP, src, 1);
 
     for (k = 1; k < nmodes; k++) {
@@ -898,11 +914,15 @@ real_t AuxField::mode_L2 (const int_t mode) const
 // \int u.u dA.  Mode numbers run 0 -- n_z/2 - 1.  Multiply values by
 // area reported by utility function "integral", then by TWOPI/BETA in
 // order to get total integrated over volume.
+//
+// For a symmetric representation, mode numbers run 0 -- n_z - 1, and
+// each mode has only the one (real) plane.
 // --------------------------------------------------------------------------
 {
   const char  routine[] = "AuxField::mode_L2";
   const int_t nel  = Geometry::nElmt();
-  const int_t kr   = 2 * mode;
+  const bool  cplx = _nz > 1 && !Geometry::symmetric();
+  const int_t kr   = (cplx) ? 2 * mode : mode;
   const int_t ki   = kr + 1;
   const int_t npnp = Geometry::nTotElmt();
   real_t      area = 0.0, Ek = 0.0, *Re, *Im;
@@ -910,15 +930,16 @@ real_t AuxField::mode_L2 (const int_t mode) const
   Element*    E;
   
   if (kr < 0  ) Veclib::alert (routine, "negative mode number",        ERROR);
-  if (ki > _nz) Veclib::alert (routine, "mode number exceeds maximum", ERROR);
+  if ((cplx && ki > _nz) || kr >= _nz)
+    Veclib::alert (routine, "mode number exceeds maximum", ERROR);
 
-  Re = _plane[kr]; Im = (_nz > 1) ? _plane[ki] : NULL;
+  Re = _plane[kr]; Im = (cplx) ? _plane[ki] : NULL;
 
   for (i = 0; i < nel; i++, Re += npnp, Im += npnp) {
     E      = _elmt[i];
     area  += E -> area();
     Ek    += sqr (E -> norm_L2 (Re));
-    if (_nz > 1) 
+    if (cplx) 
       Ek  += sqr (E -> norm_L2 (Im));
   }
 
@@ -1023,7 +1044,7 @@ ostream& operator << (ostream&  strm,
 	  Veclib::alert (routine, "unable to write binary output", ERROR);
 
       for (k = 1; k < nProc; k++)
-	for (i = 0; i < F._nz; i++) {
+	for (i = 0; i < Geometry::nZProc (k); i++) {
 	  Message::recv (&buffer[0], NP, k);
 	  strm.write(reinterpret_cast<char*>(&buffer[0]),
 		     static_cast<int_t>(nP * sizeof (real_t))); 
@@ -1076,7 +1097,7 @@ istream& operator >> (istream&  strm,
       }
 
       for (k = 1; k < nProc; k++) {
-	for (i = 0; i < F._nz; i++) {
+	for (i = 0; i < Geometry::nZProc (k); i++) {
 	  strm.read (reinterpret_cast<char*>(&buffer[0]), 
 		     static_cast<int_t>(nP * sizeof (real_t))); 
           if (strm.bad()) 
@@ -1106,10 +1127,14 @@ AuxField& AuxField::zeroNyquist ()
 // --------------------------------------------------------------------------
 // Set storage for highest frequency mode to zero.  This mode is
 // carried but never evolves, and is stored as the second data plane
-// on the lowest-numbered process.
+// on the lowest-numbered process (or for a symmetric representation,
+// as the first plane of an odd field).
 // --------------------------------------------------------------------------
 {
-  ROOTONLY if (_nz > 1) Veclib::zero (Geometry::planeSize(), _plane[1], 1);
+  if (Geometry::symmetric()) {
+    ROOTONLY if (_odd) Veclib::zero (Geometry::planeSize(), _plane[0], 1);
+  } else
+    ROOTONLY if (_nz > 1) Veclib::zero (Geometry::planeSize(), _plane[1], 1);
 
   return *this;
 }
@@ -1118,14 +1143,18 @@ AuxField& AuxField::zeroNyquist ()
 void AuxField::describe (char* s)  const
 // --------------------------------------------------------------------------
 // Load s with a (prism-compatible) description of field geometry:
-// NR NS NZ NEL.
+// NR NS NZ NEL.  For a symmetric representation, "sym" follows: the
+// z planes then hold cosine/sine data (see Geometry).  Readers that
+// only take the four numbers skip it with the rest of the line.
 // --------------------------------------------------------------------------
 {
   ostringstream sf;
   sf << Geometry::nP()    << " "
      << Geometry::nP()    << " "
      << Geometry::nZ()    << " "
-     << Geometry::nElmt() << ends;
+     << Geometry::nElmt();
+  if (Geometry::symmetric()) sf << " sym";
+  sf << ends;
   strcpy (s, sf.str().c_str());
 }
 
@@ -1144,6 +1173,9 @@ AuxField& AuxField::transform (const int_t sign)
 // For multiple-processor execution, data must be gathered across
 // processors prior to Fourier transform, then scattered back.  Each
 // DFT involves two exchanges.
+//
+// For a symmetric representation, the transform is a cosine or a
+// sine transform according to the parity of the field.
 // --------------------------------------------------------------------------
 {
   const int_t nzt = Geometry::nZ();
@@ -1151,7 +1183,17 @@ AuxField& AuxField::transform (const int_t sign)
   const int_t nPR = Geometry::nProc();
   const int_t nPP = Geometry::nBlock();
 
-  if (nPR == 1) {
+  Profile::Scope timer ("transform");
+
+  if (Geometry::symmetric()) {
+    const int_t ntrn = (nPR == 1) ? nP : nPP;
+
+    if (nPR > 1) Message::exchange (_data, _nz, nP, FORWARD);
+    if (_odd) Femlib::DSTr (_data, nzt, ntrn, sign);
+    else      Femlib::DCTr (_data, nzt, ntrn, sign);
+    if (nPR > 1) Message::exchange (_data, _nz, nP, INVERSE);
+
+  } else if (nPR == 1) {
     if (nzt > 1)
       if (nzt == 2)
 	if   (sign == FORWARD) Veclib::zero (nP, _plane[1], 1);
@@ -1170,6 +1212,67 @@ AuxField& AuxField::transform (const int_t sign)
 }
 
 
+void AuxField::transform (const int_t sign,
+			  AuxField**  F   ,
+			  const int_t n   )
+// --------------------------------------------------------------------------
+// (Static class member function.)  Fourier transform n AuxFields in
+// the z direction as for F[i] -> transform (sign), but with a single
+// call to the transform routine, whose length in the other
+// (non-transformed) direction is n times that for one AuxField.  The
+// data are gathered into workspace so that each plane holds those of
+// all n AuxFields in turn, then scattered back, so the results are
+// as for n separate transforms.  Used for the members of an ensemble
+// (which are transformed in lockstep, see dns/drive.cpp).
+//
+// For multiple-processor execution each AuxField is exchanged across
+// processors as for a single transform, and its block of data is
+// gathered in the same way.  The trivial transforms made for N_Z = 1
+// or 2, and those of a symmetric representation whose AuxFields
+// differ in parity, are done one by one.
+// --------------------------------------------------------------------------
+{
+  const int_t nzt = Geometry::nZ();
+  const int_t nP  = Geometry::planeSize();
+  const int_t nPR = Geometry::nProc();
+  const int_t nPP = Geometry::nBlock();
+  const int_t sym = Geometry::symmetric();
+  int_t       i, k;
+
+  for (i = 1; i < n && !(sym && F[i] -> _odd != F[0] -> _odd); i++);
+
+  if (n == 1 || i < n || (!sym && nzt <= 2)) {
+    for (i = 0; i < n; i++) F[i] -> transform (sign);
+    return;
+  }
+
+  Profile::Scope    timer ("transform");
+  const int_t       nblk = (nPR == 1) ? nP : nPP;
+  Workspace::Vector work (n * nzt * nblk);
+  real_t*           data = &work[0];
+
+  for (i = 0; i < n; i++) {
+    if (nPR > 1) Message::exchange (F[i] -> _data, F[i] -> _nz, nP, FORWARD);
+    for (k = 0; k < nzt; k++)
+      Veclib::copy (nblk, F[i] -> _data + k * nblk, 1,
+		    data + (k * n + i) * nblk, 1);
+  }
+
+  if (sym)
+    if (F[0] -> _odd) Femlib::DSTr (data, nzt, n * nblk, sign);
+    else              Femlib::DCTr (data, nzt, n * nblk, sign);
+  else
+    Femlib::DFTr (data, nzt, n * nblk, sign);
+
+  for (i = 0; i < n; i++) {
+    for (k = 0; k < nzt; k++)
+      Veclib::copy (nblk, data + (k * n + i) * nblk, 1,
+		    F[i] -> _data + k * nblk, 1);
+    if (nPR > 1) Message::exchange (F[i] -> _data, F[i] -> _nz, nP, INVERSE);
+  }
+}
+
+
 AuxField& AuxField::transform32 (const int_t sign,
 				 real_t*     phys)
 // --------------------------------------------------------------------------
@@ -1349,6 +1452,8 @@ void AuxField::swapData (AuxField* x,
   x -> _data = y -> _data;
   y -> _data = tmp;
 
+  swap (x -> _odd, y -> _odd);
+
   for (k = 0; k < x -> _nz; k++) {
     tmp            = x -> _plane[k];
     x -> _plane[k] = y -> _plane[k];
@@ -1388,7 +1493,7 @@ void AuxField::couple (AuxField*   v  ,
   const int_t    nMode =  Geometry::nModeProc();
   const int_t    kLo   = (Geometry::procID() == 0) ? 1 : 0;
   int_t k, Re, Im;
-  vector<real_t> work (nP);
+  Workspace::Vector work (nP);
   real_t         *Vr, *Vi, *Wr, *Wi, *tp = &work[0];
   
   if (dir == FORWARD) {
@@ -1607,8 +1712,8 @@ real_t AuxField::probe (const Element* E,
 // Return the value of data on plane k, in Element E, location r, s.
 // --------------------------------------------------------------------------
 {
-  const int_t offset = E -> ID() * Geometry::nTotElmt();
-  vector<real_t>  work (3 * Geometry::nP());
+  const int_t       offset = E -> ID() * Geometry::nTotElmt();
+  Workspace::Vector work (3 * Geometry::nP());
   
   return E -> probe (r, s, _plane[k] + offset, &work[0]);
 }
@@ -1644,7 +1749,7 @@ real_t AuxField::probe (const Element* E,
 
   int_t   k, Re, Im;
   real_t  value, phase;
-  vector<real_t>   work (nZ + _nz + 3 * np);
+  Workspace::Vector work (nZ + _nz + 3 * np);
   real_t* fbuf = &work[0];
   real_t* lbuf = fbuf + nZ;
   real_t*          ewrk = lbuf + _nz;
@@ -1656,12 +1761,12 @@ real_t AuxField::probe (const Element* E,
     ROOTONLY {
       Veclib::copy (_nz, lbuf, 1, fbuf, 1);
       for (k = 1; k < nP; k++) 
-	Message::recv (fbuf + k * _nz, _nz, k);
+	Message::recv (fbuf + Geometry::basePlane (k), Geometry::nZProc (k), k);
     } else
       Message::send (lbuf, _nz, 0);
 
   } else {
-    if (_nz < 3)			// -- Hey!  This is 2D!
+    if (Geometry::nDim() < 3)		// -- Hey!  This is 2D!
       return value = E -> probe (r, s, _plane[0] + offset, ewrk);
   
     else {
@@ -1679,14 +1784,23 @@ real_t AuxField::probe (const Element* E,
     // -- We only hold the positive half of the spectrum, hence factor
     //   non-zero-mode data by 2.0.
 
-    Blas::scal (nZ - 2, 2.0, fbuf + 2, 1);
-    
-    value  = fbuf[0];		// -- NB: the Nyquist data are not used.
-    for (k = 1; k <= NHM; k++) {
-      Re     = k  + k;
-      Im     = Re + 1;
-      phase  = k * betaZ;
-      value += fbuf[Re] * cos (phase) - fbuf[Im] * sin (phase);
+    if (Geometry::symmetric()) {  // -- Cosine or sine series.
+      Blas::scal (nZ - 1, 2.0, fbuf + 1, 1);
+
+      value = (_odd) ? 0.0 : fbuf[0];
+      for (k = 1; k < nZ; k++)
+	if   (_odd) value -= fbuf[k] * sin (k * betaZ);
+	else        value += fbuf[k] * cos (k * betaZ);
+    } else {
+      Blas::scal (nZ - 2, 2.0, fbuf + 2, 1);
+
+      value  = fbuf[0];		// -- NB: the Nyquist data are not used.
+      for (k = 1; k <= NHM; k++) {
+	Re     = k  + k;
+	Im     = Re + 1;
+	phase  = k * betaZ;
+	value += fbuf[Re] * cos (phase) - fbuf[Im] * sin (phase);
+      }
     }
   } else
     value = 0.0;
@@ -1695,6 +1809,87 @@ real_t AuxField::probe (const Element* E,
 }
 
 
+void AuxField::probe (const vector<AuxField*>& u  ,
+		      const int_t              npt,
+		      const Element* const*    E  ,
+		      const real_t*            r  ,
+		      const real_t*            s  ,
+		      const real_t*            z  ,
+		      real_t*                  tgt)
+// --------------------------------------------------------------------------
+// (Static class member function.)  Batched version of the above:
+// return in tgt the physical-space values of each AuxField in u at
+// npt locations (E[i], r[i], s[i], z[i]).  Output is ordered field by
+// field, i.e. tgt[j*npt + i] is field j at point i.  Points with E[i]
+// = 0 return zero.
+//
+// As above, u must be Fourier transformed (3D).  The interpolation
+// weights for each point are computed once and applied to all local
+// planes of all fields with one matrix-vector product each.  Each
+// process sums the Fourier series over the modes it holds, then a
+// single collective sum gives the results, which are valid on all
+// processes.
+// --------------------------------------------------------------------------
+{
+  const int_t  nF    = u.size();
+  const int_t  nZ    = Geometry::nZ();
+  const int_t  nzp   = Geometry::nZProc();
+  const int_t  np    = Geometry::nP();
+  const int_t  npnp  = Geometry::nTotElmt();
+  const int_t  psize = Geometry::planeSize();
+  const int_t  base  = Geometry::basePlane();
+  const real_t beta  = Femlib::value ("BETA");
+
+  int_t   i, j, k, K, m, offset;
+  real_t  value;
+  Workspace::Vector work (npnp + 2 * np + nzp);
+  real_t* W    = &work[0];
+  real_t* ewrk = W    + npnp;
+  real_t* pbuf = ewrk + 2 * np;
+
+  Veclib::zero (nF * npt, tgt, 1);
+
+  for (i = 0; i < npt; i++) {
+    if (!E[i]) continue;
+
+    E[i] -> probeWeights (r[i], s[i], W, ewrk);
+    offset = E[i] -> ID() * npnp;
+
+    for (j = 0; j < nF; j++) {
+
+      if (Geometry::nDim() < 3) {		// -- 2D.
+	tgt[j*npt + i] = Blas::dot (npnp, W, 1, u[j] -> _plane[0] + offset, 1);
+	continue;
+      }
+
+      Blas::gemv ("T", npnp, nzp, 1.0, u[j] -> _plane[0] + offset, psize,
+		  W, 1, 0.0, pbuf, 1);
+
+      // -- Our share of the Fourier series.  NB: Nyquist data not used.
+
+      if (Geometry::symmetric())	// -- Cosine or sine series.
+	for (value = 0.0, k = 0; k < nzp; k++) {
+	  K = base + k;
+	  if      (K == 0)       { if (!u[j] -> _odd) value += pbuf[k]; }
+	  else if (u[j] -> _odd) value -= 2.0 * pbuf[k] * sin (K * beta * z[i]);
+	  else                   value += 2.0 * pbuf[k] * cos (K * beta * z[i]);
+	}
+      else
+	for (value = 0.0, k = 0; k < nzp; k++) {
+	  K = base + k;
+	  m = K >> 1;
+	  if      (m == 0) { if (K == 0) value += pbuf[k]; }
+	  else if (K & 1)  value -= 2.0 * pbuf[k] * sin (m * beta * z[i]);
+	  else             value += 2.0 * pbuf[k] * cos (m * beta * z[i]);
+	}
+      tgt[j*npt + i] = value;
+    }
+  }
+
+  if (Geometry::nProc() > 1) Message::sum (tgt, nF * npt);
+}
+
+
 void AuxField::lengthScale (real_t* tgt) const
 // --------------------------------------------------------------------------
 // Load tgt with data that represent the mesh resolution lengthscale
@@ -1727,7 +1922,7 @@ real_t AuxField::CFL (const int_t dir, int_t& el) const
   const int_t      npnp     = Geometry::nTotElmt();
   const int_t      nP       = Geometry::nPlane();
   const int_t      nZ       = Geometry::nZProc();
-  const real_t     dz       = Femlib::value ("TWOPI / BETA / N_Z");
+  const real_t     dz       = Geometry::dZ();
   const real_t     alpha    = 0.723;		  // -- Indicative max eigval.
   const real_t     c_lambda = 0.2;                // -- See reference.
   const int_t      P        = Geometry::nP() - 1; // -- Polynomial order.
@@ -2109,6 +2304,8 @@ void readField (istream&           file ,
       Veclib::alert (routine, "number of z planes mismatch", ERROR);
     if (hdr->nel != Geometry::nElmt())
       Veclib::alert (routine, "number of elements mismatch", ERROR);
+    if (hdr->sym != Geometry::symmetric())
+      Veclib::alert (routine, "z symmetry of file differs from run", WARNING);
   }
 
   // -- Walk through fields, read appropriate one.
@@ -2127,3 +2324,39 @@ void readField (istream&           file ,
     type++;
   }
 }
+
+
+bool seekDump (istream&    file ,
+	       const char* fname,
+	       const int_t dump )
+// ---------------------------------------------------------------------------
+// Position opened field file (named fname) at the start of dump
+// number "dump" (1-based), ready for readField.  Use the sidecar
+// index if there is a valid one, see femlib/fldindex.c, otherwise
+// skip over preceding (binary) dumps one header at a time.  Return
+// false if the requested dump could not be found.
+// ---------------------------------------------------------------------------
+{
+  const long offset = Femlib::dumpOffset (fname, dump);
+  int_t      i;
+
+  file.clear();
+
+  if (offset >= 0) {
+    file.seekg (offset, ios::beg);
+    return file.good();
+  }
+
+  file.seekg (0, ios::beg);
+
+  for (i = 1; i < dump; i++) {
+    Header hdr;
+    file >> hdr;
+    if (!file) return false;
+    file.seekg (static_cast<streamoff>
+		(hdr.nr * hdr.ns * hdr.nz * hdr.nel) *
+		hdr.nFields() * sizeof (real_t), ios::cur);
+  }
+
+  return file.good() && file.peek() != EOF;
+}
@@ -24,6 +24,12 @@ class AuxField
 /// and never evolve.  The planes always point to the same storage
 /// locations within the data area.
 ///
+/// With Geometry::symmetric(), each plane instead holds one real mode
+/// of a cosine (even in z) or sine (odd in z) series, and _odd records
+/// which.  Fields named 'w' start odd, all others even; the parity is
+/// carried through assignment and arithmetic, and swapped by gradient
+/// in z.  Plane 0 of an odd field (sine mode N_Z) is kept zero.
+///
 /// The data are transformed to physical space for storage in restart
 /// files.
 //  ==========================================================================
@@ -41,6 +47,7 @@ public:
   void          setName  (const char name) { _name = name; }
   void          describe (char*) const;
   const real_t* data     ()      const { return _data; }
+  bool          odd      ()      const { return _odd;  }
 
   AuxField& operator  = (const real_t);
   AuxField& operator += (const real_t);
@@ -113,6 +120,9 @@ public:
 
   real_t probe (const Element*, const real_t, const real_t, const int_t) const;
   real_t probe (const Element*, const real_t, const real_t, const real_t)const;
+  static void probe (const vector<AuxField*>&, const int_t,
+		     const Element* const*, const real_t*, const real_t*,
+		     const real_t*, real_t*);
 
   AuxField& reverse     ();
   AuxField& zeroNyquist ();
@@ -123,6 +133,7 @@ public:
 
   static void swapData  (AuxField*, AuxField*);
   static void couple    (AuxField*, AuxField*, const int_t);
+  static void transform (const int_t, AuxField**, const int_t);
   
   real_t* getData() const;
 
@@ -134,6 +145,7 @@ protected:
   int_t             _size ;	//!< _nz * Geometry::planeSize().
   real_t*           _data ;	//!< 2/3D data area, element x element x plane.
   real_t**          _plane;	//!< Pointer into data for each 2D frame.
+  bool              _odd  ;	//!< Sine (not cosine) series in z if symmetric.
 
 private:
 
@@ -143,5 +155,6 @@ private:
 void readField  (istream&, vector<AuxField*>&);
 void writeField (ostream&, const char*, const int_t, const real_t,
 		 vector<AuxField*>&);
+bool seekDump   (istream&, const char*, const int_t);
 
 #endif
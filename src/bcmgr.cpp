@@ -214,6 +214,8 @@
 
 #include <sem.h>
 
+static const int_t NLevel = 13;	// -- Number of multi-level storage arrays.
+
 
 BCmgr::BCmgr (FEML*             file,
 	      vector<Element*>& elmt) :
@@ -224,7 +226,8 @@ BCmgr::BCmgr (FEML*             file,
 // ---------------------------------------------------------------------------
   _axis   (false),
   _open   (false),
-  _toggle (false)     // -- Can only ever become true if _open is too.
+  _toggle (false),    // -- Can only ever become true if _open is too.
+  _member (0)
 {
   const char  routine[] = "BCmgr::BCmgr";
   char        buf[StrMax], err[StrMax], tag[StrMax], gat[StrMax];
@@ -281,6 +284,13 @@ BCmgr::BCmgr (FEML*             file,
     if (!strcmp (_descript[i], "axis")) _axis = true;
     if (!strcmp (_descript[i], "open")) _open = true;
   }
+
+  if (_open && Geometry::symmetric())
+    Veclib::alert (routine, "open BCs not available with SYMMETRY", ERROR);
+  if (_open && Femlib::ivalue ("DT_ADAPT") > 1)
+    Veclib::alert (routine, "open BCs not available with DT_ADAPT", ERROR);
+  if (_open && Femlib::ivalue ("OIFS") > 0)
+    Veclib::alert (routine, "open BCs not available with OIFS", ERROR);
   
   VERBOSE cout << "done" << endl;
 
@@ -712,6 +722,30 @@ int_t BCmgr::nMatching (const char* descript)
 ///////////////////////////////////////////////////////////////////////////////
 
 
+static real_t*** newLevels (const int_t nTime,
+			    const int_t nZ   ,
+			    const int_t nline)
+// ---------------------------------------------------------------------------
+// Allocate and zero multi-level storage for computed BCs.  The
+// structure is store[time_level][z_plane], which evaluates to a
+// real_t* that is a pointer to nline real_t storage locations (so
+// that store[i][0] is an equivalent pointer to Field->_line).
+// ---------------------------------------------------------------------------
+{
+  real_t*** store = new real_t** [static_cast<size_t>(nTime)];
+  int_t     i, j;
+
+  for (i = 0; i < nTime; i++) {
+    store[i]    = new real_t* [static_cast<size_t>(nZ)];
+    store[i][0] = new real_t  [static_cast<size_t>(nline * nZ)];
+    Veclib::zero (nline * nZ, store[i][0], 1);
+    for (j = 1; j < nZ; j++) store[i][j] = store[i][0] + j * nline;
+  }
+
+  return store;
+}
+
+
 void BCmgr::buildComputedBCs (const Field* master    ,
 			      const bool   haveScalar)
 // ---------------------------------------------------------------------------
@@ -722,7 +756,8 @@ void BCmgr::buildComputedBCs (const Field* master    ,
 // (and, potentially, variables) that will not have computed BCs.
 // ---------------------------------------------------------------------------
 {
-  int_t i, j;
+  real_t**** store[NLevel];
+  int_t      i;
 
   _scalar = haveScalar;
 
@@ -751,89 +786,191 @@ void BCmgr::buildComputedBCs (const Field* master    ,
   if (_scalar)
     _H   = new real_t [static_cast<size_t>(_nLine * _nZ)];  // Ref [5]
 
-  // -- The structure of each of the following arrays is
-  //    _xx[time_level][z_plane] which evaluates to a real_t* that is
-  //    a pointer to _nline real_t storage locations.  Thus _xx[0] is
-  //    an equivalent pointer to Field->_line.
+  // -- Multi-level storage (_u, _v, ..., see bcmgr.h) has the
+  //    structure _xx[time_level][z_plane], see newLevels.  Consult
+  //    references regarding the uses of the storage used for
+  //    computed BCs.
 
-  // -- Consult references regarding the uses of the following storage
-  //    used for computed BCs.
+  this -> levels (store);
+  for (i = 0; i < NLevel; i++) *store[i] = newLevels (_nTime, _nZ, _nLine);
+}
 
-  _u     = new real_t** [static_cast<size_t>(_nTime)]; // -- Velocity component.
-  _v     = new real_t** [static_cast<size_t>(_nTime)];
-  _w     = new real_t** [static_cast<size_t>(_nTime)];
-  _c     = new real_t** [static_cast<size_t>(_nTime)]; // -- Scalar.
 
-  _uhat  = new real_t** [static_cast<size_t>(_nTime)]; // -- in Fourier.
-  _vhat  = new real_t** [static_cast<size_t>(_nTime)];
-  _what  = new real_t** [static_cast<size_t>(_nTime)];
-  _chat  = new real_t** [static_cast<size_t>(_nTime)];
-  
-  _un    = new real_t** [static_cast<size_t>(_nTime)]; // -- u.n.
-  _divu  = new real_t** [static_cast<size_t>(_nTime)]; // -- div(u).
-  _gradu = new real_t** [static_cast<size_t>(_nTime)]; // -- n.grad(u).n.
-  _hopbc = new real_t** [static_cast<size_t>(_nTime)]; // -- grad(p).n.
-  _ndudt = new real_t** [static_cast<size_t>(_nTime)]; // -- (du/dt).n.
-  
-  for (i = 0; i < _nTime; i++) {
-    _u    [i] = new real_t* [static_cast<size_t>(_nZ)];
-    _v    [i] = new real_t* [static_cast<size_t>(_nZ)];
-    _w    [i] = new real_t* [static_cast<size_t>(_nZ)];
-    _c    [i] = new real_t* [static_cast<size_t>(_nZ)];    
-    _uhat [i] = new real_t* [static_cast<size_t>(_nZ)];
-    _vhat [i] = new real_t* [static_cast<size_t>(_nZ)];
-    _what [i] = new real_t* [static_cast<size_t>(_nZ)];
-    _chat [i] = new real_t* [static_cast<size_t>(_nZ)];
-    _un   [i] = new real_t* [static_cast<size_t>(_nZ)];
-    _divu [i] = new real_t* [static_cast<size_t>(_nZ)];
-    _gradu[i] = new real_t* [static_cast<size_t>(_nZ)];
-    _hopbc[i] = new real_t* [static_cast<size_t>(_nZ)];
-    _ndudt[i] = new real_t* [static_cast<size_t>(_nZ)];
-    
-    _u    [i][0] = new real_t [static_cast<size_t>(_nLine * _nZ)];
-    _v    [i][0] = new real_t [static_cast<size_t>(_nLine * _nZ)];
-    _w    [i][0] = new real_t [static_cast<size_t>(_nLine * _nZ)];
-    _c    [i][0] = new real_t [static_cast<size_t>(_nLine * _nZ)];    
-    _uhat [i][0] = new real_t [static_cast<size_t>(_nLine * _nZ)];
-    _vhat [i][0] = new real_t [static_cast<size_t>(_nLine * _nZ)];
-    _what [i][0] = new real_t [static_cast<size_t>(_nLine * _nZ)];
-    _chat [i][0] = new real_t [static_cast<size_t>(_nLine * _nZ)];
-    _un   [i][0] = new real_t [static_cast<size_t>(_nLine * _nZ)];
-    _divu [i][0] = new real_t [static_cast<size_t>(_nLine * _nZ)];
-    _gradu[i][0] = new real_t [static_cast<size_t>(_nLine * _nZ)];
-    _hopbc[i][0] = new real_t [static_cast<size_t>(_nLine * _nZ)];
-    _ndudt[i][0] = new real_t [static_cast<size_t>(_nLine * _nZ)];
-    
-    Veclib::zero (_nLine * _nZ, _u    [i][0], 1);
-    Veclib::zero (_nLine * _nZ, _v    [i][0], 1);
-    Veclib::zero (_nLine * _nZ, _w    [i][0], 1);
-    Veclib::zero (_nLine * _nZ, _c    [i][0], 1);    
-    Veclib::zero (_nLine * _nZ, _uhat [i][0], 1);
-    Veclib::zero (_nLine * _nZ, _vhat [i][0], 1);
-    Veclib::zero (_nLine * _nZ, _what [i][0], 1);
-    Veclib::zero (_nLine * _nZ, _chat [i][0], 1);
-    Veclib::zero (_nLine * _nZ, _un   [i][0], 1);
-    Veclib::zero (_nLine * _nZ, _divu [i][0], 1);
-    Veclib::zero (_nLine * _nZ, _gradu[i][0], 1);
-    Veclib::zero (_nLine * _nZ, _hopbc[i][0], 1);
-    Veclib::zero (_nLine * _nZ, _ndudt[i][0], 1);
-
-    for (j = 1; j < _nZ; j++) {
-      _u    [i][j] = _u    [i][0] + j * _nLine;
-      _v    [i][j] = _v    [i][0] + j * _nLine;
-      _w    [i][j] = _w    [i][0] + j * _nLine;
-      _c    [i][j] = _c    [i][0] + j * _nLine;      
-      _uhat [i][j] = _uhat [i][0] + j * _nLine;
-      _vhat [i][j] = _vhat [i][0] + j * _nLine;
-      _what [i][j] = _what [i][0] + j * _nLine;
-      _chat [i][j] = _chat [i][0] + j * _nLine;
-      _un   [i][j] = _un   [i][0] + j * _nLine;
-      _divu [i][j] = _divu [i][0] + j * _nLine;
-      _gradu[i][j] = _gradu[i][0] + j * _nLine;
-      _hopbc[i][j] = _hopbc[i][0] + j * _nLine;
-      _ndudt[i][j] = _ndudt[i][0] + j * _nLine;      
-    }
+void BCmgr::levels (real_t**** store[])
+// ---------------------------------------------------------------------------
+// Load store with the addresses of the NLevel multi-level storage
+// arrays used for computed BCs, see buildComputedBCs.
+// ---------------------------------------------------------------------------
+{
+  store[ 0] = &_u;     store[ 1] = &_v;     store[ 2] = &_w;
+  store[ 3] = &_c;     store[ 4] = &_uhat;  store[ 5] = &_vhat;
+  store[ 6] = &_what;  store[ 7] = &_chat;  store[ 8] = &_un;
+  store[ 9] = &_divu;  store[10] = &_gradu; store[11] = &_hopbc;
+  store[12] = &_ndudt;
+}
+
+
+void BCmgr::ensemble (const int_t nmem)
+// ---------------------------------------------------------------------------
+// Make separate multi-level storage for computed BCs for each of nmem
+// members of an ensemble that are integrated in lockstep (see
+// dns/drive.cpp), since it holds the velocity (etc.) history of a
+// particular flow.  The storage made by buildComputedBCs, which must
+// have been called already, goes to member 0, which is installed.
+// Thereafter, member selects the storage used.
+//
+// Open BCs keep further state, from one step to the next, and are
+// not available with ensembles.
+// ---------------------------------------------------------------------------
+{
+  const char routine[] = "BCmgr::ensemble";
+  real_t**** store[NLevel];
+  int_t      i, k;
+
+  if (_open) Veclib::alert (routine, "open BCs can't be used in ensembles",
+			    ERROR);
+
+  this -> levels (store);
+
+  _ensemble.resize (nmem * NLevel);
+  for (i = 0; i < NLevel; i++) _ensemble[i] = *store[i];
+  for (k = 1; k < nmem; k++)
+    for (i = 0; i < NLevel; i++)
+      _ensemble[k * NLevel + i] = newLevels (_nTime, _nZ, _nLine);
+
+  _member = 0;
+}
+
+
+void BCmgr::member (const int_t k)
+// ---------------------------------------------------------------------------
+// Install computed BC storage for member k of an ensemble, see ensemble.
+// ---------------------------------------------------------------------------
+{
+  real_t**** store[NLevel];
+  int_t      i;
+
+  this -> levels (store);
+
+  for (i = 0; i < NLevel; i++) {
+    _ensemble[_member * NLevel + i] = *store[i];
+    *store[i] = _ensemble[k * NLevel + i];
   }
+
+  _member = k;
+}
+
+
+static void putLevels (ostream&    strm ,
+		       real_t***   store,
+		       const int_t nTime,
+		       const int_t nline)
+// ---------------------------------------------------------------------------
+// Binary write of the nTime levels of one storage stack, each of
+// nline values on every local plane.  As for AuxField output, only
+// the root process writes, receiving data from the others in process
+// order.
+// ---------------------------------------------------------------------------
+{
+  const char  routine[] = "BCmgr::writeState";
+  const int_t nProc     = Geometry::nProc();
+  const int_t ntot      = nline * Geometry::nZProc();
+  int_t       i, k, n;
+
+  ROOTONLY {
+    vector<real_t> buffer (nline * Geometry::nZ());
+
+    for (i = 0; i < nTime; i++) {
+      strm.write (reinterpret_cast<char*>(store[i][0]),
+		  static_cast<int_t>(ntot * sizeof (real_t)));
+      for (k = 1; k < nProc; k++) {
+	n = nline * Geometry::nZProc (k);
+	Message::recv (&buffer[0], n, k);
+	strm.write (reinterpret_cast<char*>(&buffer[0]),
+		    static_cast<int_t>(n * sizeof (real_t)));
+      }
+    }
+    if (strm.bad())
+      Veclib::alert (routine, "unable to write binary output", ERROR);
+
+  } else for (i = 0; i < nTime; i++) Message::send (store[i][0], ntot, 0);
+}
+
+
+static void getLevels (istream&    strm ,
+		       real_t***   store,
+		       const int_t nTime,
+		       const int_t nline)
+// ---------------------------------------------------------------------------
+// Binary read of storage written by putLevels.
+// ---------------------------------------------------------------------------
+{
+  const char  routine[] = "BCmgr::readState";
+  const int_t nProc     = Geometry::nProc();
+  const int_t ntot      = nline * Geometry::nZProc();
+  int_t       i, k, n;
+
+  ROOTONLY {
+    vector<real_t> buffer (nline * Geometry::nZ());
+
+    for (i = 0; i < nTime; i++) {
+      strm.read (reinterpret_cast<char*>(store[i][0]),
+		 static_cast<int_t>(ntot * sizeof (real_t)));
+      for (k = 1; k < nProc; k++) {
+	n = nline * Geometry::nZProc (k);
+	strm.read (reinterpret_cast<char*>(&buffer[0]),
+		   static_cast<int_t>(n * sizeof (real_t)));
+	Message::send (&buffer[0], n, k);
+      }
+    }
+    if (strm.bad())
+      Veclib::alert (routine, "unable to read binary input", ERROR);
+
+  } else for (i = 0; i < nTime; i++) Message::recv (store[i][0], ntot, 0);
+}
+
+
+void BCmgr::writeState (ostream& strm)
+// ---------------------------------------------------------------------------
+// Write all the past-time storage used for computed BCs, level by
+// level in current (rolled) order, for an exact warm restart.  Only
+// valid after buildComputedBCs.
+// ---------------------------------------------------------------------------
+{
+  putLevels (strm, _u,     _nTime, _nLine);
+  putLevels (strm, _v,     _nTime, _nLine);
+  putLevels (strm, _w,     _nTime, _nLine);
+  putLevels (strm, _c,     _nTime, _nLine);
+  putLevels (strm, _uhat,  _nTime, _nLine);
+  putLevels (strm, _vhat,  _nTime, _nLine);
+  putLevels (strm, _what,  _nTime, _nLine);
+  putLevels (strm, _chat,  _nTime, _nLine);
+  putLevels (strm, _un,    _nTime, _nLine);
+  putLevels (strm, _divu,  _nTime, _nLine);
+  putLevels (strm, _gradu, _nTime, _nLine);
+  putLevels (strm, _hopbc, _nTime, _nLine);
+  putLevels (strm, _ndudt, _nTime, _nLine);
+}
+
+
+void BCmgr::readState (istream& strm)
+// ---------------------------------------------------------------------------
+// Inverse of writeState.
+// ---------------------------------------------------------------------------
+{
+  getLevels (strm, _u,     _nTime, _nLine);
+  getLevels (strm, _v,     _nTime, _nLine);
+  getLevels (strm, _w,     _nTime, _nLine);
+  getLevels (strm, _c,     _nTime, _nLine);
+  getLevels (strm, _uhat,  _nTime, _nLine);
+  getLevels (strm, _vhat,  _nTime, _nLine);
+  getLevels (strm, _what,  _nTime, _nLine);
+  getLevels (strm, _chat,  _nTime, _nLine);
+  getLevels (strm, _un,    _nTime, _nLine);
+  getLevels (strm, _divu,  _nTime, _nLine);
+  getLevels (strm, _gradu, _nTime, _nLine);
+  getLevels (strm, _hopbc, _nTime, _nLine);
+  getLevels (strm, _ndudt, _nTime, _nLine);
 }
 
 
@@ -918,6 +1055,8 @@ void BCmgr::maintainFourier (const int_t      step   ,
 // that since grad P is dotted with n, the unit outward normal, at a
 // later stage, timedep only needs to be set if there are wall-normal
 // accelerative terms.  NB: The default value of timedep is true.
+// With a variable time step, the estimate uses the sizes of the steps
+// that led to the last time level, as recorded by Integration.
 //
 // Field* master gives a list of edges with which to traverse storage
 // areas (note this assumes equal-order interpolations for all
@@ -944,7 +1083,7 @@ void BCmgr::maintainFourier (const int_t      step   ,
   const int_t              Je    = min (step - 1, _nTime);
 
   const real_t             nu    = Femlib::value ("KINVIS");
-  const real_t             invDt = 1.0 / Femlib::value ("D_T");
+  const real_t             invDt = 1.0 / Integration::step (1);
 
   const vector<Boundary*>& BC    = master -> _bsys -> getBCs (0);
 
@@ -968,7 +1107,7 @@ void BCmgr::maintainFourier (const int_t      step   ,
 
   real_t                   betaK;
 
-  if (Je) Integration::StifflyStable (Je, alpha);
+  if (Je) Integration::StifflyStable (Je, 1, alpha);
 
   // -- Roll up time-ordered internal storage stacks (except _un),
   //    initialise storage.
@@ -1002,7 +1141,7 @@ void BCmgr::maintainFourier (const int_t      step   ,
     j      = i * _nP;
 
     for (k = 0; k < _nZ; k++) {
-      ROOTONLY if (k == 1) continue;
+      ROOTONLY if (k == 1 && !Geometry::symmetric()) continue;
 
       // -- Store value of velocity components and scalar from last time level.
 
@@ -1056,7 +1195,13 @@ void BCmgr::maintainFourier (const int_t      step   ,
   // -- First, deal with HOPBC -\nu*curlCurl(u) terms.  Although this
   //    produces some redundant gradient operations, any later
   //    gradients will be element-edge-only, hence cheap.  And the
-  //    Edge:curlCurl() method is well tested.
+  //    Edge:curlCurl() method is well tested.  For a symmetric
+  //    representation, each mode of u, v is the real part of a
+  //    complex mode, and of w the imaginary part: the other parts are
+  //    supplied as zero.
+
+  Workspace::Vector Z (Geometry::symmetric() ? Geometry::planeSize() : 1);
+  if (Geometry::symmetric()) Veclib::zero (Geometry::planeSize(), &Z[0], 1);
 
   for (i = 0; i < _nEdge; i++) {
     B  = BC[i];
@@ -1072,6 +1217,21 @@ void BCmgr::maintainFourier (const int_t      step   ,
       Veclib::svvttvp(_nP,-nu,yr,1,B->ny(),1,_hopbc[0][0]+j,1,_hopbc[0][0]+j,1);
     }
 
+    if (Geometry::symmetric()) {    // -- Cosine (u, v) & sine (w) modes.
+      const real_t* zero = &Z[0];
+
+      for (m = mLo; m < nMode; m++) {
+	B -> curlCurl (m+base, Ux -> _plane[m], zero, Uy -> _plane[m], zero,
+		       zero, Uz -> _plane[m], xr, xi, yr, yi, wrk);
+
+	Veclib::svvttvp
+	  (_nP, -nu, xr,1, B->nx(),1, _hopbc[0][m]+j,1, _hopbc[0][m]+j,1);
+	Veclib::svvttvp
+	  (_nP, -nu, yr,1, B->ny(),1, _hopbc[0][m]+j,1, _hopbc[0][m]+j,1);
+      }
+      continue;
+    }
+
     for (m = mLo; m < nMode; m++) { // -- Higher modes.
       kr = 2 * m;
       ki = kr + 1;
@@ -1228,14 +1388,14 @@ void BCmgr::evaluateCNBCp (const int_t id   ,
 
   Veclib::zero (_nP, tgt, 1);
 
-  ROOTONLY if (plane == 1) return;    // -- Skip Nyquist.
+  ROOTONLY if (plane == 1 && !Geometry::symmetric()) return; // -- Nyquist.
 
   const int_t Je     = min (step, _nTime);
   const int_t offset = id * _nP;
   real_t*     beta   = _work;
   int_t       q;
 
-  Integration::Extrapolation (Je, beta);
+  Integration::Extrapolation (Je, 0, beta);
   
   for (q = 0; q < Je; q++) {
     Blas::axpy (_nP,  beta[q], _hopbc[q][plane] + offset, 1, tgt, 1);
@@ -1323,7 +1483,7 @@ void BCmgr::evaluateCMBCp (const Field* master, // Used for list of boundaries.
     const int_t nTot  = _nLine * _nZ;  
     const int_t nZtot = Geometry::nZ();
     const int_t nPR   = Geometry::nProc();
-    const int_t nLP   = _nLine / nPR;
+    const int_t nLP   = Geometry::nBlock (_nLine);
     
     Veclib::zero (nTot, _u2,    1);
     Veclib::zero (nTot, _Theta, 1);
@@ -45,6 +45,10 @@ public:
   //    because we need a Field to do it.  Right?
 
   void buildComputedBCs (const Field*, const bool = false);
+  void ensemble         (const int_t);
+  void member           (const int_t);
+  void writeState       (ostream&);
+  void readState        (istream&);
 
   void maintainFourier  (const int_t, const Field*, const AuxField**,
 			 const AuxField**, const int_t, const int_t,
@@ -71,6 +75,7 @@ private:
 
   void buildnum  (const char*, vector<Element*>&);
   void buildsurf (FEML*, vector<Element*>&);
+  void levels    (real_t****[]);
 
   // -- Storage of past-time values needed for computed BCs:
 
@@ -106,6 +111,9 @@ private:
 
   bool      _toggle;    // Toggle switch for Fourier transform of KE.
   bool      _scalar;	// Problem has a scalar as well as velocity.  
+
+  vector<real_t***> _ensemble; // Storage above for each ensemble member,
+  int_t             _member;   //   and the member currently installed.
 };
 
 #endif
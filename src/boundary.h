@@ -15,6 +15,8 @@ public:
 
   int_t ID        () const { return _id; }
   void  print     () const;
+  bool  timeDependent () const { return _bcond -> timeDependent(); }
+  const vector<string>* tokens () const { return _bcond -> tokens(); }
 
   void  evaluate  (const Field*,const int_t,const int_t,const bool,
 		   real_t*)                                              const;
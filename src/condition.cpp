@@ -79,6 +79,46 @@
 ///////////////////////////////////////////////////////////////////////////////
 
 #include <sem.h>
+#include <algorithm>
+
+
+static bool unsteady (const char*     f     ,
+		      vector<string>& tokens)
+// ---------------------------------------------------------------------------
+// Scan function string f as the parser's lexer does and return true
+// if it names t or STEP, which change every timestep, or white, which
+// returns new (random) values each time it is evaluated.  Functions
+// that do not are evaluated, and Fourier transformed, once only.
+//
+// The names of any other tokens that f refers to (i.e. not x, y, z,
+// nor function names) are returned in tokens, since they may be reset
+// during a run (e.g. D_T with DT_ADAPT), see Field::updateBoundaries.
+// ---------------------------------------------------------------------------
+{
+  const char* c = f;
+  char*       e;
+  string      name;
+  bool        vary = false;
+
+  tokens.clear();
+
+  while (*c)
+    if (*c == '.' || isdigit (*c)) {
+      strtod (c, &e);
+      c = (e > c) ? e : c + 1;
+    } else if (isalpha (*c)) {
+      for (name.clear(); isalnum (*c) || *c == '_'; c++) name += *c;
+      if (name == "t" || name == "STEP" || name == "white") vary = true;
+      else if (name != "x" && name != "y" && name != "z") {
+	for (e = const_cast<char*>(c); isspace (*e); e++);
+	if (*e != '(' && find (tokens.begin(), tokens.end(), name) ==
+	    tokens.end()) tokens.push_back (name);
+      }
+    } else
+      c++;
+
+  return vary;
+}
 
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -310,6 +350,7 @@ EssentialFunction::EssentialFunction (const char* f)
 // ---------------------------------------------------------------------------  
 {
   strcpy ((_function = new char [strlen (f) + 1]), f);
+  _unsteady    = unsteady (_function, _tokens);
   _descriptor  = "essential-function:\t";
   _descriptor += _function;
 }
@@ -371,6 +412,7 @@ NaturalFunction::NaturalFunction (const char* f)
 // ---------------------------------------------------------------------------
 {
   strcpy ((_function = new char [strlen (f) + 1]), f);
+  _unsteady    = unsteady (_function, _tokens);
   _descriptor  = "natural-function:\t";
   _descriptor += _function;
 }  
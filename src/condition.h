@@ -34,7 +34,8 @@ class Condition
 // physical-space description of the BC, and is now set once at
 // run-time (cannot be reset).  This is not true for those obtained by
 // parsing a function, which are re-parsed every timestep (again, in
-// physical space).
+// physical space) if the function depends on time, see timeDependent,
+// or if any other token it uses has been reset, see tokens.
 //
 // All terminal condition classes must provide an "evaluate" method:
 // this is used to install values in Field class BC storage area.  For
@@ -72,6 +73,9 @@ public:
   
   virtual ~Condition() = default;
 
+  virtual bool timeDependent () const { return false; }
+  virtual const vector<string>* tokens () const { return 0; }
+
   void describe  (char* tgt) const { sprintf (tgt, _descriptor.c_str ()); }
 
 protected:
@@ -199,8 +203,12 @@ public:
   void evaluate     (const Field*, const int_t, const int_t,
 		     const Element*, const int_t, const int_t,
 		     const bool, real_t*)                         const final;
+  bool timeDependent () const final { return _unsteady; }
+  const vector<string>* tokens () const final { return &_tokens; }
 private:
-  char* _function;
+  char*          _function;
+  bool           _unsteady;
+  vector<string> _tokens;
 };
 
 
@@ -240,8 +248,12 @@ public:
   void evaluate   (const Field*, const int_t, const int_t,
 		   const Element*, const int_t, const int_t,
 		   const bool, real_t*)                          const final;
+  bool timeDependent () const final { return _unsteady; }
+  const vector<string>* tokens () const final { return &_tokens; }
 private:
-  char* _function;
+  char*          _function;
+  bool           _unsteady;
+  vector<string> _tokens;
 };
 
 
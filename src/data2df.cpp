@@ -13,12 +13,14 @@
 Data2DF::Data2DF (const int_t nP  ,
 		  const int_t nZ  ,
 		  const int_t nEl ,
-		  const char  Name) :
+		  const char  Name,
+		  const bool  Sym ) :
   _name (Name),
   _np   (nP  ),
   _nz   (nZ  ),
   _nel  (nEl ),
-  _np2  (nP * nP)
+  _np2  (nP * nP),
+  _sym  (Sym )
 // ---------------------------------------------------------------------------
 // Data2DF constructor. Storage area set to zero.
 // ---------------------------------------------------------------------------
@@ -39,10 +41,15 @@ Data2DF::Data2DF (const int_t nP  ,
 
 Data2DF& Data2DF::DFT1D (const int_t sign)
 // ---------------------------------------------------------------------------
-// Carry out discrete Fourier transformation in z direction.
+// Carry out discrete Fourier transformation in z direction.  For
+// symmetric data this is a sine transform for 'w', else a cosine one.
 // ---------------------------------------------------------------------------
 {
-  if (_nz > 2) Femlib::DFTr (_data, _nz, _nplane, sign);
+  if (_sym) {
+    if (_nz < 2)          return *this;
+    else if (_name == 'w') Femlib::DSTr (_data, _nz, _nplane, sign);
+    else                   Femlib::DCTr (_data, _nz, _nplane, sign);
+  } else if (_nz > 2)      Femlib::DFTr (_data, _nz, _nplane, sign);
 
   return *this;
 }
@@ -82,11 +89,19 @@ Data2DF& Data2DF::F_conjugate (const bool zero)
 // Take complex conjugate in the Fourier coordinate direction. If zero
 // is true, assume that mode zero is complex instead of two real_t
 // modes packed together.
+//
+// For symmetric data this leaves the cosine series unchanged and
+// negates the sine series ('w'), i.e. it is the reflection z -> -z.
 // ---------------------------------------------------------------------------
 {
   int_t       i;
   const int_t first = (zero) ? 1 : 3;
 
+  if (_sym) {
+    if (_name == 'w') Veclib::neg (_ntot, _data, 1);
+    return *this;
+  }
+
   if (_nz > 1)
     for (i = first; i < _nz; i += 2)
       Veclib::neg (_nplane, _plane[i], 1);
@@ -107,11 +122,13 @@ Data2DF& Data2DF::F_symmetrize (const bool zero)
 // 'p': mode_k.Im = 0, k > 0
 //
 // If zero is true, assume that mode zero is complex instead of two
-// real modes packed together.
+// real modes packed together.  Symmetric data already satisfy this.
 // ---------------------------------------------------------------------------
 {
   int_t i, first;
 
+  if (_sym) return *this;
+
   switch (_name) {
   case 'u': case 'v': case 'p': first = (zero) ? 1 : 3; break;
   case 'w':                     first = (zero) ? 0 : 2; break;
@@ -132,9 +149,14 @@ Data2DF& Data2DF::F_shift (const real_t alpha,
 // Use the shift-rotation duality of the Fourier transform to shift
 // the data a proportion alpha of the fundamental length in the
 // Fourier coordinate direction.  Data are assumed to be in
-// Fourier-transformed state on input.
+// Fourier-transformed state on input.  A shift does not preserve
+// reflection symmetry, so symmetric data are rejected.
 // ---------------------------------------------------------------------------
 {
+  if (_sym)
+    Veclib::alert ("Data2DF::F_shift",
+		   "can't shift symmetric (cosine/sine) data", ERROR);
+
   const int_t    N = _nz >> 1;
   const int_t    first = (zero) ? 0 : 1;
   int_t i;
@@ -173,7 +195,7 @@ Data2DF& Data2DF::operator = (const Data2DF& rhs)
 // (c) if the projection is to the same number of modes - copy it in place.
 // ---------------------------------------------------------------------------
 {
-  if (rhs._nel != _nel)
+  if (rhs._nel != _nel || rhs._sym != _sym)
     Veclib::alert ("Data2DF::operator =", "fields can't conform", ERROR);
 
   if (rhs._np == _np && rhs._nz == _nz)
@@ -204,7 +226,11 @@ Data2DF& Data2DF::operator = (const Data2DF& rhs)
 	}
     }
 
-    if ((i = _nz - rhs._nz) > 0) {
+    if (_sym) {
+      // -- Plane k holds mode k: no Nyquist data, just zero pad.
+      if ((i = _nz - rhs._nz) > 0)
+	Veclib::zero (i * _nplane, _data + rhs._ntot, 1);
+    } else if ((i = _nz - rhs._nz) > 0) {
       // -- The new area has more Fourier modes than the old one.
       // -- Zero pad for Fourier projections.
       Veclib::zero (i * _nplane, _data + rhs._ntot, 1);
@@ -340,17 +366,22 @@ Data2DF& Data2DF::filter1D (const real_t roll ,
 // filter.
 //
 // It is assumed that the data are already Fourier transformed on input.
+// Symmetric data have mode k in plane k, with N_Z modes in all.
 // ---------------------------------------------------------------------------
 {
   int_t          i;
-  const int_t    nh = _nz >> 1, ord = max (2, order);
+  const int_t    nh = (_sym) ? _nz : _nz >> 1, ord = max (2, order);
   vector<real_t> filter (nh + 1), mask (_nz);
   const real_t   lag = clamp (roll, 0.0, 1.0);
 
   Femlib::erfcFilter (nh, ord, lag * nh, 1.0, &filter[0]);
-  mask[0] = filter[ 0];
-  mask[1] = filter[nh];
-  for (i = 1; i < nh; i++) mask[2*i] = mask[2*i+1] = filter[i];
+  if (_sym)
+    for (i = 0; i < _nz; i++) mask[i] = filter[i];
+  else {
+    mask[0] = filter[ 0];
+    mask[1] = filter[nh];
+    for (i = 1; i < nh; i++) mask[2*i] = mask[2*i+1] = filter[i];
+  }
 
   for (i = 0; i < _nz; i++)
     Veclib::smul  (_nplane, mask[i], _plane[i], 1, _plane[i], 1);
@@ -443,6 +474,7 @@ Header::Header ()
   sess[0] = sesd[0] = flds[0] = '\0';
   sprintf (frmt, "binary "); Veclib::describeFormat (frmt + strlen (frmt));
   nr = ns = nz = nel = step = 0;
+  sym  = false;
   time = dt = visc = beta = 0.0;
 }
 
@@ -459,6 +491,7 @@ istream& operator >> (istream& file,
   if (file.get(hdr.sess, 25).eof()) return file; file.getline(s, StrMax);
   file.get(hdr.sesd, 25);                        file.getline(s, StrMax);
   file >> hdr.nr >> hdr.ns >> hdr.nz >> hdr.nel; file.getline(s, StrMax);
+  hdr.sym = strstr (s, "sym") != 0;
   file >> hdr.step;                              file.getline(s, StrMax);
   file >> hdr.time;                              file.getline(s, StrMax);
   file >> hdr.dt;                                file.getline(s, StrMax);
@@ -485,7 +518,7 @@ ostream& operator << (ostream& file,
   const char *hdr_fmt[] = { 
     "%-25s "                  "Session\n",
     "%-25s "                  "Created\n",
-    "%-5d %-5d %-5d %-5d   "  "Nr, Ns, Nz, Elements\n",
+    "%-25s "                  "Nr, Ns, Nz, Elements\n",
     "%-25d "                  "Step\n",
     "%-25.6g "                "Time\n",
     "%-25.6g "                "Time step\n",
@@ -502,7 +535,9 @@ ostream& operator << (ostream& file,
 
   sprintf  (s1, hdr_fmt[0], hdr.sess);                        file << s1;
   sprintf  (s1, hdr_fmt[1], s2);                              file << s1;
-  sprintf  (s1, hdr_fmt[2], hdr.nr, hdr.ns, hdr.nz, hdr.nel); file << s1;
+  sprintf  (s2, "%1d %1d %1d %1d%s",
+	    hdr.nr, hdr.ns, hdr.nz, hdr.nel, (hdr.sym) ? " sym" : "");
+  sprintf  (s1, hdr_fmt[2], s2);                              file << s1;
   sprintf  (s1, hdr_fmt[3], hdr.step);                        file << s1;
   sprintf  (s1, hdr_fmt[4], Femlib::value ("t"));             file << s1;
   sprintf  (s1, hdr_fmt[5], Femlib::value ("D_T"));           file << s1;
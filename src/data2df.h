@@ -12,6 +12,10 @@ class Data2DF
 // ============================================================================
 // Canonical field class, each np X np element is defined on [-1,1] X [-1, 1].
 // Data are arranged element-ordered in 2D planes to create a 3D scalar field.
+//
+// If Sym is true, plane k holds real mode k of a cosine series or, for
+// field 'w', a sine series (the SYMMETRY representation, see Geometry),
+// rather than half of a complex mode.
 // ============================================================================
 {
 friend istream& operator >> (istream&, Data2DF&);
@@ -19,7 +23,7 @@ friend ostream& operator << (ostream&, Data2DF&);
 
 public:
   Data2DF  (const int_t nP, const int_t nZ, const int_t nEl,
-	    const char Name='\0');
+	    const char Name='\0', const bool Sym=false);
   ~Data2DF () { delete [] _data; delete [] _plane; }
 
   char getName () { return _name; }
@@ -49,6 +53,7 @@ protected:
 #endif
   const char  _name;
   const int_t _np, _nz, _nel, _np2;
+  const bool  _sym;
   int_t       _nplane, _ntot;
   real_t*     _data;
   real_t**    _plane;
@@ -74,6 +79,7 @@ public:
   int_t  ns  ;
   int_t  nz  ;
   int_t  nel ;
+  bool   sym ;		// -- Planes hold cosine/sine (symmetric) data.
   int_t  step;
   real_t time;
   real_t dt  ;
@@ -149,7 +149,7 @@ Domain::Domain (FEML*             file   ,
   u   .resize (nfield);
   udat.resize (nfield);
 
-  alloc = new real_t [static_cast<size_t> (nfield * ntot)];
+  alloc = Storage::allocate (nfield * ntot, nfield * nz);
   for (i = 0; i < nfield; i++) {
     udat[i] = alloc + i * ntot;
     u[i]    = new Field (udat[i], b[i], n[i], nz, elmt, field[i]);
@@ -159,6 +159,47 @@ Domain::Domain (FEML*             file   ,
 }
 
 
+Domain::Domain (const Domain* D   ,
+		const char*   tag ) :
+// ---------------------------------------------------------------------------
+// Construct a new Domain named tag, with the same Fields as D, for a
+// member of an ensemble (see dns/drive.cpp).  Elements, boundary and
+// numbering systems and assembly maps are shared with D, but the new
+// Domain has its own Field storage (including boundary values),
+// initialised to zero at time zero.
+// ---------------------------------------------------------------------------
+  elmt         (D -> elmt),
+  b            (D -> b),
+  n            (D -> n),
+  VARKINVIS    (D -> VARKINVIS),
+  varkinvisdat (D -> varkinvisdat),
+  _nglobal     (D -> _nglobal),
+  _bmapNaive   (D -> _bmapNaive),
+  _imassNaive  (D -> _imassNaive),
+  _allMappings (D -> _allMappings)
+{
+  const int_t nz     = Geometry::nZProc();
+  const int_t ntot   = Geometry::nTotProc();
+  const int_t nfield = D -> nField();
+  int_t       i;
+  real_t*     alloc;
+
+  strcpy ((name  = new char [strlen (tag) + 1]), tag);
+  strcpy ((field = new char [strlen (D -> field) + 1]), D -> field);
+  Femlib::value ("t", time = 0.0);
+  step = 0;
+
+  u   .resize (nfield);
+  udat.resize (nfield);
+
+  alloc = Storage::allocate (nfield * ntot, nfield * nz);
+  for (i = 0; i < nfield; i++) {
+    udat[i] = alloc + i * ntot;
+    u[i]    = new Field (udat[i], b[i], n[i], nz, elmt, field[i]);
+  }
+}
+
+
 void Domain::checkVBCs (FEML*       file ,
 			const char* field) const
 // ---------------------------------------------------------------------------
@@ -460,10 +501,12 @@ void Domain::report ()
 }
 
 
-void Domain::restart ()
+void Domain::restart (const char* common)
 // ---------------------------------------------------------------------------
 // Initialise all Field variables to zero ICs.  Then if a restart file
 // "name".rst can be found, use it for input of the data it contains.
+// Failing that, if given, try "common".rst (e.g. the session's own
+// restart file, for members of an ensemble).
 //
 // Carry out forwards Fourier transformation, zero Nyquist data.
 // ---------------------------------------------------------------------------
@@ -477,6 +520,11 @@ void Domain::restart ()
   ROOTONLY cout << "-- Initial condition       : ";
   ifstream file (strcat (strcpy (restartfile, name), ".rst"));
 
+  if (!file && common) {
+    file.clear();
+    file.open (strcat (strcpy (restartfile, common), ".rst"));
+  }
+
   if (file) {
     ROOTONLY {
       cout << "read from file " << restartfile;
@@ -502,6 +550,10 @@ void Domain::dump ()
 //
 // Fields are inverse Fourier transformed prior to dumping in order to
 // provide physical space values.
+//
+// Each dump written to the (non-checkpoint) field file is also
+// recorded in the sidecar index file "name".fld.idx, which gives
+// utilities random access to the dumps, see femlib/fldindex.c.
 // ---------------------------------------------------------------------------
 {
   const bool periodic = !(step %  Femlib::ivalue ("IO_FLD"));
@@ -510,12 +562,14 @@ void Domain::dump ()
 
   if (!(periodic || final)) return;
   ofstream output;
+  char     dumpfl[StrMax];
+  long     offset = -1;
 
   Message::sync();
 
   ROOTONLY {
     const char  routine[] = "Domain::dump";
-    char        dumpfl[StrMax], backup[StrMax], command[StrMax];
+    char        backup[StrMax], command[StrMax];
     const int_t verbose   = Femlib::ivalue ("VERBOSE");
     const int_t chkpoint  = Femlib::ivalue ("CHKPOINT");
 
@@ -539,6 +593,11 @@ void Domain::dump ()
     
     if (!output) Veclib::alert (routine, "can't open dump file", ERROR);
     if (verbose) Veclib::alert (routine, ": writing field dump", REMARK);
+
+    if (strstr (dumpfl, ".fld")) {
+      output.seekp (0, ios::end);
+      offset = output.tellp();
+    }
   }
 
   Message::sync();
@@ -551,7 +610,10 @@ void Domain::dump ()
   this -> transform (FORWARD);
   Message::sync();
 
-  ROOTONLY output.close();
+  ROOTONLY {
+    output.close();
+    if (offset >= 0) Femlib::indexDump (dumpfl, offset, step, time, field);
+  }
 }
 
 
@@ -628,6 +690,8 @@ istream& operator >> (istream& strm,
     Veclib::alert (routine, "number of z planes mismatch", ERROR);
   if (nel != nelchk)
     Veclib::alert (routine, "number of elements mismatch", ERROR);
+  if ((strstr (s, "sym") != 0) != Geometry::symmetric()) ROOTONLY
+    Veclib::alert (routine, "z symmetry of file differs from run", WARNING);
   
   ntot = np * np * nz * nel;
   if (ntot != Geometry::nTot())
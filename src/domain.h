@@ -19,6 +19,7 @@ friend istream& operator >> (istream&, Domain&);
 friend ostream& operator << (ostream&, Domain&);
 public:
   Domain (FEML*, const Mesh*, vector<Element*>&, BCmgr*);
+  Domain (const Domain*, const char*);
 
   char*                name;  // Session name.
   char*                field; // List of lower-case character field names.
@@ -37,7 +38,7 @@ public:
 
   bool  hasScalar  () const { return strchr (field, 'c'); }
   void  report     ();
-  void  restart    ();
+  void  restart    (const char* = 0);
   void  dump       ();
   void  transform  (const int_t);
   
@@ -51,6 +51,7 @@ Element::Element (const int_t id,
   _Q3    = new real_t [static_cast<size_t> (_npnp)];
   _Q4    = new real_t [static_cast<size_t> (_npnp)];
   _Q8    = new real_t [static_cast<size_t> (_npnp)];
+  _WW    = new real_t [static_cast<size_t> (_npnp)];
   _delta = new real_t [static_cast<size_t> (_npnp)];
   
   M -> meshElmt (_id, _np, _zr, _zs, _xmesh, _ymesh);
@@ -68,6 +69,7 @@ Element::Element (const int_t id,
   Family::adopt (_npnp, &_Q3   );
   Family::adopt (_npnp, &_Q4   );
   Family::adopt (_npnp, &_Q8   );
+  Family::adopt (_npnp, &_WW   );
   Family::adopt (_npnp, &_delta);
 
 #if defined (DAMPING)
@@ -103,6 +105,7 @@ Element::~Element ()
   Family::abandon (&_Q3   );
   Family::abandon (&_Q4   );
   Family::abandon (&_Q8   );
+  Family::abandon (&_WW   );
 }
 
 
@@ -546,6 +549,12 @@ void Element::grad (real_t* tgtX,
   real_t* tmpB = tmpA + _npnp;
   real_t* tgt;
 
+  if (_affine) {
+    if (tgtX) this -> gradAffine (_rx, _sx, tgtX, tmpA, tmpB);
+    if (tgtY) this -> gradAffine (_ry, _sy, tgtY, tmpA, tmpB);
+    return;
+  }
+
   if ((tgt = tgtX)) {
     if (_drdx && _dsdx) {
       Blas::mxm     (tgt, _np, _DTr, _np, tmpA, _np);
@@ -578,6 +587,31 @@ void Element::grad (real_t* tgtX,
 }
 
 
+void Element::gradAffine (const real_t ar  ,
+			  const real_t as  ,
+			  real_t*      tgt ,
+			  real_t*      tmpA,
+			  real_t*      tmpB) const
+// --------------------------------------------------------------------------
+// Gradient for affine elements: tgt = ar * d(tgt)/dr + as * d(tgt)/ds,
+// where the (constant) inverse partials ar, as cannot both be zero.
+//  --------------------------------------------------------------------------
+{
+  if (ar && as) {
+    Blas::mxm     (tgt, _np, _DTr, _np, tmpA, _np);
+    Blas::mxm     (_DVs, _np, tgt, _np, tmpB, _np);
+    Veclib::smul  (_npnp, ar, tmpA, 1, tgt, 1);
+    Blas::axpy    (_npnp, as, tmpB, 1, tgt, 1);
+  } else if (ar) {
+    Blas::mxm     (tgt, _np, _DTr, _np, tmpA, _np);
+    Veclib::smul  (_npnp, ar, tmpA, 1, tgt, 1);
+  } else {
+    Blas::mxm     (_DVs, _np, tgt, _np, tmpB, _np);
+    Veclib::smul  (_npnp, as, tmpB, 1, tgt, 1);
+  }
+}
+
+
 void Element::gradX (const real_t* xr,
 		     const real_t* xs,
 		     real_t*       dx) const
@@ -585,7 +619,13 @@ void Element::gradX (const real_t* xr,
 // Partial implementation of x-gradient, for use with Femlib::grad2.
 //  --------------------------------------------------------------------------
 {
-  if (_drdx && _dsdx) Veclib::vvtvvtp (_npnp, xr,1,_drdx,1,xs,1,_dsdx,1,dx,1);
+  if (_affine) {
+    if      (_rx && _sx) { Veclib::smul (_npnp, _rx, xr, 1, dx, 1);
+			   Blas::axpy   (_npnp, _sx, xs, 1, dx, 1); }
+    else if (_rx)          Veclib::smul (_npnp, _rx, xr, 1, dx, 1);
+    else                   Veclib::smul (_npnp, _sx, xs, 1, dx, 1);
+  }
+  else if (_drdx && _dsdx) Veclib::vvtvvtp (_npnp, xr,1,_drdx,1,xs,1,_dsdx,1,dx,1);
   else if (_drdx)     Veclib::vmul    (_npnp, xr,1,_drdx,1,dx,1);
   else                Veclib::vmul    (_npnp, xs,1,_dsdx,1,dx,1);
 }
@@ -598,7 +638,13 @@ void Element::gradY (const real_t* yr,
 // Partial implementation of y-gradient, for use with Femlib::grad2.
 //  --------------------------------------------------------------------------
 {
-  if (_drdy && _dsdy) Veclib::vvtvvtp (_npnp, yr,1,_drdy,1,ys,1,_dsdy,1,dy,1);
+  if (_affine) {
+    if      (_ry && _sy) { Veclib::smul (_npnp, _ry, yr, 1, dy, 1);
+			   Blas::axpy   (_npnp, _sy, ys, 1, dy, 1); }
+    else if (_ry)          Veclib::smul (_npnp, _ry, yr, 1, dy, 1);
+    else                   Veclib::smul (_npnp, _sy, ys, 1, dy, 1);
+  }
+  else if (_drdy && _dsdy) Veclib::vvtvvtp (_npnp, yr,1,_drdy,1,ys,1,_dsdy,1,dy,1);
   else if (_drdy)     Veclib::vmul    (_npnp, yr,1,_drdy,1,dy,1);
   else                Veclib::vmul    (_npnp, ys,1,_dsdy,1,dy,1);
 }
@@ -683,6 +729,18 @@ void Element::sideGrad (const int_t   side,
 
   // -- dc/dx = dc/dr * dr/dx + dc/ds * ds/dx.
 
+  if (_affine) {
+    if (c1) {
+      Veclib::smul  (_np, _rx, ddr, d, c1, 1);
+      Veclib::svtvp (_np, _sx, dds, d, c1, 1, c1, 1);
+    }
+    if (c2) {
+      Veclib::smul  (_np, _ry, ddr, d, c2, 1);
+      Veclib::svtvp (_np, _sy, dds, d, c2, 1, c2, 1);
+    }
+    return;
+  }
+
   if (c1) {
     if   (_drdx) Veclib::vmul  (_np, ddr, d, _drdx+estart, skip, c1, 1);
     else         Veclib::zero  (_np, c1, 1);
@@ -1196,6 +1254,22 @@ bool Element::locate (const real_t x    ,
 }
 
 
+void Element::extent (real_t& xmin,
+		      real_t& xmax,
+		      real_t& ymin,
+		      real_t& ymax) const
+// --------------------------------------------------------------------------
+// Return the bounding box of the element's nodal mesh.  NB: a curved
+// side may bulge a little beyond this between nodes.
+//  --------------------------------------------------------------------------
+{
+  xmin = _xmesh[Veclib::imin (_npnp, _xmesh, 1)];
+  xmax = _xmesh[Veclib::imax (_npnp, _xmesh, 1)];
+  ymin = _ymesh[Veclib::imin (_npnp, _ymesh, 1)];
+  ymax = _ymesh[Veclib::imax (_npnp, _ymesh, 1)];
+}
+
+
 real_t Element::probe (const real_t  r   ,
 		       const real_t  s   ,
 		       const real_t* src ,
@@ -1218,6 +1292,30 @@ real_t Element::probe (const real_t  r   ,
 }
 
 
+void Element::probeWeights (const real_t r   ,
+			    const real_t s   ,
+			    real_t*      tgt ,
+			    real_t*      work) const
+// --------------------------------------------------------------------------
+// Load tgt (_npnp long) with the weights which, applied by inner
+// product with field storage for this element, give the value at r, s.
+// This allows the same location to be probed on many planes or fields
+// at the cost of one dot product each.
+//
+// Input vector work should be 2*_np long.
+//  --------------------------------------------------------------------------
+{
+  real_t* ir = work;
+  real_t* is = ir + _np;
+  int_t   i;
+
+  Femlib::interpolation (ir,is,0,0,_np,GLJ,JAC_ALFA,JAC_BETA,
+			           _np,GLJ,JAC_ALFA,JAC_BETA,r,s);
+
+  for (i = 0; i < _np; i++) Veclib::smul (_np, is[i], ir, 1, tgt + i*_np, 1);
+}
+
+
 real_t Element::CFL (const real_t* u   ,
 		     const real_t* v   ,
 		     real_t*       work) const
@@ -1246,6 +1344,14 @@ real_t Element::CFL (const real_t* u   ,
   const int_t loopcnt = _npnp;
   int_t       i;
 
+  if (_affine) {
+    if      (u) Veclib::smul (loopcnt, fabs (_rx) + fabs (_sx), u, 1, work, 1);
+    else if (v) Veclib::smul (loopcnt, fabs (_ry) + fabs (_sy), v, 1, work, 1);
+    else        Veclib::zero (loopcnt, work, 1);
+    i = Blas::iamax (loopcnt, work, 1);
+    return fabs (work[i]);
+  }
+
   Veclib::zero (loopcnt, work, 1);
 
   if        (u) {
@@ -1261,6 +1367,27 @@ real_t Element::CFL (const real_t* u   ,
 }
 
 
+static bool constant (const int_t   n    ,
+		      const real_t* v    ,
+		      const real_t  scale,
+		      real_t&       mean )
+// --------------------------------------------------------------------------
+// Return true if the entries of v agree to within roundoff relative to
+// scale, with their mean value in mean.
+//  --------------------------------------------------------------------------
+{
+  const real_t TOL = 1000.0 * EPSDP * scale;
+  int_t        i;
+
+  mean = Veclib::sum (n, v, 1) / n;
+
+  for (i = 0; i < n; i++)
+    if (fabs (v[i] - mean) > TOL) return false;
+
+  return true;
+}
+
+
 void Element::mapping ()
 // --------------------------------------------------------------------------
 // Generate geometric factors associated with mapping from 2D Cartesian to
@@ -1311,22 +1438,28 @@ void Element::mapping ()
 // applies to Q3).  In these cases the associated memory is deleted
 // and the pointers are set to zero, so they can serve as flags in
 // subsequent computations.
+//
+// If the forward partials are constant to within roundoff (the
+// element is a parallelogram) the element is classified as affine.
+// The geometric factors are then rebuilt from exact constants, which
+// are retained as scalars (_rx .. _sy, _g1 .. _g4).  The per-point
+// partials of affine elements, and Q1..Q3 of Cartesian affine
+// elements, are then deleted: kernels use the scalars instead.
 //  --------------------------------------------------------------------------
 {
   const char     routine[] = "Element::mapping";
   const real_t   EPS  = 4 * EPSDP;
   const real_t   *x = _xmesh, *y = _ymesh;
   char           err[StrMax];
-  real_t         *jac, *dxdr, *dxds, *dydr, *dyds, *tV, *WW;
-  vector<real_t> work (7 * _npnp);
+  real_t         *jac, *dxdr, *dxds, *dydr, *dyds, *tV, *WW = _WW;
+  vector<real_t> work (6 * _npnp);
 
   dxdr = &work[0];
   dxds = dxdr + _npnp;
   dydr = dxds + _npnp;
   dyds = dydr + _npnp;
   jac  = dyds + _npnp;
-  WW   = jac  + _npnp;
-  tV   = WW   + _npnp;
+  tV   = jac  + _npnp;
 
   // -- Construct inverse mapping partials and Jacobian.
     
@@ -1378,6 +1511,35 @@ void Element::mapping ()
   Veclib::vdiv  (_npnp, _dsdx, 1, jac, 1, _dsdx, 1);
   Veclib::vdiv  (_npnp, _dsdy, 1, jac, 1, _dsdy, 1);
 
+  // -- Classify affine elements and install their constant metrics.
+
+  const real_t h = sqrt (jac[0]);	// -- Scale of the partials.
+  real_t       xr, xs, yr, ys;
+
+  _affine = constant (_npnp, dxdr, h, xr) && constant (_npnp, dxds, h, xs) &&
+            constant (_npnp, dydr, h, yr) && constant (_npnp, dyds, h, ys);
+
+  if (_affine) {
+    const real_t J = xr * ys - xs * yr;
+
+    _rx =  ys / J; _ry = -xs / J;
+    _sx = -yr / J; _sy =  xr / J;
+    _g1 =  (xs * xs + ys * ys) / J;
+    _g2 =  (xr * xr + yr * yr) / J;
+    _g3 = -(xr * xs + yr * ys) / J;
+    _g4 =  J;
+
+    Veclib::fill (_npnp, _rx, _drdx, 1);
+    Veclib::fill (_npnp, _ry, _drdy, 1);
+    Veclib::fill (_npnp, _sx, _dsdx, 1);
+    Veclib::fill (_npnp, _sy, _dsdy, 1);
+    Veclib::smul (_npnp, _g1, WW, 1, _Q1, 1);
+    Veclib::smul (_npnp, _g2, WW, 1, _Q2, 1);
+    Veclib::smul (_npnp, _g3, WW, 1, _Q3, 1);
+    Veclib::smul (_npnp, _g4, WW, 1, _Q4, 1);
+  } else
+    _rx = _ry = _sx = _sy = _g1 = _g2 = _g3 = _g4 = 0.0;
+
   // -- Delta is a measure of the size of the local mesh length.
   //    This can be computed in various ways; we use the "hypotenuse"
   //    form: delta = sqrt{(dx^2 + dy^2 + dz^2)/3},
@@ -1416,6 +1578,24 @@ void Element::mapping ()
   if (Blas::nrm2 (_npnp, _dsdx, 1) < EPS) { delete [] _dsdx; _dsdx = 0; }
   if (Blas::nrm2 (_npnp, _dsdy, 1) < EPS) { delete [] _dsdy; _dsdy = 0; }
   if (Blas::nrm2 (_npnp, _Q3,   1) < EPS) { delete [] _Q3;   _Q3   = 0; }
+
+  if (!_drdx) _rx = 0.0;
+  if (!_drdy) _ry = 0.0;
+  if (!_dsdx) _sx = 0.0;
+  if (!_dsdy) _sy = 0.0;
+  if (!_Q3)   _g3 = 0.0;
+
+  // -- Affine elements keep only the scalar partials, and if Cartesian
+  //    also only the scalar stiffness factors (Q1..Q3 = g1..g3 * WW).
+
+  if (_affine) {
+    delete [] _drdx; delete [] _drdy; delete [] _dsdx; delete [] _dsdy;
+    _drdx = _drdy = _dsdx = _dsdy = 0;
+    if (!_cyl) {
+      delete [] _Q1; delete [] _Q2; delete [] _Q3;
+      _Q1 = _Q2 = _Q3 = 0;
+    }
+  }
 }
 
 
@@ -1463,6 +1643,13 @@ void Element::HelmholtzRow (const real_t lambda2,
   const real_t *dtr, *dts, *dvr, *dvs;
   int_t        m, n;
 
+  // -- Cartesian affine elements store Q1..Q3 as scalar multiples of WW.
+
+  const bool   cmp = _affine && !_cyl;
+  const real_t *q1 = (cmp) ? _WW : _Q1, s1 = (cmp) ? _g1 : 1.0;
+  const real_t *q2 = (cmp) ? _WW : _Q2, s2 = (cmp) ? _g2 : 1.0;
+  const real_t *q3 = (cmp) ? ((_g3) ? _WW : 0) : _Q3, s3 = (cmp) ? _g3 : 1.0;
+
   // -- If we are setting up a viscous matrix, use SVV-stabilised operators.
 
   if (lambda2 > EPSDP) { dvr = _SDVr; dtr = _SDTr; dvs = _SDVs; dts = _SDTs; }
@@ -1477,20 +1664,20 @@ void Element::HelmholtzRow (const real_t lambda2,
         for (n = 0; n < _np; n++) {
             Veclib::vmul (_np, dtr+j*_np, 1, dtr+n*_np, 1, work, 1);
             Veclib::vmul (_np, work, 1, varkinvis+j, _np, work, 1);
-            hij[Veclib::row_major(i,n,_np)]  = Blas::dot(_np,_Q1+i*_np,1,work,1);
+            hij[Veclib::row_major(i,n,_np)]  = s1 * Blas::dot(_np,q1+i*_np,1,work,1);
         }
 
         for (m = 0; m < _np; m++) {
             Veclib::vmul (_np, dts+i*_np, 1, dts+m*_np, 1, work, 1);
             Veclib::vmul (_np, work, 1, varkinvis+i*_np, 1, work, 1);
-            hij[Veclib::row_major(m,j,_np)] += Blas::dot (_np,_Q2+j,_np,work,1);
+            hij[Veclib::row_major(m,j,_np)] += s2 * Blas::dot (_np,q2+j,_np,work,1);
         }
 
-        if (_Q3)
+        if (q3)
             for (m = 0; m < _np; m++)
                 for (n = 0; n < _np; n++) {
-                    hij[Veclib::row_major(m,n,_np)] += _Q3[Veclib::row_major(i,n,_np)] *dvr[Veclib::row_major(n,j,_np)] *  dvs[Veclib::row_major(i,m,_np)]*varkinvis[Veclib::row_major(i,n,_np)];
-                    hij[Veclib::row_major(m,n,_np)] += _Q3[Veclib::row_major(m,j,_np)] *dvr[Veclib::row_major(j,n,_np)] *  dvs[Veclib::row_major(m,i,_np)]*varkinvis[Veclib::row_major(m,j,_np)];
+                    hij[Veclib::row_major(m,n,_np)] += s3 * q3[Veclib::row_major(i,n,_np)] *dvr[Veclib::row_major(n,j,_np)] *  dvs[Veclib::row_major(i,m,_np)]*varkinvis[Veclib::row_major(i,n,_np)];
+                    hij[Veclib::row_major(m,n,_np)] += s3 * q3[Veclib::row_major(m,j,_np)] *dvr[Veclib::row_major(j,n,_np)] *  dvs[Veclib::row_major(m,i,_np)]*varkinvis[Veclib::row_major(m,j,_np)];
                 }
 
         hij[Veclib::row_major(i,j,_np)] += _Q4[Veclib::row_major(i,j,_np)] * hCon;
@@ -1501,19 +1688,19 @@ void Element::HelmholtzRow (const real_t lambda2,
 
         for (n = 0; n < _np; n++) {
             Veclib::vmul (_np, dtr+j*_np, 1, dtr+n*_np, 1, work, 1);
-            hij[Veclib::row_major(i,n,_np)]  = Blas::dot(_np,_Q1+i*_np,1,work,1);
+            hij[Veclib::row_major(i,n,_np)]  = s1 * Blas::dot(_np,q1+i*_np,1,work,1);
         }
 
         for (m = 0; m < _np; m++) {
             Veclib::vmul (_np, dts+i*_np, 1, dts+m*_np, 1, work, 1);
-            hij[Veclib::row_major(m,j,_np)] += Blas::dot (_np,_Q2+j,_np,work,1);
+            hij[Veclib::row_major(m,j,_np)] += s2 * Blas::dot (_np,q2+j,_np,work,1);
         }
 
-        if (_Q3)
+        if (q3)
             for (m = 0; m < _np; m++)
                 for (n = 0; n < _np; n++) {
-                    hij[Veclib::row_major(m,n,_np)] += _Q3[Veclib::row_major(i,n,_np)] *                                                       dvr[Veclib::row_major(n,j,_np)] *  dvs[Veclib::row_major(i,m,_np)];
-                    hij[Veclib::row_major(m,n,_np)] += _Q3[Veclib::row_major(m,j,_np)] *                                                       dvr[Veclib::row_major(j,n,_np)] * dvs[Veclib::row_major(m,i,_np)];
+                    hij[Veclib::row_major(m,n,_np)] += s3 * q3[Veclib::row_major(i,n,_np)] *                                                       dvr[Veclib::row_major(n,j,_np)] *  dvs[Veclib::row_major(i,m,_np)];
+                    hij[Veclib::row_major(m,n,_np)] += s3 * q3[Veclib::row_major(m,j,_np)] *                                                       dvr[Veclib::row_major(j,n,_np)] * dvs[Veclib::row_major(m,i,_np)];
                 }
         hij[Veclib::row_major(i,j,_np)] += _Q4[Veclib::row_major(i,j,_np)] * hCon;
     
@@ -1556,6 +1743,17 @@ void Element::HelmholtzDiag (const real_t lambda2,
 	if (_Q3) dg[ij] += 2.0 * _Q3[ij] * dvr[j*j] * dvs[i*i];
 	dg[ij] += HCon * _Q4[ij];
       }
+  } else if (_affine) {
+    HCon = lambda2 + betak2;
+    for (ij = 0, i = 0; i < _np; i++)
+      for (j = 0; j < _np; j++, ij++) {
+	Veclib::vmul (_np, dtr+j*_np, 1, dtr+j*_np, 1, tmp, 1);
+	dg[ij]  = _g1 * Blas::dot (_np, _WW+i*_np, 1, tmp, 1);
+	Veclib::vmul (_np, dts+i*_np, 1, dts+i*_np, 1, tmp, 1);
+	dg[ij] += _g2 * Blas::dot (_np, _WW+j, _np, tmp, 1);
+	if (_g3) dg[ij] += 2.0 * _g3 * _WW[ij] * dvr[j*j] * dvs[i*i];
+	dg[ij] += HCon * _Q4[ij];
+      }
   } else {
     HCon = lambda2 + betak2;
     for (ij = 0, i = 0; i < _np; i++)
@@ -1573,6 +1771,61 @@ void Element::HelmholtzDiag (const real_t lambda2,
 }
 
 
+void Element::vertexHelmholtz (const real_t lambda2  ,
+			       real_t*      varkinvis,
+			       const real_t betak2   ,
+			       real_t*      phi      ,
+			       real_t*      h0       ,
+			       real_t*      work     ) const
+// --------------------------------------------------------------------------
+// Evaluate the four bilinear (N_P = 2) vertex basis functions of the
+// element at its nodes, and the 4x4 Galerkin projection of the
+// elemental Helmholtz matrix onto them, for use as a coarse space.
+//
+// Vertex k is node k*(np-1) of the element boundary (in _emap order),
+// i.e. the first node of side k.
+//
+// + phi:  4 x nTot() matrix (row-major), rows sorted in _emap order;
+// + h0:   4 x 4 matrix (row-major);
+// + work: vector, length 5*nTot() + np.
+//  --------------------------------------------------------------------------
+{
+  int_t   i, j, k, ij, ci, cj;
+  real_t  *P = work, *row = work + 4*_npnp, *tmp = row + _npnp, y;
+
+  // -- Basis functions in natural (row-major) node order.
+
+  for (k = 0; k < 4; k++) {
+    ci = _emap[k * (_np - 1)] / _np;
+    cj = _emap[k * (_np - 1)] % _np;
+    for (ij = 0, i = 0; i < _np; i++)
+      for (j = 0; j < _np; j++, ij++)
+	P[k*_npnp + ij] =
+	  0.5 * ((ci) ? 1.0 + _zs[i] : 1.0 - _zs[i]) *
+	  0.5 * ((cj) ? 1.0 + _zr[j] : 1.0 - _zr[j]);
+  }
+
+  // -- Project elemental matrix, one row at a time.
+
+  Veclib::zero (16, h0, 1);
+
+  for (ij = 0, i = 0; i < _np; i++)
+    for (j = 0; j < _np; j++, ij++) {
+      this -> HelmholtzRow (lambda2, varkinvis, betak2, i, j, row, tmp);
+      for (k = 0; k < 4; k++) {
+	y = Blas::dot (_npnp, row, 1, P + k*_npnp, 1);
+	h0[0*4 + k] += P[0*_npnp + ij] * y;
+	h0[1*4 + k] += P[1*_npnp + ij] * y;
+	h0[2*4 + k] += P[2*_npnp + ij] * y;
+	h0[3*4 + k] += P[3*_npnp + ij] * y;
+      }
+    }
+
+  for (k = 0; k < 4; k++)
+    Veclib::gathr (_npnp, P + k*_npnp, _emap, phi + k*_npnp);
+}
+
+
 void Element::HelmholtzKern (const real_t lambda2,
                  real_t* varkinvis,
 			     const real_t betak2 ,
@@ -1585,12 +1838,16 @@ void Element::HelmholtzKern (const real_t lambda2,
 // (if required, these can be the same storage locations).
 //
 // Lambda2 is the Helmholtz constant, betak2 is the mode Fourier constant.
+//
+// For Cartesian affine elements the geometric factors are applied as
+// constant multiples of the (shared) quadrature weights.
 //  --------------------------------------------------------------------------
 {
   const int_t loopcnt = _npnp; // -- Workaround for NEC vectorisation.
   int_t       ij;
   real_t      tmp, r2, hCon;
   real_t      *g1 = _Q1, *g2 = _Q2, *g3 = _Q3, *g4 = _Q4, *r = _ymesh;
+  const real_t *w = _WW;
 
   if (_cyl) {
     if (g3) {
@@ -1611,10 +1868,27 @@ void Element::HelmholtzKern (const real_t lambda2,
 	tgt[ij]  = g4[ij] * src[ij] * hCon;
       }
     }
+  } else if (_affine) {		// -- Cartesian, constant metrics.
+    if (_g3) {
+      for (ij = 0; ij < loopcnt; ij++) {
+	hCon     = betak2*varkinvis[ij] + lambda2;
+	tmp      = R [ij];
+	R  [ij]  = w[ij] * (_g1 * R  [ij] + _g3 * S  [ij]);
+	S  [ij]  = w[ij] * (_g2 * S  [ij] + _g3 * tmp);
+	tgt[ij]  = w[ij] * _g4 * src[ij] * hCon;
+      }
+    } else {
+      for (ij = 0; ij < loopcnt; ij++) {
+	hCon     = betak2*varkinvis[ij] + lambda2;
+	R  [ij] *= w[ij] * _g1;
+	S  [ij] *= w[ij] * _g2;
+	tgt[ij]  = w[ij] * _g4 * src[ij] * hCon;
+      }
+    }
   } else {			// -- Cartesian.
-    hCon = betak2*varkinvis[ij] + lambda2;
     if (g3) {
       for (ij = 0; ij < loopcnt; ij++) {
+	hCon     = betak2*varkinvis[ij] + lambda2;
 	tmp      = R [ij];
 	R  [ij]  = g1[ij] * R  [ij] + g3[ij] * S  [ij];
 	S  [ij]  = g2[ij] * S  [ij] + g3[ij] * tmp;
@@ -1622,6 +1896,7 @@ void Element::HelmholtzKern (const real_t lambda2,
       }
     } else {
       for (ij = 0; ij < loopcnt; ij++) {
+	hCon     = betak2*varkinvis[ij] + lambda2;
 	R  [ij] *= g1[ij];
 	S  [ij] *= g2[ij];
 	tgt[ij]  = g4[ij] * src[ij] * hCon;
@@ -1708,6 +1983,8 @@ void Element::sideGeom (const int_t side,
     Veclib::vsqrt (_np, area, 1, area, 1);
     Veclib::vmul  (_np, area, 1, _wr,  1, area, 1);    
 
+    if   (_affine) { Veclib::fill (_np, -_sx, nx, 1);
+                     Veclib::fill (_np, -_sy, ny, 1); break; }
     if   (_dsdx) Veclib::smul (_np, -1.0, _dsdx, skip, nx, 1);
     else         Veclib::zero (_np,                    nx, 1);
     if   (_dsdy) Veclib::smul (_np, -1.0, _dsdy, skip, ny, 1);
@@ -1731,6 +2008,8 @@ void Element::sideGeom (const int_t side,
     Veclib::vsqrt (_np, area, 1, area, 1);
     Veclib::vmul  (_np, area, 1, _ws,  1, area, 1);
 
+    if   (_affine) { Veclib::fill (_np, _rx, nx, 1);
+                     Veclib::fill (_np, _ry, ny, 1); break; }
     if   (_drdx) Veclib::copy (_np, _drdx+low, skip, nx, 1);
     else         Veclib::zero (_np,                  nx, 1);
     if   (_drdy) Veclib::copy (_np, _drdy+low, skip, ny, 1);
@@ -1754,6 +2033,8 @@ void Element::sideGeom (const int_t side,
     Veclib::vsqrt (_np, area, 1, area, 1);
     Veclib::vmul  (_np, area, 1, _wr,  1, area, 1);
 
+    if   (_affine) { Veclib::fill (_np, _sx, nx, 1);
+                     Veclib::fill (_np, _sy, ny, 1); break; }
     if   (_dsdx) Veclib::copy (_np, _dsdx+low, skip, nx, 1);
     else         Veclib::zero (_np,                  nx, 1);
     if   (_dsdy) Veclib::copy (_np, _dsdy+low, skip, ny, 1);
@@ -1777,6 +2058,8 @@ void Element::sideGeom (const int_t side,
     Veclib::vsqrt (_np, area, 1, area, 1);
     Veclib::vmul  (_np, area, 1, _ws,  1, area, 1);
 
+    if   (_affine) { Veclib::fill (_np, -_rx, nx, 1);
+                     Veclib::fill (_np, -_ry, ny, 1); break; }
     if   (_drdx) Veclib::smul (_np, -1.0, _drdx, skip, nx, 1);
     else         Veclib::zero (_np,                    nx, 1);
     if   (_drdy) Veclib::smul (_np, -1.0, _drdy, skip, ny, 1);
@@ -39,6 +39,8 @@ public:
   void HelmholtzKern (const real_t, real_t*, const real_t,
 		      real_t*,real_t*,real_t*,real_t*)                   const;
   void HelmholtzOp   (const real_t, real_t*,const real_t,real_t*,real_t*,real_t*) const;
+  void vertexHelmholtz (const real_t,real_t*,const real_t,real_t*,real_t*,
+			real_t*)                                         const;
 
   // -- Local/global projectors.
 
@@ -106,6 +108,8 @@ public:
   bool   locate (const real_t,const real_t,real_t&,real_t&,
 		 real_t*,const bool = false)                      const;
   real_t probe  (const real_t,const real_t,const real_t*,real_t*) const;
+  void   probeWeights (const real_t,const real_t,real_t*,real_t*)   const;
+  void   extent (real_t&,real_t&,real_t&,real_t&)                 const;
 
   // -- Debugging/informational routines.
 
@@ -145,19 +149,28 @@ protected:
   real_t*       _drdx ;		//!<  Partial derivatives (r, s) --> (x, y),
   real_t*       _dsdx ;		//!<    evaluated at quadrature points.
   real_t*       _drdy ;		//!<    (2D row-major storage.)
-  real_t*       _dsdy ;		//!< 
+  real_t*       _dsdy ;		//!<    Not stored if _affine.
 
   real_t*       _delta;		//!<  Local length scale.
 
   real_t*       _Q1   ;		//!<  Geometric factor 1 at quadrature points.
   real_t*       _Q2   ;		//!<  Geometric factor 2 at quadrature points.
   real_t*       _Q3   ;		//!<  Geometric factor 3 at quadrature points.
+				//!<    (_Q1.._Q3 not stored if Cartesian _affine.)
   real_t*       _Q4   ;		//!<  Geometric factor 4 at quadrature points.
   real_t*       _Q8   ;	        //!<  Like _Q4 but without possible factor of y.
+  real_t*       _WW   ;		//!<  Tensor-product quadrature weights.
+
+  bool          _affine;	//!<  Parallelogram: metrics are constant.
+  real_t        _rx, _ry;	//!<  Constant dr/dx, dr/dy, ds/dx, ds/dy
+  real_t        _sx, _sy;	//!<    (zero where null-mapped), if _affine.
+  real_t        _g1, _g2;	//!<  If _affine, _Q1 = _g1 * _WW, etc.
+  real_t        _g3, _g4;	//!<    (before cylindrical premultiplication).
 
   // -- Geometric and quadrature-specific internal functions.
 
   void mapping      ();
+  void gradAffine   (const real_t,const real_t,real_t*,real_t*,real_t*) const;
   void HelmholtzRow (const real_t, real_t*, const real_t,const int_t,
 		     const int_t,real_t*,real_t*) const;
 
@@ -7,57 +7,157 @@
 // it in C++ ensures that we can delete copies of arrays allocated
 // using new. See the equivalent family routines in Femlib.
 //
-// This would be templated if instantiation was more standard
-// across compilation regimes (or I could figure out how to make it
-// all work), but the minimum requirement is real arrays...so that's
-// all for now.
+// Vectors of real_t and of float (single-precision matrix factors,
+// see MatrixSys) are held in separate families.
 //
-// To do: reimplement this with smart pointers.
+// Members are found by a hash of their contents (so that adoption
+// costs one pass over the new vector plus a comparison against any
+// member with the same hash) and by their storage address (for
+// abandonment).  As ever, vectors that agree to within the tolerance
+// of Veclib::same are taken to be the same: the hash is of values
+// rounded to a grid much coarser than that tolerance, so such vectors
+// nearly always share a key (if not, they are merely not shared).
+// Each member is reference counted: every adopt must be balanced by
+// an abandon, and storage is deleted with the last.  The exception is
+// adopting a member's own storage again: that does nothing, so needs
+// no abandon.
+// Access to the families is serialised by a mutex.  Vectors of real_t
+// may come from new[] or Storage::allocate, and are freed accordingly.
 //
 //////////////////////////////////////////////////////////////////////////////
 
 #include <sem.h>
+#include <unordered_map>
+#include <mutex>
+#include <tuple>
 
-class rvect { public: int_t size; real_t* data; int_t nrep; };
+template<class T> class tvect {
+public:
+  int_t  size;			// Length of stored vector.
+  T*     data;			// Vector.
+  int_t  nrep;			// Number of references to data.
+  size_t key ;			// Hash of contents.
+};
 
-static vector<rvect*> rv;
+template<class T> class tfamily {
+public:
+  unordered_multimap<size_t, tvect<T>*> byKey ;
+  unordered_map<const T*, tvect<T>*>    byData;
+  mutex                                 lock  ;
+};
+
+static tfamily<real_t> rv;
+static tfamily<float>  fv;
+
+static void discard (real_t* data) { Storage::release (data); }
+static void discard (float*  data) { delete[] data; }
 
 namespace Family {
-static real_t* adopted (const int_t size, const real_t* src)
+template<class T>
+static size_t key (const int_t size, const T* src)
+// ---------------------------------------------------------------------------
+// FNV-1a hash of the length of src and the bit patterns of its values
+// rounded to multiples of q, which is about 1e8 (double) or 1e3 (float)
+// times the tolerance of Veclib::same.  Adding zero folds -0.0 onto
+// 0.0.
+// ---------------------------------------------------------------------------
 {
-  vector<rvect*>::iterator p;
-  bool found;
-  for (found = false, p = rv.begin(); p != rv.end(); p++) {
-    if ((*p) -> size != size) continue;
-    if (found = src == (*p) -> data) break;
-    if (found = Veclib::same (size, src, 1, (*p) -> data, 1))
-      { ++(*p) -> nrep; break; }
+  const double q = (sizeof (T) < sizeof (double)) ? 1.0e-3 : 1.0e-5;
+  size_t       h = static_cast<size_t>(14695981039346656037ULL) ^ size;
+  int_t        i;
+  size_t       j;
+
+  for (i = 0; i < size; i++) {
+    const double         v = floor (src[i] / q + 0.5) + 0.0;
+    const unsigned char* b = reinterpret_cast<const unsigned char*>(&v);
+    for (j = 0; j < sizeof (double); j++)
+      h = (h ^ b[j]) * static_cast<size_t>(1099511628211ULL);
   }
-  return found ? (*p) -> data : 0;
+
+  return h;
 }
 
-void abandon (real_t** vect)
+template<class T>
+static void abandon (tfamily<T>& tf, T** vect)
 {
-  vector<rvect*>::iterator p;
-  for (p = rv.begin(); p != rv.end(); p++)
-    if ((*p) -> data == *vect) {
-      if (--(*p) -> nrep == 0) { delete[] (*p) -> data; rv.erase (p); }
-      break;
-    }
+  if (!vect || !*vect) return;
+
+  lock_guard<mutex> guard (tf.lock);
+
+  typename unordered_map<const T*, tvect<T>*>::iterator p =
+    tf.byData.find (*vect);
+  if (p == tf.byData.end()) return;
+
+  tvect<T>* S = p -> second;
+
+  if (--S -> nrep) return;
+
+  typename unordered_multimap<size_t, tvect<T>*>::iterator q;
+  for (q = tf.byKey.find (S -> key); q -> second != S; q++);
+  tf.byKey.erase  (q);
+  tf.byData.erase (p);
+  discard (S -> data);
+  delete    S;
 }
 
-void adopt (const int_t size, real_t** vect)
+template<class T>
+static void adopt (tfamily<T>& tf, const int_t size, T** vect)
 {
   if (!vect || !*vect) return;
 
-  rvect*  S = 0;
-  real_t* member;
+  lock_guard<mutex> guard (tf.lock);
+
+  if (tf.byData.count (*vect)) return; // -- Already a member: no-op.
+
+  const size_t h = key (size, *vect);
+  typename unordered_multimap<size_t, tvect<T>*>::iterator q, e;
 
-  if ((member = adopted (size, *vect)) && member != *vect) {
-    delete[] *vect; *vect = member;
-  } else {
-    S = new rvect; S -> size = size; S -> data = *vect; S -> nrep = 1;
-    rv.push_back (S);
+  for (tie (q, e) = tf.byKey.equal_range (h); q != e; q++) {
+    tvect<T>* S = q -> second;
+    if (S -> size == size && Veclib::same (size, *vect, 1, S -> data, 1)) {
+      S -> nrep++;
+      discard (*vect); *vect = S -> data;
+      return;
+    }
+  }
+
+  tvect<T>* S = new tvect<T>;
+  S -> size = size; S -> data = *vect; S -> nrep = 1; S -> key = h;
+  tf.byKey.insert (make_pair (h, S));
+  tf.byData.insert (make_pair (S -> data, S));
+}
+
+template<class T>
+static void tally (tfamily<T>& tf, size_t& nvec, size_t& held, size_t& saved)
+{
+  lock_guard<mutex> guard (tf.lock);
+  typename unordered_map<const T*, tvect<T>*>::const_iterator p;
+
+  for (p = tf.byData.begin(); p != tf.byData.end(); p++) {
+    held  += p -> second -> size * sizeof (T);
+    saved += p -> second -> size * sizeof (T) * (p -> second -> nrep - 1);
   }
+  nvec += tf.byData.size();
+}
+
+void abandon (real_t** vect)                  { abandon (rv, vect); }
+void abandon (float**  vect)                  { abandon (fv, vect); }
+void adopt   (const int_t size, real_t** vect) { adopt (rv, size, vect); }
+void adopt   (const int_t size, float**  vect) { adopt (fv, size, vect); }
+
+void report (ostream& file)
+// ---------------------------------------------------------------------------
+// Print the number of distinct family vectors, the storage they
+// occupy and the storage avoided by sharing them.
+// ---------------------------------------------------------------------------
+{
+  size_t nvec = 0, held = 0, saved = 0;
+
+  tally (rv, nvec, held, saved);
+  tally (fv, nvec, held, saved);
+
+  file << "-- Family storage: " << nvec << " vectors, "
+       << held  / 1024 << " kB held, "
+       << saved / 1024 << " kB saved by sharing" << endl;
 }
 }
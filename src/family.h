@@ -3,7 +3,10 @@
 
 namespace Family {
   void abandon (real_t**);
+  void abandon (float**);
   void adopt   (const int_t, real_t**);
+  void adopt   (const int_t, float**);
+  void report  (ostream&);
 }
 
 #endif
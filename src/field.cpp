@@ -7,6 +7,7 @@
 ///////////////////////////////////////////////////////////////////////////////
 
 #include <sem.h>
+#include <algorithm>
 
 
 Field::Field (real_t*           M ,   // -- Data storage allocation.
@@ -23,19 +24,16 @@ Field::Field (real_t*           M ,   // -- Data storage allocation.
   _nsys    (N)
 {
   const int_t              np  = Geometry::nP();
-  const int_t              npr = Geometry::nProc();
   const int_t              nzb = Geometry::basePlane();
   const vector<Boundary*>& BC  = _bsys -> getBCs (0);
-  const real_t             dz  = Femlib::value ("TWOPI / BETA / N_Z");
   real_t*                  p;
-  int_t                    i, k;
+  int_t                    i, j, k;
 
   // -- Allocate storage for boundary data, round up size for Fourier transform.
   
   _nbound = _bsys -> nSurf();
   _nline  = _nbound * np;
-  if   (npr > 1) _nline += 2 * npr - _nline % (2 * npr);
-  else           _nline += _nline % 2;
+  _nline  = Geometry::padLength (_nline);
 
   _line  = new real_t* [static_cast<size_t>(_nz)];
   _sheet = new real_t  [static_cast<size_t>(_nz * _nline)];
@@ -44,15 +42,41 @@ Field::Field (real_t*           M ,   // -- Data storage allocation.
 
   Veclib::zero (_nz * _nline, _sheet, 1);
 
-  // -- Set values for boundary data (in physical space, so no Field
-  //    is needed and first argument is void in line with false final
-  //    argument).
+  // -- Note which boundaries must be re-evaluated by updateBoundaries,
+  //    and which tokens the others depend on.
 
-  this -> evaluateBoundaries (NULL, 0, false);
+  for (i = 0; i < _nbound; i++)
+    if (BC[i] -> timeDependent()) _bvary.push_back (i);
+    else if (const vector<string>* tok = BC[i] -> tokens())
+      for (j = 0; j < tok -> size(); j++)
+	if (find (_btoken.begin(), _btoken.end(), (*tok)[j]) == _btoken.end())
+	  _btoken.push_back ((*tok)[j]);
+
+  _bvalue.resize (_btoken.size());
+  _bcache = new real_t [static_cast<size_t>(_nz * _nline)];
+
+  this -> cacheBoundaries ();
+}
 
-  // -- Fourier transform boundary data.
 
+void Field::cacheBoundaries ()
+/// --------------------------------------------------------------------------
+/// Evaluate boundary data in physical space (so no Field is needed and
+/// first argument is void in line with false final argument), Fourier
+/// transform, and keep the transformed data for reuse by
+/// updateBoundaries, along with the values of the tokens on which
+/// time-invariant conditions depend.
+/// --------------------------------------------------------------------------
+{
+  int_t i;
+
+  this -> evaluateBoundaries (NULL, 0, false);
   this -> bTransform (FORWARD);
+
+  Veclib::copy (_nz * _nline, _sheet, 1, _bcache, 1);
+
+  for (i = 0; i < _btoken.size(); i++)
+    _bvalue[i] = Femlib::value (_btoken[i].c_str());
 }
 
 
@@ -90,6 +114,10 @@ Field& Field::solve (AuxField*             f  ,
 ///   natural BCs "h", while the remaining values get loaded from
 ///   essential BC values, "g".
 ///
+///   If the matrices are stored in single precision (token
+///   MIXED_PREC > 0), solution is instead by iterative refinement,
+///   see Field::refine.
+///
 /// For JACPCG (iterative) solution:
 ///
 ///   All vectors are ordered with globally-numbered (element-
@@ -102,27 +130,84 @@ Field& Field::solve (AuxField*             f  ,
 ///   et al., "Templates for the Solution of Linear Systems", netlib.
 ///   Iteration stops when ||r|| = ||Ax - b|| < TOL_REL^2 * ||b|
 ///   (Criterion 2 in Barrett et al.).
+///
+///   SCHPCG is the same except for the preconditioner, see
+///   MatrixSys::buildSchwarz.
+///
+///   If token N_PROJ > 0, the initial guess is improved by projection
+///   onto the span of up to N_PROJ earlier solution increments for
+///   the same plane and system, see Field::project.
 //   ---------------------------------------------------------------------------
 {
-  const char  routine[] = "Field::solve";
-  const int_t np    = Geometry::nP();
+  Field* u = this;
+
+  Field::solve (&u, &f, 1, MMS);
+
+  return *this;
+}
+
+
+void Field::solve (Field**               u  ,
+		   AuxField**            f  ,
+		   const int_t           n  ,
+		   const ModalMatrixSys* MMS)
+// ---------------------------------------------------------------------------
+// (Static class member function.)  Solve as above for each of n
+// Fields u that share matrix systems MMS, using f as the
+// corresponding forcing Fields.  Used for the members of an ensemble
+// (see dns/drive.cpp).
+//
+// For DIRECT solution with double-precision factors, RHS vectors for
+// all n Fields are made in turn as the columns of one array, which
+// is then solved for with a single multiple-RHS call (LAPACK pbtrs or
+// SparseChol::solve), so that the factors of each plane are
+// traversed once rather than n times.  Iterative and mixed-precision
+// solutions are made Field by Field.
+// ---------------------------------------------------------------------------
+{
   const int_t nel   = Geometry::nElmt();
   const int_t next  = Geometry::nExtElmt();
   const int_t npnp  = Geometry::nTotElmt();
   const int_t ntot  = Geometry::nPlane();
+  const int_t nz    = u[0] -> _nz;
   const int_t bmode = Geometry::baseMode(); // -- Process's lowest mode number.
-  int_t       i, k, pmode, mode;
+  int_t       i, j, k, pmode, mode;
 
-  for (k = 0; k < _nz; k++) {	// -- Loop over planes of data.
+  for (k = 0; k < nz; k++) {	// -- Loop over planes of data.
     
-    ROOTONLY if (k == 1) continue;	// -- Nyquist plane always zero.
+    // -- Nyquist plane always zero (for a symmetric representation,
+    //    plane 0 of an odd field holds the equivalent data).
+
+    if (Geometry::symmetric()) {
+      ROOTONLY if (k == 0 && f[0] -> _odd) {
+	for (j = 0; j < n; j++)
+	  Veclib::zero (Geometry::planeSize(), u[j] -> _plane[0], 1);
+	continue;
+      }
+    } else
+      ROOTONLY if (k == 1) continue;
 
     // -- Select Fourier mode, set local pointers and variables.
 
-    pmode = k >> 1;
+    pmode = Geometry::planeMode (k);
     mode  = bmode + pmode;
 
-    const MatrixSys*         M       = (*MMS)[pmode];
+    const MatrixSys* M = (*MMS)[pmode];
+
+    if (M -> _method != DIRECT) {
+      for (j = 0; j < n; j++)
+	u[j] -> iterate (M, k, mode, f[j] -> _plane[k], u[j] -> _plane[k],
+			 u[j] -> _line[k]);
+      continue;
+    }
+
+    if (M -> _hbif) {		// -- Single-precision factors.
+      for (j = 0; j < n; j++)
+	u[j] -> refine (M, mode, f[j] -> _plane[k], u[j] -> _plane[k],
+			u[j] -> _line[k]);
+      continue;
+    }
+
     const vector<Boundary*>& B       = M -> _BC;
     const AssemblyMap*       A       = M -> _AM;
     real_t                   lambda2 = M -> _HelmholtzConstant;
@@ -130,152 +215,391 @@ Field& Field::solve (AuxField*             f  ,
     int_t                    nsolve  = M -> _nsolve;
     int_t                    nglobal = M -> _nglobal;
     int_t                    nzero   = nglobal - nsolve;
-
-    real_t*                  forcing = f -> _plane[k];
-    real_t*                  unknown = _plane     [k];
-    real_t*                  bc      = _line      [k];
-
-    switch (M -> _method) {
-
-    case DIRECT: {
-      const real_t*  H     = const_cast<const real_t*>  (M -> _H);
-      const real_t** hii   = const_cast<const real_t**> (M -> _hii);
-      const real_t** hbi   = const_cast<const real_t**> (M -> _hbi);
-      const int_t*   b2g   = const_cast<const int_t*>   (A -> btog());
-      int_t          nband = M -> _nband;
-
-      vector<real_t> work (nglobal + 4*npnp);
-      real_t         *RHS = &work[0], *tmp = RHS + nglobal;
-      int_t          info;
+    const real_t*            H       = const_cast<const real_t*>  (M -> _H);
+    const real_t**           hii     = const_cast<const real_t**> (M -> _hii);
+    const real_t**           hbi     = const_cast<const real_t**> (M -> _hbi);
+    int_t                    nband   = M -> _nband;
+
+    // -- RHS columns are a multiple of 8 words (64 bytes) apart, like
+    //    planes of data (see Geometry::set), so that each is aligned
+    //    as the first is: the results of (vectorised) BLAS routines
+    //    can depend on alignment, and those for each Field are then
+    //    the same as they would be for it alone.
+
+    const int_t       ldb  = ((nglobal + 7) / 8) * 8;
+    Workspace::Vector work (n * ldb + 4*npnp);
+    real_t            *RHS = &work[0], *tmp = RHS + n * ldb;
+    int_t             info;
       
-      // -- Build RHS = - M f - H g + <h, w>.
+    // -- Build RHS = - M f - H g + <h, w> for each Field.
+
+    Veclib::zero (n * ldb, RHS, 1);
 
-      Veclib::zero (nglobal, RHS, 1);
+    for (j = 0; j < n; j++) {
       AuxField* temp;
-      this -> getEssential (bc, RHS, B, A);
-      this -> constrain    (forcing, lambda2, temp, betak2, RHS, A, tmp);
-      this -> buildRHS     (forcing, bc, RHS, 0, hbi, nsolve, nzero,B,A,tmp);
+      real_t*   forcing = f[j] -> _plane[k];
+      real_t*   bc      = u[j] -> _line [k];
+      real_t*   rhs     = RHS + j * ldb;
+
+      u[j] -> getEssential (bc, rhs, B, A);
+      u[j] -> constrain    (forcing, lambda2, temp, betak2, rhs, A, tmp);
+      u[j] -> buildRHS     (forcing, bc, rhs, 0, hbi, nsolve, nzero,B,A,tmp);
+    }
       
-      // -- Solve for unknown global-node values (if any).
+    // -- Solve for unknown global-node values (if any).
       
-      if (nsolve) Lapack::pbtrs("U",nsolve,nband-1,1,H,nband,RHS,nglobal,info);
+    if (M -> _LS)
+      M -> _LS -> solve (RHS, n, ldb);
+    else if (nsolve)
+      Lapack::pbtrs ("U",nsolve,nband-1,n,H,nband,RHS,ldb,info);
+
+    for (j = 0; j < n; j++) {
+      const int_t* b2g     = const_cast<const int_t*> (A -> btog());
+      real_t*      forcing = f[j] -> _plane[k];
+      real_t*      unknown = u[j] -> _plane[k];
+      real_t*      bc      = u[j] -> _line [k];
+      real_t*      rhs     = RHS + j * ldb;
       
       // -- Carry out Schur-complement solution for element-internal nodes.
       
       for (i = 0; i < nel; i++, b2g += next, forcing += npnp, unknown += npnp)
-	_elmt[i] -> global2localSC (RHS,b2g,forcing,unknown,hbi[i],hii[i],tmp);
+	u[j] -> _elmt[i] -> global2localSC
+	  (rhs, b2g, forcing, unknown, hbi[i], hii[i], tmp);
 
       unknown -= ntot;
     
       // -- Scatter-gather essential BC values into plane.
 
-      Veclib::zero (nglobal, RHS, 1);
+      Veclib::zero (nglobal, rhs, 1);
     
-      this -> getEssential (bc, RHS, B,   A);
-      this -> setEssential (RHS, unknown, A);
+      u[j] -> getEssential (bc, rhs, B,   A);
+      u[j] -> setEssential (rhs, unknown, A);
     }
-    break;
+  }
+
+  for (j = 0; j < n; j++) u[j] -> _odd = f[j] -> _odd;
+}
 
-    case JACPCG: {
-      const int_t    StepMax =  Femlib::ivalue ("STEP_MAX");
-      const int_t    npts    = M -> _npts;
-      real_t         alpha, beta, dotp, epsb2, r2, rho1, rho2;
+
+void Field::iterate (const MatrixSys* M      ,
+		     const int_t      k      ,
+		     const int_t      mode   ,
+		     real_t*          forcing,
+		     real_t*          unknown,
+		     const real_t*    bc     )
+/// --------------------------------------------------------------------------
+/// JACPCG or SCHPCG (iterative) solution for plane k of data, Fourier
+/// mode number mode, as described for Field::solve.
+// ---------------------------------------------------------------------------
+{
+  const char               routine[] = "Field::solve";
+  const vector<Boundary*>& B         = M -> _BC;
+  const AssemblyMap*       A         = M -> _AM;
+  const real_t             lambda2   = M -> _HelmholtzConstant;
+  const real_t             betak2    = M -> _FourierConstant;
+  const int_t              nsolve    = M -> _nsolve;
+  const int_t              nglobal   = M -> _nglobal;
+  const int_t              nzero     = nglobal - nsolve;
+  const int_t              StepMax   = Femlib::ivalue ("STEP_MAX");
+  const int_t              nproj     = Femlib::ivalue ("N_PROJ");
+  const int_t              npts      = M -> _npts;
+  real_t                   alpha, beta, dotp, epsb2, r2, rho1, rho2;
+  real_t                   r2init, r2proj;
+  int_t                    i, nused = 0;
 #if defined (_VECTOR_ARCH)
-      vector<real_t> work (5 * npts + 3 * Geometry::nPlane());
+  Workspace::Vector        work (5 * npts + 3 * Geometry::nPlane());
 #else
-      vector<real_t> work (5 * npts + 4 * Geometry::nTotElmt());
+  Workspace::Vector        work (5 * npts + 4 * Geometry::nTotElmt());
 #endif
-      real_t* r   = &work[0];
-      real_t* p   = r + npts;
-      real_t* q   = p + npts;
-      real_t* x   = q + npts;
-      real_t* z   = x + npts;
-      real_t* wrk = z + npts;
-
-      Veclib::zero (nglobal, x, 1);
-      AuxField* temp;
+  real_t* r   = &work[0];
+  real_t* p   = r + npts;
+  real_t* q   = p + npts;
+  real_t* x   = q + npts;
+  real_t* z   = x + npts;
+  real_t* wrk = z + npts;
 
-      this -> getEssential (bc,x,B,A);
-      this -> constrain    (forcing,lambda2,temp,betak2,x,A,wrk);
-      this -> buildRHS     (forcing,bc,r,r+nglobal,0,nsolve,nzero,B,A,wrk);
+  Veclib::zero (nglobal, x, 1);
+  AuxField* temp;
 
-      epsb2  = Femlib::value ("TOL_REL") * sqrt (Blas::dot (npts, r, 1, r, 1));
-      epsb2 *= epsb2;
+  this -> getEssential (bc,x,B,A);
+  this -> constrain    (forcing,lambda2,temp,betak2,x,A,wrk);
+  this -> buildRHS     (forcing,bc,r,r+nglobal,0,nsolve,nzero,B,A,wrk);
 
-      // -- Build globally-numbered x from element store.
+  epsb2  = Femlib::value ("TOL_REL") * sqrt (Blas::dot (npts, r, 1, r, 1));
+  epsb2 *= epsb2;
 
-      this -> local2global (unknown, x, A);
+  // -- Build globally-numbered x from element store.
 
-      // -- Compute first residual using initial guess: r = b - Ax.
-      //    And mask to get residual for the zero-BC problem.
+  this -> local2global (unknown, x, A);
 
-      Veclib::zero (nzero, x + nsolve, 1);   
-      Veclib::copy (npts,  x, 1, q, 1);
+  // -- Compute first residual using initial guess: r = b - Ax.
+  //    And mask to get residual for the zero-BC problem.
 
-      this -> HelmholtzOperator (q, p, lambda2, betak2, mode, wrk);
+  Veclib::zero (nzero, x + nsolve, 1);   
+  Veclib::copy (npts,  x, 1, q, 1);
 
-      Veclib::zero (nzero, p + nsolve, 1);
-      Veclib::zero (nzero, r + nsolve, 1);
-      Veclib::vsub (npts, r, 1, p, 1, r, 1);
+  this -> HelmholtzOperator (q, p, lambda2, betak2, mode, wrk);
 
-      r2 = Blas::dot (npts, r, 1, r, 1);
+  Veclib::zero (nzero, p + nsolve, 1);
+  Veclib::zero (nzero, r + nsolve, 1);
+  Veclib::vsub (npts, r, 1, p, 1, r, 1);
 
-      // -- PCG iteration.
+  r2 = r2init = Blas::dot (npts, r, 1, r, 1);
 
-      i = 0;
-      while (r2 > epsb2 && ++i < StepMax) {
+  // -- Project onto solution history, save starting point.
 
-	// -- Preconditioner.
+  Workspace::Vector x0 ((nproj > 0) ? npts : 0);
 
-	Veclib::vmul (npts, M -> _PC, 1, r, 1, z, 1);
+  if (nproj > 0) {
+    if (_hist.size() != _nz) _hist.resize (_nz);
+    this -> project (_hist[k], M, x, r);
+    nused = _hist[k].nvec;
+    r2    = r2proj = Blas::dot (npts, r, 1, r, 1);
+    Veclib::copy (npts, x, 1, &x0[0], 1);
+  }
 
-	rho1 = Blas::dot (npts, r, 1, z, 1);
+  // -- PCG iteration.
 
-	// -- Update search direction.
+  i = 0;
+  while (r2 > epsb2 && ++i < StepMax) {
 
-	if (i == 1)
-	  Veclib::copy  (npts,             z, 1, p, 1); // -- p = z.
-	else {
-	  beta = rho1 / rho2;	
-	  Veclib::svtvp (npts, beta, p, 1, z, 1, p, 1); // -- p = z + beta p.
-	}
+    // -- Preconditioner.
 
-	// -- Matrix-vector product.
+    M -> precon (r, z);
 
-	this -> HelmholtzOperator (p, q, lambda2, betak2, mode, wrk);
+    rho1 = Blas::dot (npts, r, 1, z, 1);
 
-	Veclib::zero (nzero, q + nsolve, 1);
+    // -- Update search direction.
 
-	// -- Move in conjugate direction.
+    if (i == 1)
+      Veclib::copy  (npts,             z, 1, p, 1); // -- p = z.
+    else {
+      beta = rho1 / rho2;	
+      Veclib::svtvp (npts, beta, p, 1, z, 1, p, 1); // -- p = z + beta p.
+    }
 
-	dotp  = Blas::dot (npts, p, 1, q, 1);
-	alpha = rho1 / dotp;
-	Blas::axpy (npts,  alpha, p, 1, x, 1); // -- x += alpha p.
-	Blas::axpy (npts, -alpha, q, 1, r, 1); // -- r -= alpha q.
+    // -- Matrix-vector product.
 
-	rho2 = rho1;
-	r2   = Blas::dot (npts, r, 1, r, 1);
-      }
-  
-      if (i == StepMax) Veclib::alert (routine, "step limit exceeded", WARNING);
-  
-      // -- Unpack converged vector x, impose current essential BCs.
+    this -> HelmholtzOperator (p, q, lambda2, betak2, mode, wrk);
 
-      this -> global2local (x, unknown, A);
-      
-      this -> getEssential (bc, x, B,   A);
-      this -> setEssential (x, unknown, A);
-  
-      if (static_cast<int_t>(Femlib::value ("VERBOSE")) > 1) {
-	char s[StrMax];
-	sprintf (s, ":%3d iterations, field '%c'", i, _name);
-	Veclib::alert (routine, s, REMARK);
-      }
-    }
-    break;
-    }
+    Veclib::zero (nzero, q + nsolve, 1);
+
+    // -- Move in conjugate direction.
+
+    dotp  = Blas::dot (npts, p, 1, q, 1);
+    alpha = rho1 / dotp;
+    Blas::axpy (npts,  alpha, p, 1, x, 1); // -- x += alpha p.
+    Blas::axpy (npts, -alpha, q, 1, r, 1); // -- r -= alpha q.
+
+    rho2 = rho1;
+    r2   = Blas::dot (npts, r, 1, r, 1);
+  }
+
+  if (i == StepMax) Veclib::alert (routine, "step limit exceeded", WARNING);
+
+  if (nproj > 0) this -> extend (_hist[k], M, mode, x, &x0[0], wrk);
+
+  // -- Unpack converged vector x, impose current essential BCs.
+
+  this -> global2local (x, unknown, A);
+
+  this -> getEssential (bc, x, B,   A);
+  this -> setEssential (x, unknown, A);
+
+  if (Profile::active()) {
+    char s[StrMax];
+    sprintf (s, "pcg_iter.%c.%1d", _name, (int) mode);
+    Profile::count ("pcg_solves");
+    Profile::count (s, i);
+  }
+
+  // -- The iteration count can be set against that of a PRECON = 0
+  //    (Jacobi) run to judge the Schwarz preconditioner.
+
+  if (static_cast<int_t>(Femlib::value ("VERBOSE")) > 1) {
+    char s[StrMax];
+    if (nproj > 0)
+      sprintf (s, ":%3d iterations, field '%c', projection (%1d vectors) "
+	       "reduced initial residual by %.1e", i, _name,
+	       (int) nused, (r2init > 0.0) ? sqrt (r2proj / r2init) : 1.0);
+    else
+      sprintf (s, ":%3d iterations, field '%c'", i, _name);
+    Veclib::alert (routine, s, REMARK);
   }
-  return *this;
+}
+
+
+void Field::refine (const MatrixSys* M      ,
+		    const int_t      mode   ,
+		    real_t*          forcing,
+		    real_t*          unknown,
+		    const real_t*    bc     )
+/// --------------------------------------------------------------------------
+/// Mixed-precision direct solution for one plane of data, used when
+/// the factors of DIRECT system M are held in single precision (token
+/// MIXED_PREC > 0).  The right-hand side b is built in the global
+/// ordering used for PCG and, starting from the current solution x, a
+/// correction e is found by the single-precision static-condensation
+/// solve of A e = b - A x (MatrixSys::solve).  This is repeated
+/// MIXED_PREC times more, residuals always being computed in double
+/// precision by HelmholtzOperator: each sweep reduces the error by a
+/// factor of roughly the single-precision roundoff times the condition
+/// number of A, so one or two sweeps recover double-precision results.
+// ---------------------------------------------------------------------------
+{
+  const char               routine[] = "Field::refine";
+  const int_t              nref      = Femlib::ivalue ("MIXED_PREC");
+  const vector<Boundary*>& B         = M -> _BC;
+  const AssemblyMap*       A         = M -> _AM;
+  const real_t             lambda2   = M -> _HelmholtzConstant;
+  const real_t             betak2    = M -> _FourierConstant;
+  const int_t              npts      = M -> _npts;
+  const int_t              nsolve    = M -> _nsolve;
+  const int_t              nglobal   = M -> _nglobal;
+  const int_t              nzero     = nglobal - nsolve;
+#if defined (_VECTOR_ARCH)
+  Workspace::Vector        work (4 * npts + 3 * Geometry::nPlane());
+#else
+  Workspace::Vector        work (4 * npts + 4 * Geometry::nTotElmt());
+#endif
+  real_t*                  b   = &work[0];
+  real_t*                  r   = b + npts;
+  real_t*                  e   = r + npts;
+  real_t*                  x   = e + npts;
+  real_t*                  wrk = x + npts;
+  int_t                    i;
+
+  Veclib::zero (nglobal, x, 1);
+  AuxField* temp;
+
+  this -> getEssential (bc,x,B,A);
+  this -> constrain    (forcing,lambda2,temp,betak2,x,A,wrk);
+  this -> buildRHS     (forcing,bc,b,b+nglobal,0,nsolve,nzero,B,A,wrk);
+
+  this -> local2global (unknown, x, A);
+  Veclib::zero (nzero, x + nsolve, 1);
+
+  for (i = 0; i <= nref; i++) {
+    this -> HelmholtzOperator (x, r, lambda2, betak2, mode, wrk);
+    Veclib::zero (nzero, r + nsolve, 1);
+    Veclib::vsub (npts, b, 1, r, 1, r, 1);
+
+    M -> solve (r, e);
+
+    Blas::axpy (npts, 1.0, e, 1, x, 1);
+  }
+
+  if (static_cast<int_t>(Femlib::value ("VERBOSE")) > 1) {
+    char   s[StrMax];
+    real_t b2 = Blas::dot (npts, b, 1, b, 1);
+
+    this -> HelmholtzOperator (x, r, lambda2, betak2, mode, wrk);
+    Veclib::zero (nzero, r + nsolve, 1);
+    Veclib::vsub (npts, b, 1, r, 1, r, 1);
+
+    sprintf (s, "%d refinements, field '%c', relative residual %.1e",
+	     (int) nref, _name,
+	     (b2 > 0.0) ? sqrt (Blas::dot (npts, r, 1, r, 1) / b2) : 0.0);
+    Veclib::alert (routine, s, REMARK);
+  }
+
+  // -- Unpack solution, impose current essential BCs.
+
+  this -> global2local (x, unknown, A);
+  this -> getEssential (bc, x, B,   A);
+  this -> setEssential (x, unknown, A);
+}
+
+
+void Field::project (History&        H,
+		     const MatrixSys* M,
+		     real_t*          x,
+		     real_t*          r) const
+/// --------------------------------------------------------------------------
+/// Improve PCG starting guess x (and its residual r) by Galerkin
+/// projection onto the span of the solution increments held in H,
+/// following Fischer (1998) CMAME 163:193.  Since the basis vectors
+/// X_i are A-orthonormal, the increment that minimises the A-norm of
+/// the error is sum_i (X_i . r) X_i, and the residual is updated with
+/// the stored products A X_i at no further operator cost.
+///
+/// The history is discarded if it was built for a different system.
+// ---------------------------------------------------------------------------
+{
+  const int_t npts = M -> _npts;
+  const int_t nmax = Femlib::ivalue ("N_PROJ");
+  int_t       i;
+  real_t      alpha;
+
+  if (H.M != M                                              ||
+      fabs (H.l2 - M -> _HelmholtzConstant) > EPSDP         ||
+      fabs (H.b2 - M -> _FourierConstant  ) > EPSDP         ||
+      H.X.size() != nmax * npts                              ) {
+    H.M    = M;
+    H.l2   = M -> _HelmholtzConstant;
+    H.b2   = M -> _FourierConstant;
+    H.nvec = 0;
+    H.X .resize (nmax * npts);
+    H.AX.resize (nmax * npts);
+  }
+
+  for (i = 0; i < H.nvec; i++) {
+    alpha = Blas::dot (npts, &H.X[i * npts], 1, r, 1);
+    Blas::axpy (npts,  alpha, &H.X [i * npts], 1, x, 1);
+    Blas::axpy (npts, -alpha, &H.AX[i * npts], 1, r, 1);
+  }
+}
+
+
+void Field::extend (History&         H   ,
+		    const MatrixSys* M   ,
+		    const int_t      mode,
+		    const real_t*    x   ,
+		    const real_t*    x0  ,
+		    real_t*          work) const
+/// --------------------------------------------------------------------------
+/// Add the increment x - x0 produced by PCG to the solution history H,
+/// A-orthonormalised against the vectors already held.  When H is
+/// full it is restarted with this increment alone.  Increments that
+/// are (numerically) in the span of the history are not added.
+///
+/// Input vector work is as for HelmholtzOperator.
+// ---------------------------------------------------------------------------
+{
+  const int_t npts   = M -> _npts;
+  const int_t nsolve = M -> _nsolve;
+  const int_t nzero  = M -> _nglobal - nsolve;
+  const int_t nmax   = H.X.size() / npts;
+  int_t       i;
+  real_t      beta, norm0, norm;
+
+  if (!nmax) return;
+  if (H.nvec == nmax) H.nvec = 0;
+
+  real_t* dx  = &H.X [H.nvec * npts];
+  real_t* Adx = &H.AX[H.nvec * npts];
+
+  Veclib::vsub (npts, x, 1, x0, 1, dx, 1);
+  this -> HelmholtzOperator (dx, Adx, M -> _HelmholtzConstant,
+			     M -> _FourierConstant, mode, work);
+  Veclib::zero (nzero, Adx + nsolve, 1);
+
+  norm0 = Blas::dot (npts, dx, 1, Adx, 1);
+  if (norm0 < EPSDP) return;
+
+  for (i = 0; i < H.nvec; i++) {
+    beta = Blas::dot (npts, &H.X[i * npts], 1, Adx, 1);
+    Blas::axpy (npts, -beta, &H.X [i * npts], 1, dx,  1);
+    Blas::axpy (npts, -beta, &H.AX[i * npts], 1, Adx, 1);
+  }
+
+  norm = Blas::dot (npts, dx, 1, Adx, 1);
+  if (norm < EPSSP * norm0) return;
+
+  norm = 1.0 / sqrt (norm);
+  Blas::scal (npts, norm, dx,  1);
+  Blas::scal (npts, norm, Adx, 1);
+  H.nvec++;
 }
 
 
@@ -360,6 +684,10 @@ void Field::HelmholtzOperator (const real_t* x      ,
   const int_t        nglobal = AM -> nGlobal() + Geometry::nInode();
   int_t              i;
 
+  static const Profile::Counter flops = Profile::counter ("helmholtz_flops");
+
+  Profile::count (flops, nel * (8.0 * np * npnp + 12.0 * npnp));
+
   Veclib::zero (nglobal, y, 1);
 
   // -- Add in contributions from mixed BCs while x & y are global vectors.
@@ -600,6 +928,44 @@ void Field::setEssential (const real_t*      src,
 }
 
 
+static void sheetTransform (real_t*     sheet,
+			    const int_t nz   ,
+			    const int_t nline,
+			    const int_t sign ,
+			    const bool  odd  )
+// ---------------------------------------------------------------------------
+// 1D-DFT of a sheet of boundary data, nz planes (per process) of
+// nline values each.  See Field::bTransform.  For a symmetric
+// representation this is a sine transform if odd, else a cosine one.
+// ---------------------------------------------------------------------------
+{
+  const int_t nZ  = Geometry::nZ();
+  const int_t nPR = Geometry::nProc();
+  const int_t nPP = Geometry::nBlock (nline);
+
+  if (Geometry::symmetric()) {
+    const int_t ntrn = (nPR == 1) ? nline : nPP;
+
+    if (nPR > 1) Message::exchange (sheet, nz, nline, FORWARD);
+    if (odd) Femlib::DSTr (sheet, nZ, ntrn, sign);
+    else     Femlib::DCTr (sheet, nZ, ntrn, sign);
+    if (nPR > 1) Message::exchange (sheet, nz, nline, INVERSE);
+
+  } else if (nPR == 1) {
+    if (nZ > 1)
+      if (nZ == 2)
+	if   (sign == FORWARD) Veclib::zero (nline, sheet + nline, 1);
+	else                   Veclib::copy (nline, sheet, 1, sheet + nline, 1);
+      else
+	Femlib::DFTr (sheet, nZ, nline, sign);
+  } else {
+    Message::exchange (sheet, nz, nline, FORWARD);
+    Femlib::DFTr      (sheet, nZ, nPP,   sign   );
+    Message::exchange (sheet, nz, nline, INVERSE);
+  }
+}
+
+
 void Field::bTransform (const int_t sign)
 /// --------------------------------------------------------------------------
 /// Compute forward or backward 1D-DFT of boundary value storage areas.
@@ -612,23 +978,63 @@ void Field::bTransform (const int_t sign)
 /// evolved regardless of BC.
 // ---------------------------------------------------------------------------
 {
-  const int_t nZ  = Geometry::nZ();
-  const int_t nPR = Geometry::nProc();
-  const int_t nP  = _nline;
-  const int_t nPP = _nline / nPR;
+  sheetTransform (_sheet, _nz, _nline, sign,
+		  Geometry::symmetric() && _name == 'w');
+}
 
-  if (nPR == 1) {
-    if (nZ > 1)
-      if (nZ == 2)
-	if   (sign == FORWARD) Veclib::zero (_nline, _line[1], 1);
-	else                   Veclib::copy (_nline, _line[0], 1, _line[1], 1);
-      else
-	Femlib::DFTr (_sheet, nZ, _nline, sign);
-  } else {
-    Message::exchange (_sheet, _nz, nP, FORWARD);
-    Femlib::DFTr      (_sheet, nZ, nPP, sign   );
-    Message::exchange (_sheet, _nz, nP, INVERSE);
+
+void Field::updateBoundaries (const int_t step)
+/// --------------------------------------------------------------------------
+/// Refresh the Fourier-transformed boundary data set in physical
+/// space, with the same outcome as evaluateBoundaries (0, step, false)
+/// followed by bTransform (FORWARD).
+///
+/// Data for time-invariant conditions (all except functions of t or
+/// STEP, see Condition::timeDependent) were transformed once during
+/// construction, and are restored from that copy, unless a token that
+/// they use has since been reset (e.g. D_T with DT_ADAPT), when the
+/// copy is first remade.  Only boundaries with time-dependent
+/// conditions are re-evaluated; their values are gathered into a
+/// smaller sheet for the transform, then put back.  Computed
+/// conditions are subsequently evaluated in Fourier space.
+/// ---------------------------------------------------------------------------
+{
+  int_t j;
+
+  for (j = 0; j < _btoken.size(); j++)
+    if (Femlib::value (_btoken[j].c_str()) != _bvalue[j]) {
+      this -> cacheBoundaries ();
+      break;
+    }
+
+  Veclib::copy (_nz * _nline, _bcache, 1, _sheet, 1);
+
+  if (_bvary.empty()) return;
+
+  const int_t              np  = Geometry::nP();
+  const int_t              nzb = Geometry::basePlane();
+  const int_t              nb  = _bvary.size();
+  const vector<Boundary*>& BC  = _bsys -> getBCs (0);
+  int_t                    i, k, nline = nb * np;
+
+  nline = Geometry::padLength (nline);
+
+  Workspace::Vector sheet (_nz * nline);
+
+  Veclib::zero (_nz * nline, &sheet[0], 1);
+
+  for (k = 0; k < _nz; k++) {
+    Femlib::value ("z", Geometry::zPlane (nzb + k));
+    for (i = 0; i < nb; i++)
+      BC[_bvary[i]] -> evaluate (0, k, step, false, &sheet[k*nline + i*np]);
   }
+
+  sheetTransform (&sheet[0], _nz, nline, FORWARD,
+		  Geometry::symmetric() && _name == 'w');
+
+  for (k = 0; k < _nz; k++)
+    for (i = 0; i < nb; i++)
+      Veclib::copy (np, &sheet[k*nline + i*np], 1, _line[k] + _bvary[i]*np, 1);
 }
 
 
@@ -654,13 +1060,12 @@ void Field::evaluateBoundaries (const Field* P      ,
   const int_t  nz    = Geometry::nZProc();
   const int_t  bmode = Geometry::baseMode();
   const int_t  nzb   = Geometry::basePlane();
-  const real_t dz    = Femlib::value ("TWOPI / BETA / N_Z");
   real_t*      p;
   int_t        i, k, mode;
 
   if (Fourier) {
     for (k = 0; k < nz; k++) {
-      mode = bmode + (k >> 1);
+      mode = bmode + Geometry::planeMode (k);
       const vector<Boundary*>& BC =
 	_bsys -> getBCs (mode*Femlib::ivalue("BETA"));
       for (p = _line[k], i = 0; i < _nbound; i++, p += np)
@@ -668,7 +1073,7 @@ void Field::evaluateBoundaries (const Field* P      ,
     }
   } else {
     for (k = 0; k < _nz; k++) {
-      Femlib::value ("z", (nzb + k) * dz);
+      Femlib::value ("z", Geometry::zPlane (nzb + k));
       const vector<Boundary*>& BC = _bsys -> getBCs (0);
       for (p = _line[k], i = 0; i < _nbound; i++, p += np)
 	BC[i] -> evaluate (P, k, step, false, p);
@@ -899,6 +1304,12 @@ void Field::traction (real_t*      n, // Normal/pressure
 /// computations are carried out on Fourier-transformed
 /// variables. Input parameter M is the (exchange-padded) length of
 /// each variable's wall-tagged storage, per data plane.  //
+///
+/// For a symmetric representation, plane k holds mode k: n and t are
+/// then cosine series, like p, u and v, while s is a sine series, like
+/// w.  Edge::traction forms the real parts of n and t from the real
+/// parts of p, u and v, and the imaginary part of s from that of w and
+/// the real parts of u and v, so those outputs are the ones kept.
 /// ---------------------------------------------------------------------------
 {
   const vector<Boundary*>& UBC    = u -> _bsys -> getBCs(0);
@@ -910,8 +1321,38 @@ void Field::traction (real_t*      n, // Normal/pressure
   const real_t             *ur, *ui, *vr, *vi, *wr, *wi, *pr, *pi;
   real_t                   *nr, *ni, *tr, *ti, *sr, *si;
   int_t                    i, j, k, mode;
-  vector<real_t>           work (4 * np);
+  vector<real_t>           work (7 * np);
     
+  if (Geometry::symmetric()) {
+    real_t* dummy = &work[4 * np];   // -- Unwanted (zero) output parts.
+
+    for (k = 0; k < nz; k++) {
+      mode = bmode + k;
+
+      pr = p -> _plane[k];
+      ur = u -> _plane[k];
+      vr = v -> _plane[k];
+      wi = (w) ? w -> _plane[k] : 0;
+
+      for (i = 0, j = 0; i < nbound; i++)
+	if (UBC[i] -> inGroup ("wall")) {
+	  nr = n + j*np + k*M;
+	  tr = t + j*np + k*M;
+	  si = s + j*np + k*M;
+
+	  if (mode == 0)	// -- Sine series has no mode 0.
+	    UBC[i] -> traction (0, mu, pr, 0, ur, 0, vr, 0, 0, 0,
+				nr, 0, tr, 0, si, 0, &work[0]);
+	  else
+	    UBC[i] -> traction (mode, mu, pr, pr, ur, ur, vr, vr, wi, wi,
+				nr, dummy, tr, dummy + np, dummy + 2*np, si,
+				&work[0]);
+	  j++;
+	}
+    }
+    return;
+  }
+
   for (k = 0; k < nz; k += 2) {
     mode = bmode + (k >> 1);
 
@@ -978,7 +1419,7 @@ void Field::coupleBCs (Field*      v  ,
   const int_t    nL    =  v -> _nline;
   const int_t    nMode =  Geometry::nModeProc();
   const int_t    kLo   = (Geometry::procID() == 0) ? 1 : 0;
-  vector<real_t> work (nL);
+  Workspace::Vector work (nL);
   real_t         *Vr, *Vi, *Wr, *Wi, *tp = &work[0];
   
   if (dir == FORWARD) {
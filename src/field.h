@@ -118,9 +118,11 @@ public:
   Field& operator = (const real_t&   z) {AuxField::operator=(z); return *this;}
   Field& operator = (const char*     z) {AuxField::operator=(z); return *this;}
 
-  Field& solve  (AuxField*, const ModalMatrixSys*);
+  Field&      solve (AuxField*, const ModalMatrixSys*);
+  static void solve (Field**, AuxField**, const int_t, const ModalMatrixSys*);
 
   void evaluateBoundaries    (const Field*, const int_t, const bool = true);
+  void updateBoundaries      (const int_t);
   void evaluateM0Boundaries  (const Field*, const int_t);
   void addToM0Boundaries     (const real_t, const char*);
   void bTransform            (const int_t);
@@ -144,9 +146,32 @@ private:
   int_t         _nline ;	//!<  Length of one boundary line.
   real_t*       _sheet ;	//!<  Wrap-around storage for data boundary.
   real_t**      _line  ;	//!<  Single plane's worth of sheet.
+  real_t*        _bcache;	//!<  Transformed sheet, time-invariant BCs.
+  vector<int_t>  _bvary ;	//!<  Boundaries with time-dependent BCs.
+  vector<string> _btoken;	//!<  Tokens used by time-invariant BCs,
+  vector<real_t> _bvalue;	//!<    and their values in _bcache.
   BoundarySys*  _bsys  ;	//!<  Boundary system information.
   NumberSys*    _nsys  ;        //!<  Assembly mapping information.
 
+  struct History {		//!<  Solution history for PCG projection:
+    const MatrixSys* M    ;	//!<  system for which basis was built,
+    real_t           l2   ;	//!<  its Helmholtz constant,
+    real_t           b2   ;	//!<  its Fourier constant,
+    int_t            nvec ;	//!<  number of basis vectors held,
+    vector<real_t>   X    ;	//!<  A-orthonormal basis vectors,
+    vector<real_t>   AX   ;	//!<  and their products with A.
+  };
+  vector<History> _hist;	//!<  One History for each plane of data.
+
+  void project           (History&, const MatrixSys*, real_t*, real_t*) const;
+  void extend            (History&, const MatrixSys*, const int_t,
+			  const real_t*, const real_t*, real_t*)        const;
+
+  void cacheBoundaries   ();
+  void iterate           (const MatrixSys*, const int_t, const int_t, real_t*,
+			  real_t*, const real_t*);
+  void refine            (const MatrixSys*, const int_t, real_t*, real_t*,
+			  const real_t*);
   void getEssential      (const real_t*, real_t*,
 			  const vector<Boundary*>&, const AssemblyMap*) const;
   void setEssential      (const real_t*, real_t*, const AssemblyMap*);
@@ -12,7 +12,9 @@
 ///////////////////////////////////////////////////////////////////////////////
 
 #include <cstdio>
+#include <cmath>
 #include <iostream>
+#include <algorithm>
 
 #include <cfemdef.h>
 #include <utility.h>
@@ -26,9 +28,12 @@ int_t Geometry::_ndim  = UNSET;
 int_t Geometry::_np    = UNSET;
 int_t Geometry::_nz    = UNSET;
 int_t Geometry::_nzp   = UNSET;
+std::vector<int_t> Geometry::_nzq;
+std::vector<int_t> Geometry::_bzq;
 int_t Geometry::_nel   = UNSET;
 int_t Geometry::_psize = UNSET;
 Geometry::CoordSys Geometry::_csys = Geometry::Cartesian;
+bool Geometry::_sym = false;
 
 
 static int_t roundUp (const int_t n, const int_t a, const int_t b)
@@ -39,6 +44,37 @@ static int_t roundUp (const int_t n, const int_t a, const int_t b)
 { int_t m = n; while (m%a || m%b) m++; return m; }
 
 
+static void partition (const int_t          nz   ,
+		       const int_t          nproc,
+		       const real_t         w0   ,
+		       std::vector<int_t>&  nzq  )
+// ---------------------------------------------------------------------------
+// Share nz planes, as nz/2 pairs, in contiguous ranges over nproc
+// processes so as to balance their work.  Pair 0 has weight w0 and
+// the rest have weight 1.  The boundary between processes p-1 and p
+// is the pair whose starting (cumulative) weight is nearest p/nproc
+// of the total, subject to every process getting at least one pair.
+// When nproc divides nz/2 this is the uniform split.
+// ---------------------------------------------------------------------------
+{
+  const int_t  M = nz >> 1;
+  const real_t W = w0 + (M - 1);
+  int_t        p, u, b, lo = 0;
+  real_t       t;
+
+  for (p = 1; p <= nproc; p++) {
+    if (p == nproc) b = M;
+    else {
+      t = p * W / nproc;
+      for (b = u = lo + 1; u <= M - (nproc - p); u++)
+	if (std::fabs (w0 + (u - 1) - t) < std::fabs (w0 + (b - 1) - t)) b = u;
+    }
+    nzq[p - 1] = 2 * (b - lo);
+    lo = b;
+  }
+}
+
+
 void Geometry::set (const int_t    NP,
 		    const int_t    NZ,
 		    const int_t    NE,
@@ -52,18 +88,29 @@ void Geometry::set (const int_t    NP,
 // (because each Fourier mode is taken to have both real and imaginary
 // parts).  Hence, NZ is always even if NZ > 1.
 //
+// The planes need not divide evenly between processes: they are
+// shared as pairs (i.e. as complex modes, or two modes of a symmetric
+// representation) by partition.  In the non-symmetric case, the first
+// pair (mode 0 and the Nyquist mode, which is never evolved) costs
+// less than others, since it needs only half of their elliptic
+// solves, and so is given a weight of 0.75 against 1 for other pairs.
+// The root process, which holds it, can then take a greater share.
+//
 // NB: the value of _psize (a.k.a. planeSize) is the value of nPlane
-// (nel*np*np), but rounded up if necessary such that it remains an
-// even number when divided by the number of processes because:
+// (nel*np*np), but rounded up if necessary by padLength, i.e. such
+// that it splits into an even-sized block for each process because:
 //
 // 1. The even number restriction is to simplify the handling of
 // Fourier transforms, which is typically based on a real--complex
 // transform (done via the method of transform of two real functions
 // simultaneously, see e.g. Numerical Recipes or Bendat & Piersol).
 //  
-// 2. The restriction to be an integer multiple of twice the number of
-// processors is to simplify the structure of memory exchanges
+// 2. The restriction to blocks (in proportion to the number of planes
+// of each process) is to simplify the structure of memory exchanges
 // required for Fourier transforms when computing in parallel.
+//
+// 3. For 3D, it is also a multiple of 8 words (64 bytes) so that every
+// plane of a data area from Storage::allocate is cache-line aligned.
 // ---------------------------------------------------------------------------
 {
   static char routine[] = "Geometry::set", err[StrMax];
@@ -75,40 +122,81 @@ void Geometry::set (const int_t    NP,
   _nproc = Femlib::ivalue ("N_PROC");
 
   _np   = NP; _nz = NZ; _nel = NE; _csys = CS;
-  _nzp  = _nz / _nproc;
-  _ndim = (_nz > 2) ? 3 : 2;
+  _sym  = _nz > 1 && Femlib::ivalue ("SYMMETRY");
+  _ndim = (_nz > 2 || _sym) ? 3 : 2;
 
   if (_nz > 1 && _nz & 1) {	// -- 3D problems must have NZ even.
     sprintf (err, "N_Z must be even (%1d)", _nz);
     Veclib::alert (routine, err, ERROR);
   }
 
-  if (_nproc > 1) {		// -- Concurrent execution restrictions.
+  if (_sym && _csys == Cylindrical)
+    Veclib::alert (routine, "SYMMETRY needs Cartesian coordinates", ERROR);
 
-    if (_nz % (2 * _nproc)) {
-      sprintf (err, "No. of planes (%1d) per processor (%1d) must be even",
-	       _nz, _nproc);
-      Veclib::alert (routine, err, ERROR);
-    }
+  _nzq.assign (_nproc, _nz);
+  _bzq.assign (_nproc, 0);
+
+  if (_nproc > 1) {		// -- Concurrent execution restrictions.
 
     if (_nproc << 1 > _nz) {
       sprintf (err, "No. of processors (%1d) can at most be half N_Z (%1d)",
 	       _nproc, _nz);
       Veclib::alert (routine, err, ERROR);
     }
-#if 1
-    // -- _psize when divided by number of processes must be even.
-    _psize = roundUp (nPlane(), 2*_nproc, 2);
-#else
-    // -- Old version which didn't use roundUp().
-    _psize  = nPlane();
-    _psize += 2 * _nproc - nPlane() % (2 * _nproc);   
-#endif
+
+    partition (_nz, _nproc, (_sym) ? 1.0 : 0.75, _nzq);
+    for (int_t p = 1; p < _nproc; p++) _bzq[p] = _bzq[p - 1] + _nzq[p - 1];
+
+    _psize = padLength (nPlane());
+    while (_psize % 8) _psize = padLength (_psize + 1);
     
   } else {
     if (_nz > 1)
-      _psize = roundUp (nPlane(), 1, 2);
+      _psize = roundUp (nPlane(), 1, 8);
     else
       _psize = nPlane();
   }
+
+  _nzp = _nzq[_pid];
+}
+
+
+int_t Geometry::padLength (const int_t n)
+// ---------------------------------------------------------------------------
+// Return the least length, not less than n (or 1), of data planes
+// that can be exchanged between processes for Fourier transform: when
+// it is split into blocks in proportion to the planes on each
+// process, these must all be of even size.  For serial execution this
+// is just n rounded up to be even.
+// ---------------------------------------------------------------------------
+{
+  int_t m, p;
+
+  if (_nproc == 1) return n + (n & 1);
+
+  for (m = std::max (n, static_cast<int_t>(1)); ; m++) {
+    for (p = 0; p < _nproc; p++)
+      if ((m * _nzq[p]) % (2 * _nz)) break;
+    if (p == _nproc) return m;
+  }
+}
+
+
+real_t Geometry::dZ ()
+// ---------------------------------------------------------------------------
+// Spacing of data planes in z.
+// ---------------------------------------------------------------------------
+{
+  return (_sym) ? Femlib::value ("PI / BETA / N_Z")
+                : Femlib::value ("TWOPI / BETA / N_Z");
+}
+
+
+real_t Geometry::zPlane (const int_t k)
+// ---------------------------------------------------------------------------
+// Location in z of (global) data plane k.  Planes of a symmetric
+// (cosine/sine) representation are offset by half a spacing.
+// ---------------------------------------------------------------------------
+{
+  return (_sym) ? (k + 0.5) * dZ() : k * dZ();
 }
@@ -1,6 +1,8 @@
 #ifndef GEOMETRY_H
 #define GEOMETRY_H
 
+#include <vector>
+
 #include <cfemdef.h>
 
 class Geometry
@@ -23,6 +25,17 @@ class Geometry
 // possibility of 2D partitioning, we allow a distinction between the
 // number of elements in the partition and those in the whole 2D mesh.
 //
+// With token SYMMETRY set, fields are taken to be symmetric about the
+// planes z = 0 and z = PI / BETA, and are represented by cosine
+// (u, v, p, ...) or sine (w) series over half a period: each data
+// plane then holds one real mode, so that there are N_Z modes rather
+// than N_Z / 2, and data plane k lies at z = (k + 1/2) PI / (BETA N_Z).
+//
+// Processes need not hold equal numbers of planes: each holds a
+// contiguous range of (an even number of) planes, see set.  Functions
+// nZProc, nModeProc, basePlane and baseMode describe this process, or
+// process p when given an argument.
+//
 // Copyright (c) 1994+, Hugh M Blackburn
 // ===========================================================================
 {
@@ -33,6 +46,7 @@ public:
 
   static CoordSys system      () { return _csys;                 }  
   static bool     cylindrical () { return _csys == Geometry::Cylindrical; }
+  static bool     symmetric   () { return _sym;                  }
 
   static int_t  nP        () { return _np;                   }
   static int_t  nZ        () { return _nz;                   }
@@ -40,7 +54,7 @@ public:
   static int_t  nTotElmt  () { return _np * _np;             }
   static int_t  nExtElmt  () { return 4 * (_np - 1);         }
   static int_t  nIntElmt  () { return (_np - 2) * (_np - 2); }
-  static int_t  nMode     () { return (_nz + 1) >> 1;        }
+  static int_t  nMode     () { return _sym ? _nz : (_nz + 1) >> 1; }
   static int_t  nDim      () { return _ndim;                 }
   static int_t  nPlane    () { return _nel * nTotElmt();     }
   static int_t  nBnode    () { return _nel * nExtElmt();     }
@@ -54,10 +68,22 @@ public:
   static int_t  nZProc    () { return _nzp;                  }
   static int_t  nZ32      () { return (_nproc > 1) ? _nzp : (3 * _nz) >> 1; }
   static int_t  nTotProc  () { return _nzp * _psize;         }
-  static int_t  nModeProc () { return nMode() / _nproc;      }
-  static int_t  baseMode  () { return _pid * nModeProc();    }
-  static int_t  basePlane () { return _pid * _nzp;           }
-  static int_t  nBlock    () { return _psize / _nproc;       }
+  static int_t  nModeProc () { return nModeProc (_pid);      }
+  static int_t  baseMode  () { return baseMode  (_pid);      }
+  static int_t  basePlane () { return _bzq[_pid];            }
+  static int_t  nBlock    () { return nBlock (_psize);       }
+
+  static int_t  nZProc    (const int_t p) { return _nzq[p];  }
+  static int_t  nModeProc (const int_t p)
+    { return _sym ? _nzq[p] : (_nzq[p] + 1) >> 1; }
+  static int_t  baseMode  (const int_t p) { return planeMode (_bzq[p]); }
+  static int_t  basePlane (const int_t p) { return _bzq[p];  }
+  static int_t  nBlock    (const int_t n) { return n * _nzp / _nz; }
+  static int_t  padLength (const int_t);
+
+  static int_t  planeMode (const int_t k) { return _sym ? k : k >> 1; }
+  static real_t dZ        ();
+  static real_t zPlane    (const int_t);
 
 private:
   static int_t    _nproc ;	// Number of processors.
@@ -65,10 +91,15 @@ private:
   static int_t    _ndim  ;	// Number of space dimensions.
   static int_t    _np    ;	// Number of points along element edge.
   static int_t    _nz    ;	// Number of planes (total).
-  static int_t    _nzp   ;	// Number of planes per processor.
+  static int_t    _nzp   ;	// Number of planes on this processor.
+  static std::vector<int_t>
+                  _nzq   ;	// Number of planes on each processor,
+  static std::vector<int_t>
+                  _bzq   ;	// and the first of them.
   static int_t    _nel   ;	// Number of elements.
   static int_t    _psize ;	// nPlane rounded up to suit restrictions.
   static CoordSys _csys  ;	// Coordinate system (Cartesian/cylindrical).
+  static bool     _sym   ;	// Reflection-symmetric (cosine/sine) in z.
 
 };
 #endif
@@ -31,18 +31,15 @@ const Element* HistoryPoint::locate (const real_t      x   ,
 // ---------------------------------------------------------------------------
 // Static class member function which tries to locate x, y, point within
 // an element E, and return its location in r, s coordinates within E.
+// The spatial search index for Esys is built on first call and
+// retained for use on subsequent calls.
 // ---------------------------------------------------------------------------
 {
-  int_t i;
-  const int_t    NEL   = Esys.size();
-  const bool     guess = true;
-  const Element* E;
-  vector<real_t> work (max (2*Geometry::nTotElmt(), 5*Geometry::nP() + 6));
+  static Locator* L = 0;
 
-  for (E = 0, i = 0; E == 0 && i < NEL; i++)
-    if (Esys[i] -> locate (x, y, r=0.0, s=0.0, &work[0], guess)) E = Esys[i];
+  if (!L || !L -> built (Esys)) { delete L; L = new Locator (Esys); }
 
-  return E;
+  return L -> locate (x, y, r, s);
 }
 
 
@@ -13,6 +13,10 @@ public:
     _id (id), _E (e), _r (r), _s (s), _x (x), _y (y), _z (z) { }
 
   int_t                 ID      () const { return _id; } 
+  const Element*        elmt    () const { return _E;  }
+  real_t                r       () const { return _r;  }
+  real_t                s       () const { return _s;  }
+  real_t                z       () const { return _z;  }
   void                  extract (vector<AuxField*>&, real_t*) const;
   static const Element* locate  (const real_t, const real_t,
 				 vector<Element*>&, real_t&, real_t&);
@@ -5,6 +5,11 @@
 // Coefficients for all schemes can be found in Gear's book, "Numerical
 // Initial Value Problems in Ordinary Differential Equations", 1971.
 //
+// Variable-step versions of the stiffly-stable and extrapolation
+// coefficients are made from Lagrange interpolants through time
+// levels spaced as recorded by setStep.  Where the steps involved are
+// all the same, they return the fixed-step coefficients exactly.
+//
 // Copyright (c) 1994+, Hugh M Blackburn
 ///////////////////////////////////////////////////////////////////////////////
 
@@ -12,6 +17,8 @@
 
 
 const int_t Integration::OrderMax = 4;
+real_t      Integration::_h[Integration::OrderMax + 1];
+int_t       Integration::_nh = 0;
 
 
 void Integration::StifflyStable (const int_t n    ,
@@ -142,3 +149,96 @@ void Integration::AdamsMoulton (const int_t n    ,
     break;
   }
 }
+
+
+void Integration::setStep (const real_t dt)
+// ---------------------------------------------------------------------------
+// Record dt as the size of the time step just begun.
+// ---------------------------------------------------------------------------
+{
+  int_t q;
+
+  _nh = min (_nh + 1, OrderMax + 1);
+  for (q = _nh - 1; q > 0; q--) _h[q] = _h[q - 1];
+  _h[0] = dt;
+}
+
+
+real_t Integration::step (const int_t lag)
+// ---------------------------------------------------------------------------
+// Size of the step lag steps before the current one (lag = 0).  If
+// none was recorded, return D_T.
+// ---------------------------------------------------------------------------
+{
+  return (lag < _nh) ? _h[lag] : Femlib::value ("D_T");
+}
+
+
+bool Integration::constantStep (const int_t n  ,
+				const int_t lag)
+// ---------------------------------------------------------------------------
+// True if the n recorded steps from lag back were all the same size.
+// ---------------------------------------------------------------------------
+{
+  int_t q;
+
+  for (q = lag + 1; q < min (lag + n, _nh); q++)
+    if (_h[q] != _h[lag]) return false;
+
+  return true;
+}
+
+
+void Integration::StifflyStable (const int_t n    ,
+				 const int_t lag  ,
+				 real_t*     coeff)
+// ---------------------------------------------------------------------------
+// Variable-step stiffly-stable coefficients of order n for the time
+// level that ends step lag (lag = 0: the current step), using that
+// and the n-1 preceding recorded steps.  As for the fixed-step case,
+// d/dt = sum (coeff[q] * u[q]) / step (lag), with u[0] the newest.
+// ---------------------------------------------------------------------------
+{
+  if (constantStep (n, lag)) { StifflyStable (n, coeff); return; }
+
+  real_t tau[OrderMax + 1];
+  int_t  j, m;
+
+  for (tau[0] = 0.0, j = 1; j <= n; j++)
+    tau[j] = tau[j - 1] - step (lag + j - 1) / step (lag);
+
+  // -- Derivatives of the Lagrange interpolants at tau[0].
+
+  for (coeff[0] = 0.0, m = 1; m <= n; m++) coeff[0] -= 1.0 / tau[m];
+
+  for (j = 1; j <= n; j++) {
+    coeff[j] = 1.0 / tau[j];
+    for (m = 1; m <= n; m++)
+      if (m != j) coeff[j] *= -tau[m] / (tau[j] - tau[m]);
+  }
+}
+
+
+void Integration::Extrapolation (const int_t n    ,
+				 const int_t lag  ,
+				 real_t*     coeff)
+// ---------------------------------------------------------------------------
+// Variable-step coefficients of order n for explicit extrapolation to
+// the end of step lag from the n preceding time levels, cf.
+// StifflyStable above.
+// ---------------------------------------------------------------------------
+{
+  if (constantStep (n, lag)) { Extrapolation (n, coeff); return; }
+
+  real_t tau[OrderMax + 1];
+  int_t  j, m;
+
+  for (tau[0] = 0.0, j = 1; j <= n; j++)
+    tau[j] = tau[j - 1] - step (lag + j - 1) / step (lag);
+
+  for (j = 1; j <= n; j++) {
+    coeff[j - 1] = 1.0;
+    for (m = 1; m <= n; m++)
+      if (m != j) coeff[j - 1] *= -tau[m] / (tau[j] - tau[m]);
+  }
+}
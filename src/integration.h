@@ -13,6 +13,18 @@ public:
   static void AdamsMoulton   (const int_t, real_t*);
   static void StifflyStable  (const int_t, real_t*);
   static void Extrapolation  (const int_t, real_t*);
+
+  // -- Variable time step: record of recent step sizes and coefficients.
+
+  static void   setStep       (const real_t);
+  static real_t step          (const int_t);
+  static bool   constantStep  (const int_t, const int_t = 0);
+  static void   StifflyStable (const int_t, const int_t, real_t*);
+  static void   Extrapolation (const int_t, const int_t, real_t*);
+
+private:
+  static real_t _h[];		// -- Recent step sizes, most recent first.
+  static int_t  _nh;		// -- Number recorded (at most OrderMax + 1).
 };
 
 #endif
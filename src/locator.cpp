@@ -0,0 +1,178 @@
+///////////////////////////////////////////////////////////////////////////////
+// locator.cpp: find the Element containing a 2D point, using a
+// uniform-grid bucket index of element bounding boxes.
+//
+// Element::locate does a Newton--Raphson solve for the (r, s)
+// coordinates of an (x, y) point, and is comparatively expensive.
+// Previously callers tried it on each element in turn until one
+// succeeded, i.e. O(nel) N--R solves per lookup.  Here each lookup
+// only visits the elements whose (inflated) bounding boxes contain
+// the point, which is typically one to four of them.
+//
+// See also history.cpp, particle.cpp, utility/interp.cpp, probe.cpp.
+///////////////////////////////////////////////////////////////////////////////
+
+#include <sem.h>
+#include <algorithm>
+
+static const real_t INFLATE = 0.1; // -- Box growth, fraction of box size.
+
+
+static inline int_t bucket (const real_t x ,
+			    const real_t x0,
+			    const real_t dx,
+			    const int_t  n )
+// ---------------------------------------------------------------------------
+// Index of the bucket in a row of n, starting at x0 and of width dx,
+// into which x falls.  Out-of-range values go to the end buckets.
+// ---------------------------------------------------------------------------
+{
+  const int_t i = static_cast<int_t>(floor ((x - x0) / dx));
+
+  return (i < 0) ? 0 : (i >= n) ? n - 1 : i;
+}
+
+
+Locator::Locator (const vector<Element*>& Esys) :
+// ---------------------------------------------------------------------------
+// Compute element bounding boxes and sort them into buckets.  The
+// bucket grid has about as many cells as there are elements, with
+// its aspect ratio set from the extent of the mesh.
+// ---------------------------------------------------------------------------
+  _elmt (Esys),
+  _box  (4 * Esys.size()),
+  _nbr  (Esys.size()),
+  _work (max (2*Geometry::nTotElmt(), 5*Geometry::nP() + 6))
+{
+  const int_t NEL = _elmt.size();
+  int_t       i, j, k, m, n, i0, i1, j0, j1;
+  real_t      *b, xmax, ymax, dx, dy;
+
+  _nx = _ny = 1;
+  _xmin = _ymin = 0.0;
+  _dx = _dy = 1.0;
+
+  if (!NEL) return;
+
+  for (k = 0; k < NEL; k++) {
+    b = &_box[4*k];
+    _elmt[k] -> extent (b[0], b[1], b[2], b[3]);
+    dx = INFLATE * max (b[1] - b[0], b[3] - b[2]) + EPSSP;
+    b[0] -= dx; b[1] += dx; b[2] -= dx; b[3] += dx;
+  }
+
+  _xmin = _box[0]; xmax = _box[1];
+  _ymin = _box[2]; ymax = _box[3];
+  for (k = 1; k < NEL; k++) {
+    b = &_box[4*k];
+    _xmin = min (_xmin, b[0]); xmax = max (xmax, b[1]);
+    _ymin = min (_ymin, b[2]); ymax = max (ymax, b[3]);
+  }
+
+  dx  = xmax - _xmin;
+  dy  = ymax - _ymin;
+  _nx = max (_nx, min (static_cast<int_t>(sqrt (NEL*dx/dy) + 0.5), 4*NEL));
+  _ny = max (_ny, min (static_cast<int_t>(NEL/real_t(_nx) + 0.5),  4*NEL));
+  _dx = dx / _nx;
+  _dy = dy / _ny;
+
+  _cell.resize (_nx * _ny);
+
+  for (k = 0; k < NEL; k++) {
+    b  = &_box[4*k];
+    i0 = bucket (b[0], _xmin, _dx, _nx);
+    i1 = bucket (b[1], _xmin, _dx, _nx);
+    j0 = bucket (b[2], _ymin, _dy, _ny);
+    j1 = bucket (b[3], _ymin, _dy, _ny);
+    for (j = j0; j <= j1; j++)
+      for (i = i0; i <= i1; i++)
+	_cell[j * _nx + i].push_back (k);
+  }
+
+  // -- Neighbours of each element are those with overlapping boxes.
+
+  for (k = 0; k < _cell.size(); k++)
+    for (m = 0; m < _cell[k].size(); m++) {
+      i = _cell[k][m];
+      b = &_box[4*i];
+      for (n = 0; n < _cell[k].size(); n++) {
+	j = _cell[k][n];
+	if (j == i) continue;
+	if (_box[4*j] > b[1] || _box[4*j+1] < b[0] ||
+	    _box[4*j+2] > b[3] || _box[4*j+3] < b[2]) continue;
+	if (find (_nbr[i].begin(), _nbr[i].end(), j) == _nbr[i].end())
+	  _nbr[i].push_back (j);
+      }
+    }
+}
+
+
+Element* Locator::locate (const real_t   x   ,
+			  const real_t   y   ,
+			  real_t&        r   ,
+			  real_t&        s   ,
+			  const Element* hint) const
+// ---------------------------------------------------------------------------
+// Return the Element that contains (x, y), and the corresponding r, s
+// location within it, or 0 if the point isn't in the mesh.
+//
+// If hint is non-zero, it is tried first, with the input values of
+// r, s as initial guess for N--R iteration, then its neighbours.
+// ---------------------------------------------------------------------------
+{
+  const int_t NEL  = _elmt.size();
+  int_t       i, k, c, h = -1;
+
+  if (hint && (h = hint -> ID()) >= 0 && h < NEL && _elmt[h] == hint) {
+    if (tryElmt (h, x, y, r, s, false)) return _elmt[h];
+    for (i = 0; i < _nbr[h].size(); i++) {
+      k = _nbr[h][i];
+      if (tryElmt (k, x, y, r, s, true)) return _elmt[k];
+    }
+  } else
+    h = -1;
+
+  if (x < _xmin || x > _xmin + _nx * _dx ||
+      y < _ymin || y > _ymin + _ny * _dy) return 0;
+
+  c = bucket (y, _ymin, _dy, _ny) * _nx + bucket (x, _xmin, _dx, _nx);
+  for (i = 0; i < _cell[c].size(); i++) {
+    k = _cell[c][i];
+    if (h >= 0 && (k == h ||
+		   find (_nbr[h].begin(), _nbr[h].end(), k) != _nbr[h].end()))
+      continue;
+    if (tryElmt (k, x, y, r, s, true)) return _elmt[k];
+  }
+
+  return 0;
+}
+
+
+bool Locator::inBox (const int_t  k,
+		     const real_t x,
+		     const real_t y) const
+// ---------------------------------------------------------------------------
+// Is (x, y) inside the inflated bounding box of element k?
+// ---------------------------------------------------------------------------
+{
+  const real_t* b = &_box[4*k];
+
+  return x >= b[0] && x <= b[1] && y >= b[2] && y <= b[3];
+}
+
+
+bool Locator::tryElmt (const int_t  k    ,
+		       const real_t x    ,
+		       const real_t y    ,
+		       real_t&      r    ,
+		       real_t&      s    ,
+		       const bool   guess) const
+// ---------------------------------------------------------------------------
+// Attempt N--R location of (x, y) in element k, if it's in its box.
+// ---------------------------------------------------------------------------
+{
+  if (!inBox (k, x, y)) return false;
+  if (guess) r = s = 0.0;
+
+  return _elmt[k] -> locate (x, y, r, s, &_work[0], guess);
+}
@@ -0,0 +1,46 @@
+#ifndef LOCATOR_H
+#define LOCATOR_H
+
+
+class Locator
+// ===========================================================================
+// Spatial search index used to find which Element contains a given
+// 2D (x, y) point.
+//
+// Element bounding boxes (slightly inflated to allow for curved
+// sides) are sorted into a uniform grid of buckets covering the mesh,
+// with roughly one bucket per element.  A lookup then only has to try
+// Element::locate (N--R iteration) on the few elements whose boxes
+// contain the point, rather than on every element in turn.  If a
+// hint element is supplied (e.g. the one a particle was in on the
+// previous step), it and then its neighbours are tried first.
+// ===========================================================================
+{
+public:
+  Locator (const vector<Element*>&);
+  ~Locator () { }
+
+  Element* locate (const real_t, const real_t, real_t&, real_t&,
+		   const Element* = 0)             const;
+  bool     built  (const vector<Element*>& E) const
+  { return &E == &_elmt && E.size() == _box.size() / 4; }
+
+private:
+  const vector<Element*>& _elmt;  // Elements indexed.
+  vector<real_t>          _box ;  // Inflated bounding boxes, 4 per element.
+  vector<vector<int_t> >  _cell;  // Element indices for each bucket.
+  vector<vector<int_t> >  _nbr ;  // Elements whose boxes touch each box.
+  int_t                   _nx  ;  // Number of buckets in x.
+  int_t                   _ny  ;  // Number of buckets in y.
+  real_t                  _xmin;  // Origin of bucket grid.
+  real_t                  _ymin;
+  real_t                  _dx  ;  // Bucket size in x.
+  real_t                  _dy  ;  // Bucket size in y.
+  mutable vector<real_t>  _work;  // Work area for Element::locate.
+
+  bool inBox  (const int_t, const real_t, const real_t) const;
+  bool tryElmt(const int_t, const real_t, const real_t, real_t&, real_t&,
+	       const bool) const;
+};
+
+#endif
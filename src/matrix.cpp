@@ -9,6 +9,25 @@
 static vector<MatrixSys*> MS;
 
 
+static float* demote (const int_t n  ,
+		      real_t*&    src)
+// ---------------------------------------------------------------------------
+// Return a single-precision copy of src (which may be null), delete
+// src and set it to null.
+// ---------------------------------------------------------------------------
+{
+  if (!src) return 0;
+
+  float* tgt = new float [static_cast<size_t>(n)];
+
+  copy (src, src + n, tgt);
+  Storage::release (src);
+  src = 0;
+
+  return tgt;
+}
+
+
 ModalMatrixSys::ModalMatrixSys (const real_t            lambda2 ,
                 const AuxField*         VARKINVIS,
 				const real_t            beta    ,
@@ -32,11 +51,22 @@ ModalMatrixSys::ModalMatrixSys (const real_t            lambda2 ,
 //   Bsys    : boundary system for this field,
 //   Nsys    : corresponding numbering system (set of AssemblyMaps), 
 //   method  : specify the kind of solver we want (Cholesky, PCG ...).
+//
+// For PCG solution, the preconditioner is chosen by token PRECON_P
+// for the pressure and PRECON for all other fields:
+//   0 : diagonal (Jacobi)          --> JACPCG,
+//   1 : two-level Schwarz          --> SCHPCG.
+//
+// With VERBOSE set, a summary of Family storage sharing (which
+// includes the element Helmholtz matrices) is printed afterwards.
 // ---------------------------------------------------------------------------
 {
-  const char name = Bsys -> field();
-  int_t      mode;
-  bool       found;
+  const char       name = Bsys -> field();
+  const SolverKind pcg  =
+    (Femlib::ivalue ((name == 'p') ? "PRECON_P" : "PRECON")) ? SCHPCG : JACPCG;
+  int_t            mode;
+  bool             found;
+  SolverKind       kind;
 
   MatrixSys* M;
   vector<MatrixSys*>::iterator m;
@@ -57,6 +87,9 @@ ModalMatrixSys::ModalMatrixSys (const real_t            lambda2 ,
     const real_t       betak2    = sqr  (Field::modeConstant(name,mode,beta));
     const int_t        localMode = mode - baseMode;
 
+    kind = (method == MIXED) ? ((mode == 0) ? DIRECT : JACPCG) : method;
+    if (kind == JACPCG) kind = pcg;
+
     // -- Multiply Helmholtz constant with SVV-specific weight:
     //    betak2_svv = betak2 * (1 + eps_N/nu * Q) for modes k > SVV_MZ
     //    and lambda2 > 0 (i.e. only for the velocity components).
@@ -66,19 +99,14 @@ ModalMatrixSys::ModalMatrixSys (const real_t            lambda2 ,
 
     for (found = false, m = MS.begin(); !found && m != MS.end(); m++) {
       M     = *m;
-      found = M -> match (lambda2, betak2_svv, Assy, method);
+      found = M -> match (lambda2, betak2_svv, Assy, kind);
     }
     if (found) {
       _Msys[localMode] = M;
       if (method == DIRECT) { cout << '.'; cout.flush(); }
     } else {
-      if (method == MIXED)
-	_Msys[localMode] =
-	  new MatrixSys (lambda2, VARKINVIS, betak2_svv, modeIndex, Elmt, Bsys, Assy,
-			 (mode == 0) ? DIRECT : JACPCG);
-      else 
-	_Msys[localMode] =
-	  new MatrixSys (lambda2, VARKINVIS, betak2_svv,modeIndex,Elmt, Bsys, Assy, method);
+      _Msys[localMode] =
+	new MatrixSys (lambda2, VARKINVIS, betak2_svv, modeIndex, Elmt, Bsys, Assy, kind);
 
       MS.insert (MS.end(), _Msys[localMode]);
       if (method == DIRECT) { cout << '*'; cout.flush(); }
@@ -92,6 +120,8 @@ ModalMatrixSys::ModalMatrixSys (const real_t            lambda2 ,
     ROOTONLY cout << "]" << endl;
     cout.flush();
   }
+
+  if (Femlib::ivalue ("VERBOSE")) ROOTONLY Family::report (cout);
 }
 
 
@@ -133,9 +163,18 @@ MatrixSys::MatrixSys (const real_t            lambda2,
 // For method == DIRECT:
 //   Matrices are assembled using LAPACK-compatible ordering systems.
 //   Global Helmholtz matrix uses symmetric-banded format; elemental
-//   Helmholtz matrices (hii & hbi) use column-major formats.
+//   Helmholtz matrices (hii & hbi) use column-major formats.  If token
+//   MIXED_PREC is set, matrices are built and factored in double
+//   precision but stored in single precision, see MatrixSys::solve.
+//   If token SPARSE_CHOL is set, the global matrix is instead held
+//   and factored by SparseChol (nested-dissection ordering), which
+//   for large unstructured meshes needs much less storage and work
+//   than banded LAPACK; it is always kept in double precision.
 // For method == JACPCG:
 //   Build and invert diagonal preconditioner matrix.
+// For method == SCHPCG:
+//   As for JACPCG, then also build the local and coarse parts of the
+//   two-level Schwarz preconditioner, see buildSchwarz.
 //
 // The Fourier-modal dependence of BCs and numbering is only really
 // relevant for cylindrical systems (and at the axis); for Cartesian
@@ -160,8 +199,17 @@ MatrixSys::MatrixSys (const real_t            lambda2,
   _hii               (0),
   _bipack            (0),
   _iipack            (0),
+  _LS                (0),
+  _Hf                (0),
+  _hbif              (0),
+  _hiif              (0),
   _npts              (_nglobal + Geometry::nInode()),
-  _PC                (0)
+  _PC                (0),
+  _ncoarse           (0),
+  _cband             (0),
+  _H0                (0),
+  _cmap              (0),
+  _cwgt              (0)
 {
   const char     routine[] = "MatrixSys::MatrixSys";
   const int_t    verbose   = Femlib::ivalue ("VERBOSE");
@@ -187,23 +235,38 @@ MatrixSys::MatrixSys (const real_t            lambda2,
     real_t*        rwrk = rmat + sqr (np);
     int_t*         ipiv = &pivotmap[0];
     int_t          info;
+    const bool     single = Femlib::ivalue ("MIXED_PREC")  > 0;
+    const bool     sparse = Femlib::ivalue ("SPARSE_CHOL") > 0;
+    clock_t        tfact;
 
     _hbi    = new real_t*[static_cast<size_t>(_nel)];
     _hii    = new real_t*[static_cast<size_t>(_nel)];
     _bipack = new int_t  [static_cast<size_t>(_nel)];
     _iipack = new int_t  [static_cast<size_t>(_nel)];
 
+    if (single) {
+      _hbif = new float* [static_cast<size_t>(_nel)];
+      _hiif = new float* [static_cast<size_t>(_nel)];
+    }
+
     if (_nsolve) {
-      _H = new real_t [static_cast<size_t>(_npack)];
-      Veclib::zero (_npack, _H, 1);
+      if (sparse)
+	_LS = new SparseChol (_AM, _nsolve);
+      else {
+	_H = Storage::allocate (_npack);
+      }
 
       if (verbose > 1)
 	cout << endl
 	     << "Helmholtz constant (lambda2): " << setw(10) << lambda2
 	     << ", Fourier constant (betak2): "  << setw(10) << betak2;
-      if (verbose)
+      if (verbose && sparse)
+	cout << endl << "System matrix: " << _nsolve << "x" << _nsolve
+	     << " sparse\t(" << _LS -> words() << " words, banded "
+	     << _npack << ")";
+      else if (verbose)
 	cout << endl << "System matrix: " << _nsolve << "x" << _nband
-	     << "\t(" << _npack << " words)";
+	     << "\t(" << _npack << ((single) ? " single" : "") << " words)";
     }
 
     // -- Loop over elements, creating & posting elemental Helmholtz matrices.
@@ -213,10 +276,8 @@ MatrixSys::MatrixSys (const real_t            lambda2,
       _iipack[j] = nint * nint;
 
       if (nint) {
-	_hbi[j] = new real_t [static_cast<size_t>(_bipack[j])];
-	_hii[j] = new real_t [static_cast<size_t>(_iipack[j])];
-	Veclib::zero (_bipack[j], _hbi[j], 1);
-	Veclib::zero (_iipack[j], _hii[j], 1);
+	_hbi[j] = Storage::allocate (_bipack[j]);
+	_hii[j] = Storage::allocate (_iipack[j]);
       } else
 	_hbi[j] = _hii[j] = 0;
       
@@ -228,45 +289,89 @@ MatrixSys::MatrixSys (const real_t            lambda2,
       for (i = 0; i < next; i++)
 	if ((m = bmap[i]) < _nsolve)
 	  for (k = 0; k < next; k++)
-	    if ((n = bmap[k]) < _nsolve && n >= m)
-	      _H[Lapack::band_addr (m, n, _nband)] +=
-		hbb[Veclib::row_major (i, k, next)];
-
-      Family::adopt (_bipack[j], _hbi + j);
-      Family::adopt (_iipack[j], _hii + j);
+	    if ((n = bmap[k]) < _nsolve && n >= m) {
+	      if (_LS)
+		_LS -> add (m, n, hbb[Veclib::row_major (i, k, next)]);
+	      else
+		_H[Lapack::band_addr (m, n, _nband)] +=
+		  hbb[Veclib::row_major (i, k, next)];
+	    }
+
+      if (single) {
+	_hbif[j] = demote (_bipack[j], _hbi[j]);
+	_hiif[j] = demote (_iipack[j], _hii[j]);
+	Family::adopt (_bipack[j], _hbif + j);
+	Family::adopt (_iipack[j], _hiif + j);
+      } else {
+	Family::adopt (_bipack[j], _hbi + j);
+	Family::adopt (_iipack[j], _hii + j);
+      }
+    }
 
+    if (single) {
+      delete[] _hbi; _hbi = 0;
+      delete[] _hii; _hii = 0;
     }
+
     if (_nsolve) {
       // -- Loop over BCs and add diagonal contribution from mixed BCs.
 
       if (bsys -> mixBC()) {
 	const int_t  nbound = bsys -> nSurf();
 	const int_t* bmap   = _AM  -> btog();
-	for (i = 0; i < nbound; i++)
-	  _BC[i] -> augmentSC (_nband, _nsolve, bmap, rwrk, _H);
+	if (_LS) {
+	  vector<real_t> diag (_nglobal, 0.0);
+	  for (i = 0; i < nbound; i++)
+	    _BC[i] -> augmentDg (bmap, &diag[0]);
+	  for (i = 0; i < _nsolve; i++)
+	    if (diag[i] != 0.0) _LS -> add (i, i, diag[i]);
+	} else
+	  for (i = 0; i < nbound; i++)
+	    _BC[i] -> augmentSC (_nband, _nsolve, bmap, rwrk, _H);
       }
 
-      // -- Cholesky factor global banded-symmetric Helmholtz matrix.
-    
-      Lapack::pbtrf ("U", _nsolve, _nband-1, _H, _nband, info);
+      // -- Cholesky factor global Helmholtz matrix.
+
+      tfact = clock();
+
+      if (_LS)
+	info = (_LS -> factor()) ? 0 : 1;
+      else
+	Lapack::pbtrf ("U", _nsolve, _nband-1, _H, _nband, info);
+
+      tfact = clock() - tfact;
 
       if (info) Veclib::alert
 		  (routine, "failed to factor Helmholtz matrix", ERROR);
 
-      Family::adopt (_npack, &_H);
-
-      if (verbose) {
+      if (verbose && _LS) {
+	double bflops = 0.0;
+	for (i = 0; i < _nsolve; i++) bflops += sqr (min (_nband, _nsolve - i));
+	cout << ", factor flops: " << _LS -> flops() << " (banded " << bflops
+	     << "), time: " << tfact / static_cast<double>(CLOCKS_PER_SEC)
+	     << "s" << endl;
+      } else if (verbose) {
 	real_t cond;
 	pivotmap.resize (_nsolve);  ipiv = &pivotmap[0];
 	work.resize (3 * _nsolve);  rwrk = &work[0];
 
 	Lapack::pbcon ("U",_nsolve,_nband-1,_H,_nband,1.0,cond,rwrk,ipiv,info);
-	cout << ", (inverse) condition number: " << cond << endl;
+	cout << ", factor time: " << tfact / static_cast<double>(CLOCKS_PER_SEC)
+	     << "s, (inverse) condition number: " << cond << endl;
+      }
+
+      if (_H) {			// -- The sparse factor stays as it is.
+	if (single) {
+	  _Hf = demote (_npack, _H);
+	  Family::adopt (_npack, &_Hf);
+	} else
+	  Family::adopt (_npack, &_H);
       }
     }
   } break;
 
-  case JACPCG: {
+  case JACPCG:
+  case SCHPCG: {
     const int_t    nbound = _BC.size();   
     real_t*        PCi;
     vector<real_t> work (2 * npnp + np);
@@ -278,9 +383,7 @@ MatrixSys::MatrixSys (const real_t            lambda2,
 	   << ", Fourier const (betak2): "  << setw(10) << betak2 << endl;
 
 
-    _PC = new real_t [static_cast<size_t>(_npts)];
-
-    Veclib::zero (_npts, _PC, 1);
+    _PC = Storage::allocate (_npts);
 
     PCi  = _PC + _AM -> nGlobal();
     bmap = _AM -> btog();
@@ -307,6 +410,8 @@ MatrixSys::MatrixSys (const real_t            lambda2,
 
     Family::adopt (_npts, &_PC);
 
+    if (_method == SCHPCG) this -> buildSchwarz (lambda2, VARKINVIS, betak2, elmt);
+
   } break;
 
   default:
@@ -341,6 +446,245 @@ bool MatrixSys::match (const real_t       lambda2,
 }
 
 
+void MatrixSys::buildSchwarz (const real_t            lambda2  ,
+			      const AuxField*         VARKINVIS,
+			      const real_t            betak2   ,
+			      const vector<Element*>& elmt     )
+// ---------------------------------------------------------------------------
+// Set up the two-level additive Schwarz preconditioner
+//                           T  -1                 T
+//   M^-1 = D^-1 + sum_e R  A     R  +  P A0^-1 P ,
+//                        e  ii,e  e
+// where D is the (already built) diagonal, used for the element-
+// boundary nodes only, the second term is an exact solve for the
+// internal nodes of each element (inverses of the internal-internal
+// partitions of the elemental Helmholtz matrices, as produced for
+// static condensation), and the third is a coarse-grid correction on
+// the bilinear (N_P = 2) vertex space, with prolongation P and
+// Galerkin coarse matrix A0 = P^T A P.  The coarse space takes care
+// of the long-wavelength error components that make iteration counts
+// grow with mesh size, the local solves those internal to elements.
+//
+// Vertices on essential-BC boundaries are excluded from the coarse
+// space; for a singular system the highest-numbered one is too.  The
+// (banded) coarse matrix is Cholesky factored: if that fails, e.g. as
+// a result of mixed BCs that are not represented in A0, the coarse
+// level is dropped.
+// ---------------------------------------------------------------------------
+{
+  const char     routine[] = "MatrixSys::buildSchwarz";
+  const int_t    np        = Geometry::nP();
+  const int_t    next      = Geometry::nExtElmt();
+  const int_t    nint      = Geometry::nIntElmt();
+  const int_t    npnp      = Geometry::nTotElmt();
+  const int_t*   bmap;
+  vector<real_t> work (sqr (next) + next * nint + sqr (np) + sqr (npnp));
+  vector<real_t> basis (4 * npnp + 16 + 5 * npnp + np);
+  vector<int_t>  ipiv  (max (nint, static_cast<int_t>(1)));
+  vector<int_t>  cid   (_nglobal, -1);
+  vector<bool>   done  (_npts, false);
+  real_t         *hbb  = &work[0], *hbi = hbb + sqr (next);
+  real_t         *rmat = hbi + next * nint, *rwrk = rmat + sqr (np);
+  real_t         *phi  = &basis[0], *h0 = phi + 4 * npnp, *bwrk = h0 + 16;
+  int_t          i, j, k, m, g, c[4], cmin, cmax, info;
+
+  // -- Inverses of element-internal partitions.
+
+  _hii    = new real_t* [static_cast<size_t>(_nel)];
+  _iipack = new int_t   [static_cast<size_t>(_nel)];
+
+  for (j = 0; j < _nel; j++) {
+    _iipack[j] = nint * nint;
+    if (nint) {
+      _hii[j] = Storage::allocate (_iipack[j]);
+      elmt[j] -> HelmholtzSC (lambda2, VARKINVIS->getData()+elmt[j]->ID()*npnp,
+			      betak2, hbb, hbi, _hii[j], rmat, rwrk, &ipiv[0]);
+      Family::adopt (_iipack[j], _hii + j);
+    } else _hii[j] = 0;
+  }
+
+  // -- Number the coarse unknowns in global-node order.
+
+  for (bmap = _AM -> btog(), j = 0; j < _nel; j++, bmap += next)
+    for (k = 0; k < 4; k++)
+      if ((g = bmap[k * (np - 1)]) < _nsolve) cid[g] = 0;
+
+  for (g = 0; g < _nglobal; g++) if (cid[g] == 0) cid[g] = _ncoarse++;
+
+  if (_singular && _ncoarse)
+    for (g = _nglobal - 1; g >= 0; g--)
+      if (cid[g] == _ncoarse - 1) { cid[g] = -1; _ncoarse--; break; }
+
+  if (!_ncoarse) return;
+
+  // -- Prolongation (each meshpoint is set from the first element
+  //    containing it, the vertex basis being continuous) and bandwidth.
+
+  _cmap = new int_t  [static_cast<size_t>(4 * _npts)];
+  _cwgt = Storage::allocate (4 * _npts);
+
+  Veclib::fill (4 * _npts, -1,  _cmap, 1);
+
+  for (bmap = _AM -> btog(), j = 0; j < _nel; j++, bmap += next) {
+    cmin = _ncoarse; cmax = 0;
+    for (k = 0; k < 4; k++)
+      if ((c[k] = cid[bmap[k * (np - 1)]]) >= 0) {
+	cmin = min (cmin, c[k]);
+	cmax = max (cmax, c[k]);
+      }
+    _cband = max (_cband, cmax - cmin + 1);
+
+    elmt[j] -> vertexHelmholtz (lambda2, VARKINVIS->getData()+elmt[j]->ID()*npnp,
+				betak2, phi, h0, bwrk);
+
+    for (m = 0; m < npnp; m++) {
+      g = (m < next) ? bmap[m] : _nglobal + j * nint + m - next;
+      if ((m < next && g >= _nsolve) || done[g]) continue;
+      for (k = 0; k < 4; k++) {
+	_cmap[4 * g + k] = c[k];
+	_cwgt[4 * g + k] = (c[k] >= 0) ? phi[k * npnp + m] : 0.0;
+      }
+      done[g] = true;
+    }
+  }
+
+  // -- Assemble and factor coarse matrix.
+
+  _H0 = Storage::allocate (_cband * _ncoarse);
+
+  for (bmap = _AM -> btog(), j = 0; j < _nel; j++, bmap += next) {
+    for (k = 0; k < 4; k++) c[k] = cid[bmap[k * (np - 1)]];
+    elmt[j] -> vertexHelmholtz (lambda2, VARKINVIS->getData()+elmt[j]->ID()*npnp,
+				betak2, phi, h0, bwrk);
+    for (i = 0; i < 4; i++)
+      if (c[i] >= 0)
+	for (k = 0; k < 4; k++)
+	  if (c[k] >= c[i])
+	    _H0[Lapack::band_addr (c[i], c[k], _cband)] += h0[4 * i + k];
+  }
+
+  Lapack::pbtrf ("U", _ncoarse, _cband - 1, _H0, _cband, info);
+
+  if (info) {
+    Veclib::alert (routine, "coarse matrix not positive definite, "
+		   "using one-level preconditioner", WARNING);
+    Storage::release (_H0);   _H0   = 0;
+    delete[]          _cmap;  _cmap = 0;
+    Storage::release (_cwgt); _cwgt = 0;
+    _ncoarse = 0;
+  }
+
+  if (Femlib::ivalue ("VERBOSE") > 1)
+    cout << "Schwarz coarse system: " << _ncoarse << "x" << _cband << endl;
+}
+
+
+void MatrixSys::precon (const real_t* r,
+			real_t*       z) const
+// ---------------------------------------------------------------------------
+// Apply preconditioner to residual r (global ordering, length _npts)
+// to produce z.
+// ---------------------------------------------------------------------------
+{
+  Veclib::vmul (_npts, _PC, 1, r, 1, z, 1);
+
+  if (_method != SCHPCG) return;
+
+  const int_t nint = Geometry::nIntElmt();
+  int_t       i, j, k, c, info;
+
+  // -- Exact solves for element-internal nodes replace diagonal there.
+
+  if (nint)
+    for (j = 0; j < _nel; j++) {
+      const int_t offset = _nglobal + j * nint;
+      Blas::gemv ("T", nint, nint, 1.0, _hii[j], nint,
+		  r + offset, 1, 0.0, z + offset, 1);
+    }
+
+  // -- Coarse-grid correction.
+
+  if (_ncoarse) {
+    Workspace::Vector rc (_ncoarse);
+
+    Veclib::zero (_ncoarse, &rc[0], 1);
+
+    for (i = 0; i < _npts; i++)
+      for (k = 0; k < 4; k++)
+	if ((c = _cmap[4 * i + k]) >= 0) rc[c] += _cwgt[4 * i + k] * r[i];
+
+    Lapack::pbtrs ("U", _ncoarse, _cband - 1, 1, _H0, _cband,
+		   &rc[0], _ncoarse, info);
+
+    for (i = 0; i < _npts; i++)
+      for (k = 0; k < 4; k++)
+	if ((c = _cmap[4 * i + k]) >= 0) z[i] += _cwgt[4 * i + k] * rc[c];
+  }
+}
+
+
+void MatrixSys::solve (const real_t* r,
+		       real_t*       e) const
+// ---------------------------------------------------------------------------
+// Solve A e = r by static condensation using the single-precision
+// factors of a DIRECT system built with token MIXED_PREC set (the
+// global factor remains double if token SPARSE_CHOL is also set).  Vectors
+// r and e have the global ordering of Field::HelmholtzOperator; on
+// exit the essential-BC partition of e is zero.  As arithmetic is
+// single precision, e is only an approximation, used as a correction
+// in the iterative refinement of Field::solve.
+// ---------------------------------------------------------------------------
+{
+  const int_t    next = Geometry::nExtElmt();
+  const int_t    nint = Geometry::nIntElmt();
+  const int_t*   btog;
+  const real_t*  ri;
+  real_t*        ei;
+  int_t          i, j, info;
+  Workspace::FloatVector work (_nglobal + next + 2 * nint);
+  float          *eb = &work[0], *wb = eb + _nglobal, *wi = wb + next;
+  float          *wo = wi + nint;
+
+  copy (r, r + _nglobal, eb);
+
+  // -- Condense internal residuals onto element boundaries.
+
+  if (nint)
+    for (btog = _AM -> btog(), ri = r + _nglobal, j = 0; j < _nel;
+	 j++, btog += next, ri += nint) {
+      copy (ri, ri + nint, wi);
+      Blas::gemv ("T", nint, next, 1.0f, _hbif[j], nint, wi, 1, 0.0f, wb, 1);
+      for (i = 0; i < next; i++) eb[btog[i]] -= wb[i];
+    }
+
+  // -- Solve for element-boundary values.
+
+  fill (eb + _nsolve, eb + _nglobal, 0.0f);
+
+  if (_LS) {			// -- Sparse global factor is double.
+    Workspace::Vector xb (_nsolve);
+    copy (eb, eb + _nsolve, &xb[0]);
+    _LS -> solve (&xb[0]);
+    copy (&xb[0], &xb[0] + _nsolve, eb);
+  } else if (_nsolve)
+    Lapack::pbtrs ("U", _nsolve, _nband-1, 1, _Hf, _nband, eb, _nglobal, info);
+
+  copy (eb, eb + _nglobal, e);
+
+  // -- Recover element-internal values.
+
+  if (nint)
+    for (btog = _AM -> btog(), ri = r + _nglobal, ei = e + _nglobal, j = 0;
+	 j < _nel; j++, btog += next, ri += nint, ei += nint) {
+      for (i = 0; i < next; i++) wb[i] = eb[btog[i]];
+      copy (ri, ri + nint, wi);
+      Blas::gemv ("T", nint, nint,  1.0f, _hiif[j], nint, wi, 1, 0.0f, wo, 1);
+      Blas::gemv ("N", nint, next, -1.0f, _hbif[j], nint, wb, 1, 1.0f, wo, 1);
+      copy (wo, wo + nint, ei);
+    }
+}
+
+
 MatrixSys::~MatrixSys()
 // ---------------------------------------------------------------------------
 // Destructor.  Because there may be aliases to the internal vector
@@ -351,15 +695,38 @@ MatrixSys::~MatrixSys()
   case JACPCG:
     Family::abandon (&_PC);
     break;
+  case SCHPCG: {
+    int_t i;
+    Family::abandon (&_PC);
+    for (i = 0; i < _nel; i++) Family::abandon (_hii + i);
+    delete[] _hii;
+    delete[] _iipack;
+    Storage::release (_H0);
+    delete[] _cmap;
+    Storage::release (_cwgt);
+  } break;
   case DIRECT: {
     int_t i;
-    for (i = 0; i < _nel; i++) {
-      Family::abandon (_hbi + i);
-      Family::abandon (_hii + i);
+    if (_hbif) {
+      for (i = 0; i < _nel; i++) {
+	Family::abandon (_hbif + i);
+	Family::abandon (_hiif + i);
+      }
+      Family::abandon (&_Hf);
+      delete[] _hbif;
+      delete[] _hiif;
+    } else {
+      for (i = 0; i < _nel; i++) {
+	Family::abandon (_hbi + i);
+	Family::abandon (_hii + i);
+      }
+      Family::abandon (&_H);
+      delete[] _hbi;
+      delete[] _hii;
     }
-    Family::abandon (&_H);
     delete[] _bipack;
     delete[] _iipack;
+    delete   _LS;
   } break;
   default:
     break;
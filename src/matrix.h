@@ -5,7 +5,8 @@
 class MatrixSys
 // ===========================================================================
 // System of global and local Helmholtz matrices and partitions.
-// Matrix factorisations are Cholesky, use LAPACK storage schemes.
+// Matrix factorisations are Cholesky, use LAPACK storage schemes
+// (or, for the global matrix if token SPARSE_CHOL > 0, SparseChol).
 // ===========================================================================
 {
 friend class Field;
@@ -16,6 +17,8 @@ public:
  ~MatrixSys  ();
   bool match (const real_t, const real_t, const AssemblyMap*,
 	      const SolverKind) const;
+  void precon (const real_t*, real_t*) const;
+  void solve  (const real_t*, real_t*) const;
 
 private:
   real_t  _HelmholtzConstant;	// Same for all modes.
@@ -39,11 +42,30 @@ private:
   real_t** _hii   ;		// (Factored) internal-internal matrices.
   int_t*   _bipack;		// Size of hbi for each element.
   int_t*   _iipack;		// Size of hii for each element.
+  SparseChol* _LS ;		// Sparse global factor, replaces _H if set.
 
-  // -- For _method == JACPCG:
+  // -- For _method == DIRECT and token MIXED_PREC > 0, single-precision
+  //    copies replace _H, _hbi and _hii, which are then left null:
+
+  float*   _Hf    ;		// Factored packed global Helmholtz matrix.
+  float**  _hbif  ;		// Element external-internal coupling matrices.
+  float**  _hiif  ;		// Factored internal-internal matrices.
+
+  // -- For _method == JACPCG (and SCHPCG):
 
   int_t    _npts;		// Total number of unique meshpoints.
   real_t*  _PC  ;		// Diagonal preconditioner matrix.
+
+  // -- For _method == SCHPCG, also _hii (inverted) and _iipack, plus:
+
+  int_t    _ncoarse;		// Number of coarse (vertex) unknowns.
+  int_t    _cband  ;		// Bandwidth of coarse matrix.
+  real_t*  _H0     ;		// Factored packed coarse Helmholtz matrix.
+  int_t*   _cmap   ;		// Coarse unknowns for each meshpoint (4 each).
+  real_t*  _cwgt   ;		// Corresponding prolongation weights.
+
+  void buildSchwarz (const real_t, const AuxField*, const real_t,
+		     const vector<Element*>&);
 };
 
 ostream& operator << (ostream&, MatrixSys&);
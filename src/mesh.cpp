@@ -91,6 +91,7 @@
 #include <fstream>
 #include <sstream>
 #include <algorithm>
+#include <unordered_map>
 
 using namespace std;
 
@@ -295,10 +296,10 @@ void Mesh::assemble (const bool printVacancy)
 // summarizes the elements that need surface information supplied.
 // ---------------------------------------------------------------------------
 {
-  int_t       i, j, r, s, found;
+  int_t       i, j, r;
   const int_t Ne = nEl();
-  Elmt        *E, *ME;	               // -- M <==> "mate".
-  Side        *S, *MS;
+  Elmt        *E;
+  Side        *S;
 
   // -- First, build Elmt Sides.
 
@@ -312,31 +313,38 @@ void Mesh::assemble (const bool printVacancy)
     }
   }
 
-  // -- Now traverse Elmts and build Side--Side connections based on Node
-  //    identities.  This can't pick up periodic Nodes, not yet installed.
+  // -- Now build Side--Side connections based on Node identities.
+  //    This can't pick up periodic Nodes, not yet installed.
   //    That happens in surfaces().
+  //
+  //    Every Side is hashed on its (startNode, endNode) pair; its mate,
+  //    if any, is the Side stored against the reversed pair.  Where a
+  //    key is repeated (illegal mesh) the first Side in Elmt order is
+  //    kept, as was the case for the previous exhaustive search.
+
+  unordered_map<long, Side*> sideTable (4 * Ne);
+  const long                 Nv = _nodeTable.size();
 
   for (i = 0; i < Ne; i++) {
     E = _elmtTable[i];
     const int_t Nn = E -> nNodes();
+    for (j = 0; j < Nn; j++) {
+      S = E -> side[j];
+      sideTable.insert
+	(make_pair (S -> startNode -> ID * Nv + S -> endNode -> ID, S));
+    }
+  }
 
+  for (i = 0; i < Ne; i++) {
+    E = _elmtTable[i];
+    const int_t Nn = E -> nNodes();
     for (j = 0; j < Nn; j++) {
       S = E -> side[j];
-      found = 0;
-
-      for (r = 0; !found && r < Ne; r++) {
-	ME = _elmtTable[r];
-	const int_t Nm = ME -> nNodes();
-	
-	for (s = 0; !found && s < Nm; s++) {
-	  MS = ME -> side[s];
-
-	  if ((found = ( S  -> startNode == MS -> endNode &&
-			 MS -> startNode ==  S -> endNode ))) {
-	    S -> mateElmt = ME;
-	    S -> mateSide = MS;
-	  }
-	}
+      unordered_map<long, Side*>::const_iterator m =
+	sideTable.find (S -> endNode -> ID * Nv + S -> startNode -> ID);
+      if (m != sideTable.end()) {
+	S -> mateSide = m -> second;
+	S -> mateElmt = m -> second -> thisElmt;
       }
     }
   }
@@ -499,6 +507,8 @@ void Mesh::surfaces ()
       Veclib::alert (routine, err, ERROR);
     }
   }
+
+  this -> fixPeriodic();
 }
 
 
@@ -511,57 +521,27 @@ void Mesh::chooseNode (Node* N1,
 // node is already periodic with something else, so we test for those
 // cases, and choose the lowest Node ID out of available alternatives.
 //
-// There are 9 possible combinations of N1 -> periodic & N1 -> periodic
-// depending on whether they are set or not and whether, if set, they
-// are self-referential or not.  In 5 of these cases, a "dangling" pointer
-// will be left (one that doesn't point to a self-referential periodicity),
-// and these cases have to be fixed by a call to fixPeriodic.
+// Each set of mutually periodic Nodes is held as a tree of periodic
+// pointers whose root is the lowest-numbered Node of the set, which
+// points to itself.  Here the roots for N1 and N2 are found, the
+// lower-numbered of the two becomes the root of the merged set, and
+// the paths from N1 and N2 are compressed onto it.  Other Nodes may
+// still be left pointing at a former root: fixPeriodic, called once
+// when all surfaces have been read, resolves them.
 // ---------------------------------------------------------------------------
 {
-  Node* PN = 0;
-
-  if (!N1->periodic)
-    if (!N2->periodic) {
-      PN = (N1->ID < N2->ID) ? N1 : N2;
-      N1->periodic = N2->periodic = PN;
-    } else if (N2->periodic != N2) {
-      PN = (N1->ID < N2->periodic->ID) ? N1 : N2->periodic;
-      N1->periodic = N2->periodic = N2->periodic->periodic = PN;
-    } else {
-      PN = (N1->ID < N2->ID) ? N1 : N2;
-      N1->periodic = N2->periodic = PN;
-      this -> fixPeriodic();
-    }
-  else if (N1->periodic != N1)
-    if (!N2->periodic) {
-      PN = (N1->periodic->ID < N2->ID) ? N1->periodic : N2;
-      N2->periodic = N1->periodic = N1->periodic->periodic = PN;
-    } else if (N2->periodic != N2) {
-      PN = (N1->periodic->ID < N2->periodic->ID) ? N1->periodic : N2->periodic;
-      N1->periodic = N2->periodic =
-	N1->periodic->periodic = N2->periodic->periodic = PN;
-    } else {
-      PN = (N1->periodic->ID < N2->ID) ? N1->periodic : N2;
-      N2->periodic = N1->periodic = N1->periodic->periodic = PN;
-      this -> fixPeriodic();
-    }
-  else {
-    if (!N2 -> periodic) {
-      PN = (N1->ID < N2->ID) ? N1 : N2;
-      N1->periodic = N2->periodic = PN;
-      fixPeriodic();
-    } else if (N2 -> periodic != N2) {
-      PN = (N1->ID < N2->periodic->ID) ? N1 : N2;
-      N2->periodic = N1->periodic = N1->periodic->periodic = PN;
-      fixPeriodic();
-    } else {
-      PN = (N1->ID < N2->ID) ? N1 : N2;
-      N1->periodic = N2->periodic = PN;
-      this -> fixPeriodic();
-    }
-  }
-  
-  if (!PN) Veclib::alert ("Mesh::chooseNode", "NEVER HAPPEN", ERROR);
+  Node *P1 = N1, *P2 = N2, *PN, *np;
+
+  if (!P1 -> periodic) P1 -> periodic = P1;
+  if (!P2 -> periodic) P2 -> periodic = P2;
+
+  while (P1 -> periodic != P1) P1 = P1 -> periodic;
+  while (P2 -> periodic != P2) P2 = P2 -> periodic;
+
+  PN = (P1 -> ID < P2 -> ID) ? P1 : P2;
+
+  while (N1 != PN) { np = N1 -> periodic; N1 -> periodic = PN; N1 = np; }
+  while (N2 != PN) { np = N2 -> periodic; N2 -> periodic = PN; N2 = np; }
 }
 
 
@@ -569,21 +549,19 @@ void Mesh::fixPeriodic()
 // ---------------------------------------------------------------------------
 // -- Private member function.
 //  
-// Traverse all Nodes and fix up any Nodes whose periodic value doesn't
-// terminate self-referentially (not recursively as this is not needed).
+// Traverse all Nodes and point each periodic one directly at the
+// self-referential root of its periodic set.  Single pass: Nodes are
+// visited in ID order, and a root always has a lower ID than anything
+// that refers to it, so it has already been resolved when needed.
 // ---------------------------------------------------------------------------
 {
-  const int_t    N = _nodeTable.size();
-  int_t i;
-  Node           *np, *npp;
+  const int_t N = _nodeTable.size();
+  int_t       i;
+  Node*       np;
 
   for (i = 0; i < N; i++) {
-    np  = _nodeTable[i];
-    npp = np -> periodic;
-    if (npp && npp -> periodic != npp) {
-      npp = npp -> periodic;
-      if (!npp) Veclib::alert ("Mesh::fixPeriodic", "NEVER HAPPEN", ERROR);
-    }
+    np = _nodeTable[i];
+    if (np -> periodic) np -> periodic = np -> periodic -> periodic;
   }
 }
 
@@ -21,10 +21,15 @@
 #include <cstring>
 #include <cstdlib>
 #include <ctime>
+#include <algorithm>
+#include <map>
+#include <vector>
 
 #include <utility.h>
 #include <veclib.h>
+#include <femlib.h>
 #include <message.h>
+#include <profile.h>
 
 #if defined(MPI_EX)
 #include <mpi.h>
@@ -33,6 +38,17 @@ static MPI_Comm
   grid_comm = MPI_COMM_NULL,
   row_comm  = MPI_COMM_NULL,
   col_comm  = MPI_COMM_NULL;
+
+/* -- Node-level communicators and layout for the two-level exchange: */
+static MPI_Comm
+  node_comm = MPI_COMM_NULL,	// Processes of col_comm sharing memory.
+  lead_comm = MPI_COMM_NULL;	// First (leader) process on each node.
+static std::vector<int>
+  nodeOf,			// Node index of each col_comm process,
+  locOf,			// and its rank within that node.
+  nodeSize;			// Number of processes on each node.
+static std::vector<MPI_Win>
+  windows;			// Shared buffers, freed by Message::stop.
 #endif
 
 #if defined(NUMA)
@@ -67,6 +83,53 @@ namespace Message {
   }    
 
 
+#if defined(MPI_EX)
+
+  static void nodes ()
+  // ------------------------------------------------------------------------
+  // Split col_comm into groups of processes that share memory (nodes),
+  // with the lowest-ranked process on each node as its leader, and
+  // record which node every process of col_comm is on.  This enables
+  // the two-level exchange, see alltoall below.
+  // ------------------------------------------------------------------------
+  {
+#if MPI_VERSION >= 3
+    int np, ip, il, node, i;
+
+    MPI_Comm_size (col_comm, &np);
+    MPI_Comm_rank (col_comm, &ip);
+
+    MPI_Comm_split_type
+      (col_comm, MPI_COMM_TYPE_SHARED, ip, MPI_INFO_NULL, &node_comm);
+    MPI_Comm_rank (node_comm, &il);
+    MPI_Comm_split (col_comm, il ? MPI_UNDEFINED : 0, ip, &lead_comm);
+
+    if (!il) MPI_Comm_rank (lead_comm, &node);
+    MPI_Bcast (&node, 1, MPI_INT, 0, node_comm);
+
+    int              mine[2] = { node, il };
+    std::vector<int> all (2 * np);
+
+    MPI_Allgather (mine, 2, MPI_INT, &all[0], 2, MPI_INT, col_comm);
+
+    nodeOf.resize (np);
+    locOf .resize (np);
+    for (i = 0; i < np; i++) {
+      nodeOf[i] = all[2 * i];
+      locOf [i] = all[2 * i + 1];
+      if (nodeOf[i] >= static_cast<int>(nodeSize.size()))
+	nodeSize.resize (nodeOf[i] + 1, 0);
+      nodeSize[nodeOf[i]]++;
+    }
+#else
+    Veclib::alert ("Message::grid",
+		   "two-level exchange needs MPI-3, using flat", WARNING);
+#endif
+  }
+
+#endif
+
+
   void grid (const int& npart2d, // -- Input [1 .. number of elements in mesh]
 	     int&       ipart2d, //    Output
 	     int&       npartz , //    Output
@@ -131,6 +194,8 @@ namespace Message {
     npartz  = ntot;
     ipart2d = 0;
 
+    if (Femlib::ivalue ("EXCHANGE") == 1) nodes ();
+
 #else
     // -- Serial execution; supply default return values (not used).
     
@@ -147,6 +212,11 @@ namespace Message {
   {
 #if defined(MPI_EX)
 
+    for (size_t i = 0; i < windows.size(); i++) {
+      MPI_Win_unlock_all (windows[i]);
+      MPI_Win_free       (&windows[i]);
+    }
+
     MPI_Barrier  (MPI_COMM_WORLD);
     MPI_Finalize ();
 
@@ -166,327 +236,326 @@ namespace Message {
 #endif
   }
 
-#define MAX(a, b) ((a) > (b) ? (a) : (b))
-
-
-  static int first (int n, const int* x)
-  { 
-    int i;
-    for (i = 0; i < n; i++) if (x[i]) return i;
-    return 0;
-  }
-
+#if defined(MPI_EX)
 
-  void exchange (real_t*     data,
-		 const int_t nZ  ,
-		 const int_t nP  ,
-		 const int_t sign)
+  template<class T> struct Plan
   // ------------------------------------------------------------------------
-  // Transpose blocks of data across processors.  Data is a double-precision 
-  // vector, total length nP*nZ on each processor.
-  //
-  // The amount of data held by each processor is nP*nZ.  Each nP-sized plane
-  // can be split into nB = nP/nProc sized blocks (it is assumed that nP is an
-  // int_t multiple of nProc, i.e. that nB is a whole number).  Initially
-  // the data are ordered by as nZ nP-sized planes, with memory traversed 
-  // fastest moving over the planes, and the block indices vary more rapidly
-  // than the z-indices.
+  // Intra-processor block permutation for exchange, precomputed for
+  // one global shape (planes held by each process, nP).  Packed block k, size[k] long, goes to
+  // offset to[k] in the message buffer from offset from[k] in the
+  // input, with the blocks listed in cache-blocked order (see plan).
+  // Each shape also keeps its own message buffer, so that alternating
+  // exchanges of different shapes do not reallocate.
+  // ------------------------------------------------------------------------
+  {
+    std::vector<int> to  ;
+    std::vector<int> from;
+    std::vector<int> size;
+    std::vector<T>   buf ;
+
+    std::vector<int> scount;	// -- Uneven split of planes: message
+    std::vector<int> sdispl;	//    sizes and offsets to send
+    std::vector<int> rcount;	//    and receive, for MPI_Alltoallv
+    std::vector<int> rdispl;	//    (empty if the split is even).
+
+    T*               agg  ;	// -- Two-level exchange: node buffer,
+    MPI_Win          win  ;	//    its shared-memory window,
+    std::vector<int> count;	//    and leader message sizes
+    std::vector<int> displ;	//    and offsets, by node.
+  };
+
+
+  template<class T>
+  static Plan<T>& plan (const int nZ,
+			const int nP,
+			const int np)
+  // ------------------------------------------------------------------------
+  // Return the Plan for this shape, building it on first use.  Every
+  // call first learns how many planes each of the other processes
+  // holds (one small MPI_Allgather), and plans are cached on that
+  // global shape rather than on the local nZ: processes with the same
+  // nZ may be in exchanges of different shapes, so a local key could
+  // leave one process building a plan while another found it cached.
   //
-  // The aim of the the exchange is to re-order the data so that each
-  // processor holds all the nZ data for one of the blocks, i.e. a gather of
-  // all the z-information for a block onto each a single processor, which e.g.
-  // can be followed by multiple 1D Fourier transformations over each block.
+  // If that is the same for all, nP is split into NB = np blocks of nB
+  // = nP / np.  Input (plane-major) block j*NB + i, i.e. block i of
+  // plane j, is packed (block-major) as block i*nZ + j.  Blocks are
+  // visited in tiles of nI neighbouring i for each plane j, so that
+  // every read from the input covers at least a cache line.
   //
-  // First the data are exchanged within a single processor so that (in
-  // terms of blocks) the block (rather than the z) indices vary slowest
-  // as memory is traversed.  This is the "in-place scatter".  Then a
-  // block-transpose of data across processors is carried out using
-  // message passing.
-  //
-  // NB: order of inter- and intra-processor exchanges must be reversed 
-  // in order to invert the exchange with a second exchange: this is the use
-  // of input variable sign.
+  // Otherwise block q, destined for process q, is in proportion to its
+  // nz[q] planes (of nZtot in all): it is nB[q] = nP*nz[q]/nZtot long,
+  // starting at nP*base[q]/nZtot where base[q] is q's first plane.
+  // Each process gets back the nB[me] values of all nZtot planes, in
+  // order, just as for the even split.
   // ------------------------------------------------------------------------
   {
-#if defined(MPI_EX)
+    static std::map<std::pair<std::vector<int>, int>, Plan<T> > cache;
 
-    int np;
-    MPI_Comm_size (col_comm, &np);
+    std::vector<int> nz (np);
 
-    int            i, j;
-    const int      nB = nP / np;       // -- Size of intra-processor block.
-    const int      NB = nP / nB;       // -- Number of these blocks in a plane.
-    const int      NM = nP * nZ / np;  // -- Size of message block.
-    const int      dsize   = sizeof (real_t);
-    static double  *tmp   = NULL;
-    static int     *kmove = NULL, *kpost, lastk;
-    static int     *jmove = NULL, *jpost, lastj;
-    static int     lastreq = 0;
+    MPI_Allgather (const_cast<int*>(&nZ), 1, MPI_INT,
+		   &nz[0], 1, MPI_INT, col_comm);
 
-    if (np == 1) return;
+    Plan<T>& P = cache[std::make_pair (nz, nP)];
 
-    if (tmp && lastreq != nP * nZ) { free (tmp); tmp = NULL; }
-    if (!tmp) { lastreq = nP * nZ; tmp = (double*) malloc (lastreq * dsize); }
+    if (P.buf.empty()) {
+      std::vector<int> base (np, 0);
+      int              ip, nZtot, q;
 
-    if (sign == 1) {		// -- "Forwards" exchange.
+      MPI_Comm_rank (col_comm, &ip);
+
+      for (q = 1; q < np; q++) base[q] = base[q - 1] + nz[q - 1];
+      nZtot = base[np - 1] + nz[np - 1];
+
+      P.agg = 0;
+      P.buf.resize (nP * nZ);
+
+      if (std::count (nz.begin(), nz.end(), nZ) == np) {
+	const int nB = nP / np;
+	const int NB = nP / nB;
+	const int nI = std::max (1, static_cast<int>(64 / (nB * sizeof (T))));
+	int       i, j, ib;
 
-      // -- Intra-processor exchange.
+	P.to  .reserve (NB * nZ);
+	P.from.reserve (NB * nZ);
+	P.size.assign  (NB * nZ, nB);
 
-      if (NB == nZ) {		// -- Symmetric exchange.
-	for (i = 0; i < nZ; i++)
-	  for (j = i; j < nZ; j++) {
-	    if (i != j) {
-	      __MEMCPY (tmp,                data + (i*nZ+j)*nB, nB * dsize);
-	      __MEMCPY (data + (i*nZ+j)*nB, data + (j*nZ+i)*nB, nB * dsize);
-	      __MEMCPY (data + (j*nZ+i)*nB, tmp,                nB * dsize);
+	for (ib = 0; ib < NB; ib += nI)
+	  for (j = 0; j < nZ; j++)
+	    for (i = ib; i < std::min (ib + nI, NB); i++) {
+	      P.to  .push_back ((i * nZ + j) * nB);
+	      P.from.push_back ((j * NB + i) * nB);
 	    }
-	  }
 
-      } else {			// -- Asymmetric exchange.
+      } else {
+	const int nBme = nP * nz[ip] / nZtot;
+	int       j, nB, off;
 
-	int        k, knext, kconf;
-	const int  NBnZm = NB * nZ - 1;
+	P.scount.resize (np); P.sdispl.resize (np);
+	P.rcount.resize (np); P.rdispl.resize (np);
 
-	if (kmove && lastk != nZ*NB) { free (kmove); kmove = NULL; }
-	if (!kmove) {
-	  lastk = nZ * NB;
-	  kmove = (int*) malloc (2*lastk * sizeof (int));
-	  kpost = kmove + lastk;
-	}
+	for (q = 0; q < np; q++) {
+	  nB  = nP * nz[q]   / nZtot;
+	  off = nP * base[q] / nZtot;
 
-	// -- Build scatter indices.
-    
-	for (i = 0; i < NB; i++)
-	  for (j = 0; j < nZ; j++)
-	    kpost[j * NB + i] = i * nZ + j;
-
-	for (i = 1; i < NBnZm; i++) kmove[i] = 1;
-	kmove[0] = kmove[NBnZm] = 0;
-
-	// -- Do "in-place" scatter.
-
-	while (k = first (nZ*NB, kmove)) {
-	  knext = kconf = kpost[k];
-	  __MEMCPY (tmp, data + kconf * nB, nB * dsize);
-	  do {
-	    __MEMCPY (data + knext * nB, data + k * nB, nB * dsize);
-	    kmove[k] = 0;
-	    for (i = 1; i < NBnZm; i++)
-	      if (kpost[i] == k) {
-		k     = i;
-		knext = kpost[k];
-		break;
-	      }
-	  } while (k != kconf);
-	  __MEMCPY (data + knext * nB, tmp, nB * dsize);
-	  kmove[k] = 0;
+	  P.scount[q] = nZ * nB;
+	  P.sdispl[q] = nZ * off;
+	  P.rcount[q] = nz[q]   * nBme;
+	  P.rdispl[q] = base[q] * nBme;
+
+	  for (j = 0; j < nZ; j++) {
+	    P.to  .push_back (P.sdispl[q] + j * nB);
+	    P.from.push_back (j * nP + off);
+	    P.size.push_back (nB);
+	  }
 	}
       }
+    }
 
-      // -- Inter-processor transpose, with NB blocks size nZ*nB / processor.
-
-      MPI_Alltoall (data, NM, MPI_DOUBLE, tmp, NM, MPI_DOUBLE, col_comm);
-      __MEMCPY     (data, tmp, nP * nZ * dsize);
+    return P;
+  }
 
 
-    } else {			// -- "Backwards" exchange.
+  template<class T>
+  static void alltoall (const T*           send,
+			T*                 recv,
+			const int          NM  ,
+			const MPI_Datatype type,
+			Plan<T>&           P   )
+  // ------------------------------------------------------------------------
+  // Equivalent of MPI_Alltoall on col_comm, messages NM long, or of
+  // MPI_Alltoallv with the message sizes of P for an uneven split.
+  //
+  // If token EXCHANGE = 1 (and MPI-3 is available) this is done in two
+  // levels.  Processes on a node share a buffer, allocated by their
+  // leader as an MPI-3 shared-memory window.  Each process deposits its
+  // outgoing messages there, ordered by destination node; the leaders
+  // exchange one (large) aggregated message per pair of nodes, rather
+  // than one per pair of processes; then each process collects its
+  // incoming messages straight from its leader's receive area.  An
+  // uneven split always uses the flat MPI_Alltoallv.
+  // ------------------------------------------------------------------------
+  {
+    if (!P.scount.empty()) {
+      MPI_Alltoallv (const_cast<T*>(send), &P.scount[0], &P.sdispl[0], type,
+		     recv, &P.rcount[0], &P.rdispl[0], type, col_comm);
+      return;
+    }
 
-      MPI_Alltoall (data, NM, MPI_DOUBLE, tmp, NM, MPI_DOUBLE, col_comm);
-      __MEMCPY     (data, tmp, nP * nZ * dsize);
+    if (node_comm == MPI_COMM_NULL) {
+      MPI_Alltoall (const_cast<T*>(send), NM, type, recv, NM, type, col_comm);
+      return;
+    }
 
-      if (NB == nZ) {
+#if MPI_VERSION >= 3
+    int np, ip, d;
 
-	for (i = 0; i < nZ; i++)
-	  for (j = i; j < nZ; j++) {
-	    if (i != j) {
-	      __MEMCPY (tmp,                data + (i*nZ+j)*nB, nB * dsize);
-	      __MEMCPY (data + (i*nZ+j)*nB, data + (j*nZ+i)*nB, nB * dsize);
-	      __MEMCPY (data + (j*nZ+i)*nB, tmp,                nB * dsize);
-	    }
-	  }
+    MPI_Comm_size (col_comm, &np);
+    MPI_Comm_rank (col_comm, &ip);
 
-      } else {
+    const int    me = nodeOf[ip], il = locOf[ip], nl = nodeSize[me];
+    const size_t msize = NM * sizeof (T);
 
-	int        j, jnext, jconf;
-	const int  NBnZm = NB * nZ - 1;
+    if (!P.agg) {
+      const int nn = nodeSize.size();
+      MPI_Aint  size;
+      int       unit, n;
 
-	if (jmove && lastj != nZ*NB) { free (jmove); jmove = NULL; }
-	if (!jmove) {
-	  lastj = nZ * NB;
-	  jmove = (int*) malloc (2*lastj * sizeof (int));
-	  jpost = jmove + lastj;
-	}
+      // -- Node message to/from node n holds nl x nodeSize[n] messages,
+      //    ordered by rank on the sending node, then on the receiving.
 
-	for (i = 0; i < NB; i++)
-	  for (j = 0; j < nZ; j++)
-	    jpost[i * nZ + j] = j * NB + i;
-
-	for (i = 1; i < NBnZm; i++) jmove[i] = 1;
-	jmove[0] = jmove[NBnZm] = 0;
-
-	while (j = first (nZ*NB, jmove)) {
-	  jnext = jconf = jpost[j];
-	  __MEMCPY (tmp, data + jconf * nB, nB * dsize);
-	  do {
-	    __MEMCPY (data + jnext * nB, data + j * nB, nB * dsize);
-	    jmove[j] = 0;
-	    for (i = 1; i < NBnZm; i++)
-	      if (jpost[i] == j) {
-		j     = i;
-		jnext = jpost[j];
-		break;
-	      }
-	  } while (j != jconf);
-	  __MEMCPY (data + jnext * nB, tmp, nB * dsize);
-	  jmove[j] = 0;
-	}
+      P.count.resize (nn);
+      P.displ.resize (nn);
+      for (n = 0; n < nn; n++) {
+	P.count[n] = nl * nodeSize[n] * NM;
+	P.displ[n] = (n) ? P.displ[n - 1] + P.count[n - 1] : 0;
       }
+
+      size = (il) ? 0 : 2 * nl * np * msize;
+      MPI_Win_allocate_shared
+	(size, sizeof (T), MPI_INFO_NULL, node_comm, &P.agg, &P.win);
+      MPI_Win_shared_query (P.win, 0, &size, &unit, &P.agg);
+      MPI_Win_lock_all     (MPI_MODE_NOCHECK, P.win);
+      windows.push_back    (P.win);
     }
+
+    T* out = P.agg;
+    T* in  = P.agg + nl * np * NM;
+
+    for (d = 0; d < np; d++)
+      __MEMCPY (out + P.displ[nodeOf[d]]
+		+ (il * nodeSize[nodeOf[d]] + locOf[d]) * NM,
+		send + d * NM, msize);
+
+    MPI_Win_sync (P.win);
+    MPI_Barrier  (node_comm);
+
+    if (lead_comm != MPI_COMM_NULL)
+      MPI_Alltoallv (out, &P.count[0], &P.displ[0], type,
+		     in,  &P.count[0], &P.displ[0], type, lead_comm);
+
+    MPI_Barrier  (node_comm);
+    MPI_Win_sync (P.win);
+
+    for (d = 0; d < np; d++)
+      __MEMCPY (recv + d * NM, in + P.displ[nodeOf[d]]
+		+ (locOf[d] * nl + il) * NM, msize);
 #endif
   }
 
 
-  void exchange (int_t*      data,
-		 const int_t nZ  ,
-		 const int_t nP  ,
-		 const int_t sign)
+  template<class T>
+  static void transpose (T*                 data,
+			 const int_t        nZ  ,
+			 const int_t        nP  ,
+			 const int_t        sign,
+			 const MPI_Datatype type)
   // ------------------------------------------------------------------------
-  // Integer exchange.
+  // Typed body of exchange (below).  Going forwards, the local
+  // permutation packs data straight into the message buffer, and the
+  // transpose receives straight back into data; backwards, the
+  // reverse.
   // ------------------------------------------------------------------------
   {
-#if defined(MPI_EX)
-
     int np;
     MPI_Comm_size (col_comm, &np);
 
-    int            i, j;
-    const int      nB = nP / np;       // -- Size of intra-processor block.
-    const int      NB = nP / nB;       // -- Number of these blocks in a plane.
-    const int      NM = nP * nZ / np;  // -- Size of message block.
-    const int      dsize  = sizeof (int_t);
-    static int     *tmp   = NULL;
-    static int     *kmove = NULL, *kpost, lastk;
-    static int     *jmove = NULL, *jpost, lastj;
-    static int     lastreq = 0;
-
     if (np == 1) return;
 
-    if (tmp && lastreq != nP * nZ) { free (tmp); tmp = NULL; }
-    if (!tmp) { lastreq = nP * nZ; tmp = (int*) malloc (lastreq * dsize); }
+    Plan<T>&     P     = plan<T> (nZ, nP, np);
+    const int    NM    = nP * nZ / np;	// -- Size of message block.
+    const int    nblk  = P.to.size();
+    T*           buf   = &P.buf[0];
+    int          k;
 
     if (sign == 1) {		// -- "Forwards" exchange.
 
-      // -- Intra-processor exchange.
+      for (k = 0; k < nblk; k++)
+	__MEMCPY (buf + P.to[k], data + P.from[k], P.size[k] * sizeof (T));
 
-      if (NB == nZ) {		// -- Symmetric exchange.
-	for (i = 0; i < nZ; i++)
-	  for (j = i; j < nZ; j++) {
-	    if (i != j) {
-	      __MEMCPY (tmp,                data + (i*nZ+j)*nB, nB * dsize);
-	      __MEMCPY (data + (i*nZ+j)*nB, data + (j*nZ+i)*nB, nB * dsize);
-	      __MEMCPY (data + (j*nZ+i)*nB, tmp,                nB * dsize);
-	    }
-	  }
+      alltoall (buf, data, NM, type, P);
 
-      } else {			// -- Asymmetric exchange.
+    } else {			// -- "Backwards" exchange.
 
-	int        k, knext, kconf;
-	const int  NBnZm = NB * nZ - 1;
+      alltoall (data, buf, NM, type, P);
 
-	if (kmove && lastk != nZ*NB) { free (kmove); kmove = NULL; }
-	if (!kmove) {
-	  lastk = nZ * NB;
-	  kmove = (int*) malloc (2*lastk * sizeof (int));
-	  kpost = kmove + lastk;
-	}
+      for (k = 0; k < nblk; k++)
+	__MEMCPY (data + P.from[k], buf + P.to[k], P.size[k] * sizeof (T));
+    }
+  }
 
-	// -- Build scatter indices.
-    
-	for (i = 0; i < NB; i++)
-	  for (j = 0; j < nZ; j++)
-	    kpost[j * NB + i] = i * nZ + j;
-
-	for (i = 1; i < NBnZm; i++) kmove[i] = 1;
-	kmove[0] = kmove[NBnZm] = 0;
-
-	// -- Do "in-place" scatter.
-
-	while (k = first (nZ*NB, kmove)) {
-	  knext = kconf = kpost[k];
-	  __MEMCPY (tmp, data + kconf * nB, nB * dsize);
-	  do {
-	    __MEMCPY (data + knext * nB, data + k * nB, nB * dsize);
-	    kmove[k] = 0;
-	    for (i = 1; i < NBnZm; i++)
-	      if (kpost[i] == k) {
-		k     = i;
-		knext = kpost[k];
-		break;
-	      }
-	  } while (k != kconf);
-	  __MEMCPY (data + knext * nB, tmp, nB * dsize);
-	  kmove[k] = 0;
-	}
-      }
+#endif
 
-      // -- Inter-processor transpose, with NB blocks size nZ*nB / processor.
 
-      MPI_Alltoall (data, NM, MPI_INT, tmp, NM, MPI_INT, col_comm);
-      __MEMCPY     (data, tmp, nP * nZ * dsize);
+  void exchange (real_t*     data,
+		 const int_t nZ  ,
+		 const int_t nP  ,
+		 const int_t sign)
+  // ------------------------------------------------------------------------
+  // Transpose blocks of data across processors.  Data is a double-precision 
+  // vector, total length nP*nZ on each processor.
+  //
+  // The amount of data held by each processor is nP*nZ.  Each nP-sized plane
+  // can be split into nB = nP/nProc sized blocks (it is assumed that nP is an
+  // int_t multiple of nProc, i.e. that nB is a whole number).  Initially
+  // the data are ordered by as nZ nP-sized planes, with memory traversed 
+  // fastest moving over the planes, and the block indices vary more rapidly
+  // than the z-indices.
+  //
+  // The aim of the the exchange is to re-order the data so that each
+  // processor holds all the nZ data for one of the blocks, i.e. a gather of
+  // all the z-information for a block onto each a single processor, which e.g.
+  // can be followed by multiple 1D Fourier transformations over each block.
+  //
+  // Processors may hold different numbers of planes nZ (see
+  // Geometry::set).  Each then gets a block in proportion to its
+  // share of the planes, Geometry::nBlock (nP) long, and nP must be
+  // such that these are whole numbers (Geometry::padLength).
+  //
+  // First the data are exchanged within a single processor so that (in
+  // terms of blocks) the block (rather than the z) indices vary slowest
+  // as memory is traversed.  This is done out of place, packing into
+  // the message buffer using a permutation precomputed for each shape.
+  // Then a block-transpose of data across processors is carried out
+  // using message passing, received directly into data: either flat,
+  // or in two levels, within then across nodes (token EXCHANGE = 1).
+  // The data layout is the same either way.
+  //
+  // NB: order of inter- and intra-processor exchanges must be reversed 
+  // in order to invert the exchange with a second exchange: this is the use
+  // of input variable sign.
+  // ------------------------------------------------------------------------
+  {
+#if defined(MPI_EX)
 
-    } else {			// -- "Backwards" exchange.
+    static const Profile::Counter bytes = Profile::counter ("exchange_bytes");
+    int np;
+    MPI_Comm_size (col_comm, &np);
 
-      MPI_Alltoall (data, NM, MPI_INT, tmp, NM, MPI_INT, col_comm);
-      __MEMCPY     (data, tmp, nP * nZ * dsize);
+    if (np == 1) return;
 
-      if (NB == nZ) {
+    Profile::Scope timer ("exchange");
+    Profile::count (bytes, (double) (np-1) * (nP * nZ / np) * sizeof (real_t));
 
-	for (i = 0; i < nZ; i++)
-	  for (j = i; j < nZ; j++) {
-	    if (i != j) {
-	      __MEMCPY (tmp,                data + (i*nZ+j)*nB, nB * dsize);
-	      __MEMCPY (data + (i*nZ+j)*nB, data + (j*nZ+i)*nB, nB * dsize);
-	      __MEMCPY (data + (j*nZ+i)*nB, tmp,                nB * dsize);
-	    }
-	  }
+    transpose (data, nZ, nP, sign, MPI_DOUBLE);
 
-      } else {
+#endif
+  }
 
-	int        j, jnext, jconf;
-	const int  NBnZm = NB * nZ - 1;
 
-	if (jmove && lastj != nZ*NB) { free (jmove); jmove = NULL; }
-	if (!jmove) {
-	  lastj = nZ * NB;
-	  jmove = (int*) malloc (2*lastj * sizeof (int));
-	  jpost = jmove + lastj;
-	}
+  void exchange (int_t*      data,
+		 const int_t nZ  ,
+		 const int_t nP  ,
+		 const int_t sign)
+  // ------------------------------------------------------------------------
+  // Integer exchange.
+  // ------------------------------------------------------------------------
+  {
+#if defined(MPI_EX)
+
+    transpose (data, nZ, nP, sign, MPI_INT);
 
-	for (i = 0; i < NB; i++)
-	  for (j = 0; j < nZ; j++)
-	    jpost[i * nZ + j] = j * NB + i;
-
-	for (i = 1; i < NBnZm; i++) jmove[i] = 1;
-	jmove[0] = jmove[NBnZm] = 0;
-
-	while (j = first (nZ*NB, jmove)) {
-	  jnext = jconf = jpost[j];
-	  __MEMCPY (tmp, data + jconf * nB, nB * dsize);
-	  do {
-	    __MEMCPY (data + jnext * nB, data + j * nB, nB * dsize);
-	    jmove[j] = 0;
-	    for (i = 1; i < NBnZm; i++)
-	      if (jpost[i] == j) {
-		j     = i;
-		jnext = jpost[j];
-		break;
-	      }
-	  } while (j != jconf);
-	  __MEMCPY (data + jnext * nB, tmp, nB * dsize);
-	  jmove[j] = 0;
-	}
-      }
-    }
 #endif
   }
 
@@ -557,6 +626,51 @@ namespace Message {
     else
       MPI_Recv (data, (int) N, MPI_LONG, (int) src, 0, col_comm, &status);
 
+#endif
+  }
+
+
+  void sum (real_t*     data,
+	    const int_t N   )
+  // ------------------------------------------------------------------------
+  // Replace data on every process by its sum over all processes.
+  // ------------------------------------------------------------------------
+  {
+#if defined(MPI_EX)
+
+    MPI_Allreduce (MPI_IN_PLACE, data, (int) N, MPI_DOUBLE, MPI_SUM, col_comm);
+
+#endif
+  }
+
+
+  void broadcast (real_t*     data,
+		  const int_t N   )
+  // ------------------------------------------------------------------------
+  // Replace data on every process by that of the root process.
+  // ------------------------------------------------------------------------
+  {
+#if defined(MPI_EX)
+
+    MPI_Bcast (data, (int) N, MPI_DOUBLE, 0, col_comm);
+
+#endif
+  }
+
+
+  void broadcast (int_t*      data,
+		  const int_t N   )
+  // ------------------------------------------------------------------------
+  // Replace data on every process by that of the root process.
+  // ------------------------------------------------------------------------
+  {
+#if defined(MPI_EX)
+
+    if (sizeof (int_t) == sizeof (int))
+      MPI_Bcast (data, (int) N, MPI_INT,  0, col_comm);
+    else
+      MPI_Bcast (data, (int) N, MPI_LONG, 0, col_comm);
+
 #endif
   }
 
@@ -12,6 +12,9 @@ namespace Message {
   void send      (int_t*  data, const int_t N, const int_t tgt);
   void recv      (real_t* data, const int_t N, const int_t src);
   void recv      (int_t*  data, const int_t N, const int_t src);
+  void sum       (real_t* data, const int_t N);
+  void broadcast (real_t* data, const int_t N);
+  void broadcast (int_t*  data, const int_t N);
 
   void grid      (const int_t& npart2d, int_t& ipart2d,
 		  int_t& npartz,        int_t& ipartz);
@@ -8,253 +8,263 @@
 
 #include <sem.h>
 
-Domain* FluidParticle::_Dom     = 0;
-int_t   FluidParticle::_NCOM    = 0;
-int_t   FluidParticle::_NEL     = 0;
-int_t   FluidParticle::_NZ      = 0;
-int_t   FluidParticle::_TORD    = 0;
-int_t   FluidParticle::_ID_MAX  = 0;
-real_t* FluidParticle::_P_coeff = 0;
-real_t* FluidParticle::_C_coeff = 0;
-real_t* FluidParticle::_Work    = 0;
-real_t  FluidParticle::_DT      = 0.0;
-real_t  FluidParticle::_Lz      = 0.0;
-
-
-FluidParticle::FluidParticle (Domain*     d,
-			      const int_t i,
-			      Point&      p) :
+
+ParticleSet::ParticleSet (Domain* d) :
 // ---------------------------------------------------------------------------
-// Initially particle is located at p.  Find it in the 2D mesh.  Trim to
-// periodic length in 3D if required.
+// Set up integration coefficients and search index, initially empty.
 // ---------------------------------------------------------------------------
-  _id    (i),
-  _ctime (d -> time),
-  _step  (0),
-  _p     (p)
+  _Dom  (d),
+  _Loc  (new Locator (d -> elmt)),
+  _NCOM ((d -> nField() > 3) ? 3 : 2),
+  _TORD (Femlib::ivalue ("N_TIME")),
+  _Lz   (Femlib::value  ("TWOPI / BETA"))
 {
-  int_t      k;
-  const bool guess = true;
-
-  if (!_Dom) {			// -- Set up first time through.
-    _Dom     = d;
-    _NCOM    = (d -> nField() > 3) ? 3 : 2;
-    _NEL     = Geometry::nElmt();
-    _NZ      = Geometry::nZ();
-    _DT      = Femlib::value  ("D_T");
-    _Lz      = Femlib::value  ("TWOPI / BETA");
-    _TORD    = Femlib::ivalue ("N_TIME");
-    _P_coeff = new real_t [static_cast<size_t>(_TORD + _TORD)];
-    _C_coeff = new real_t [static_cast<size_t>(_TORD*(_TORD + 1))];
-    _Work    = new real_t [static_cast<size_t>(max 
-			(2*Geometry::nTotElmt(), 5 * Geometry::nP() + 6))];
-
-    Veclib::zero (_TORD*_TORD,     _P_coeff, 1);
-    Veclib::zero (_TORD*(_TORD+1), _C_coeff, 1);
-    
-    for (k = 0; k < _TORD; k++) {
-      Integration::AdamsBashforth (k+1, _P_coeff+k* _TORD   );
-      Integration::AdamsMoulton   (k+2, _C_coeff+k*(_TORD+1));
-    }
-
-    Blas::scal (_TORD*_TORD,     _DT, _P_coeff, 1);
-    Blas::scal (_TORD*(_TORD+1), _DT, _C_coeff, 1);
-  }
+  const real_t DT = Femlib::value ("D_T");
+  int_t        k;
 
-  // -- Try to locate particle, stop if can't.
+  _P_coeff.resize (_TORD*_TORD,      0.0);
+  _C_coeff.resize (_TORD*(_TORD+1), 0.0);
 
-  _E = 0;
-  for (k = 0; k < _NEL; k++) {
-    _r = _s = 0.0;
-    if (_Dom -> elmt[k] -> locate (_p.x, _p.y, _r, _s, _Work, guess)) {
-      _E = _Dom -> elmt[k];
-      break;
-    }
+  for (k = 0; k < _TORD; k++) {
+    Integration::AdamsBashforth (k+1, &_P_coeff[k* _TORD   ]);
+    Integration::AdamsMoulton   (k+2, &_C_coeff[k*(_TORD+1)]);
   }
 
-  if (!_E) return;
-  if (_id > _ID_MAX) _ID_MAX = _id;
+  Blas::scal (_TORD*_TORD,     DT, &_P_coeff[0], 1);
+  Blas::scal (_TORD*(_TORD+1), DT, &_C_coeff[0], 1);
+}
 
-  if (_NCOM == 2) {
-    _p.z = 0.0;
 
-    _u = new real_t [static_cast<size_t>(_TORD + _TORD)];
-    _v = _u + _TORD;
+bool ParticleSet::add (const int_t  id,
+		       const Point& p )
+// ---------------------------------------------------------------------------
+// Add a particle initially located at p.  Find it in the 2D mesh.
+// Trim to periodic length in 3D if required.  Return false (and don't
+// add it) if it isn't in the mesh.
+// ---------------------------------------------------------------------------
+{
+  real_t         r = 0.0, s = 0.0, z = 0.0;
+  const Element* E = _Loc -> locate (p.x, p.y, r, s);
+
+  if (!E) return false;
 
-  } else {
-    if   (_p.z < 0.0) _p.z = _Lz - fmod (fabs (_p.z), _Lz);
-    else              _p.z = fmod (_p.z, _Lz);
-    
-    _u = new real_t [static_cast<size_t>(_TORD + _TORD + _TORD)];
-    _v = _u + _TORD;
-    _w = _v + _TORD;
+  if (_NCOM == 3) {
+    if   (p.z < 0.0) z = _Lz - fmod (fabs (p.z), _Lz);
+    else             z = fmod (p.z, _Lz);
   }
+
+  _id   .push_back (id);
+  _ctime.push_back (_Dom -> time);
+  _step .push_back (0);
+  _E    .push_back (E);
+  _r    .push_back (r);
+  _s    .push_back (s);
+  _x    .push_back (p.x);
+  _y    .push_back (p.y);
+  _z    .push_back (z);
+
+  _u.resize (_u.size() + _TORD, 0.0);
+  _v.resize (_v.size() + _TORD, 0.0);
+  if (_NCOM == 3) _w.resize (_w.size() + _TORD, 0.0);
+
+  return true;
 }
 
 
-void FluidParticle::integrate ()
+void ParticleSet::integrate ()
 // ---------------------------------------------------------------------------
-// Integrate massless particle's position using predictor--corrector
-// scheme.  If particles leave 2D mesh they are marked by setting E =
-// 0.  For 3D, they get put back into the fundamental period of the
-// solution if they leave in the z-direction.
+// Integrate massless particles' positions using predictor--corrector
+// scheme.  Velocities for all particles are evaluated together, once
+// for the predictor and once for the corrector.  Particles that leave
+// the 2D mesh are dropped.  For 3D, they get put back into the
+// fundamental period of the solution if they leave in the z-direction.
 //
 // NB: The domain velocity fields must be in Fourier space prior to call (3D).
 // ---------------------------------------------------------------------------
 {
-  if (!_E) return;
+  const int_t NPT = _id.size();
+  if (!NPT) return;
 #if defined (DEBUG)
-  const char routine[] = "FluidParticle::integrate";
+  const char routine[] = "ParticleSet::integrate";
 #endif
-  int_t i;
-  const int_t    N     = min (++_step, _TORD);
-  const int_t    NP    = N + 1;
-  const int_t    NM    = N - 1;
-  const bool     guess = true;
-  real_t         xp, yp, zp, up, vp, wp;
-  real_t         *predictor, *corrector;
-
-  predictor = _P_coeff + NM *  _TORD;
-  corrector = _C_coeff + NM * (_TORD+1);
-
-  if (_NCOM == 2) {		// -- 2D integration.
-    
-    // -- Predictor.
-
-    _u[0] = _Dom -> u[0] -> probe (_E, _r, _s, static_cast<int_t>(0));
-    _v[0] = _Dom -> u[1] -> probe (_E, _r, _s, static_cast<int_t>(0));
-
-    xp = _p.x;
-    yp = _p.y;
-    for (i = 0; i < N; i++) {
-      xp += predictor[i] * _u[i];
-      yp += predictor[i] * _v[i];
+  const int_t T = _TORD;
+  int_t       i, j, N;
+  real_t      *predictor, *corrector, *u, *v, *w;
+
+  vector<AuxField*>      vel (_NCOM);
+  vector<real_t>         U   (_NCOM * NPT), xp (NPT), yp (NPT), zp (_z);
+  vector<const Element*> Ep  (_E);
+  vector<real_t>         rp  (_r), sp (_s);
+
+  for (j = 0; j < _NCOM; j++) vel[j] = _Dom -> u[j];
+
+  // -- Predictor.
+
+  AuxField::probe (vel, NPT, &_E[0], &_r[0], &_s[0], &_z[0], &U[0]);
+
+  for (i = 0; i < NPT; i++) {
+    N         = min (++_step[i], T);
+    predictor = &_P_coeff[(N - 1) * T];
+    u         = &_u[i * T];
+    v         = &_v[i * T];
+
+    u[0]  = U[i];
+    v[0]  = U[i + NPT];
+    xp[i] = _x[i];
+    yp[i] = _y[i];
+    for (j = 0; j < N; j++) {
+      xp[i] += predictor[j] * u[j];
+      yp[i] += predictor[j] * v[j];
     }
 
-    if (!_E -> locate (xp, yp, _r, _s, _Work)) {
-      _E = 0;
-      for (i = 0; i < _NEL; i++) {
-	_r = _s = 0.0;
-	if (_Dom -> elmt[i] -> locate (xp, yp, _r, _s, _Work, guess)) {
-	  _E = _Dom -> elmt[i];
-	  break;
-	}
-      }
-      if (!_E) {
-#if defined (DEBUG)
-	if (Femlib::ivalue ("VERBOSE") > 3) {
-	  char     str[StrMax];
-	  sprintf (str, "Particle %1d at (%f, %f, %f) left mesh",
-		   _id, _p.x, _p.y, _p.z);
-	  Veclib::alert (routine, str, WARNING);
-	}
-#endif
-	return;
-      }
+    if (_NCOM == 3) {
+      w    = &_w[i * T];
+      w[0] = U[i + 2*NPT];
+      for (j = 0; j < N; j++) zp[i] += predictor[j] * w[j];
     }
+  }
 
-    // -- Corrector.
+  this -> locate (NPT, &xp[0], &yp[0], Ep, rp, sp);
 
-    up = _Dom -> u[0] -> probe (_E, _r, _s, static_cast<int_t>(0));
-    vp = _Dom -> u[1] -> probe (_E, _r, _s, static_cast<int_t>(0));
+  // -- Corrector.
 
-    _p.x += corrector[0] * up;
-    _p.y += corrector[0] * vp;
-    for (i = 1; i < NP; i++) {
-      _p.x += corrector[i] * _u[i - 1];
-      _p.y += corrector[i] * _v[i - 1];
+  AuxField::probe (vel, NPT, &Ep[0], &rp[0], &sp[0], &zp[0], &U[0]);
+
+  for (i = 0; i < NPT; i++) {
+    if (!Ep[i]) continue;
+    N         = min (_step[i], T);
+    corrector = &_C_coeff[(N - 1) * (T + 1)];
+    u         = &_u[i * T];
+    v         = &_v[i * T];
+
+    _x[i] += corrector[0] * U[i];
+    _y[i] += corrector[0] * U[i + NPT];
+    for (j = 1; j <= N; j++) {
+      _x[i] += corrector[j] * u[j - 1];
+      _y[i] += corrector[j] * v[j - 1];
     }
 
-    if (!_E -> locate (_p.x, _p.y, _r, _s, _Work)) {
-      _E = 0;
-      for (i = 0; i < _NEL; i++) {
-	_r = _s = 0.0;
-	if (_Dom -> elmt[i] -> locate (_p.x, _p.y, _r, _s, _Work, guess)) {
-	  _E = _Dom -> elmt[i];
-	  break;
-	}
-      }
-      if (!_E) {
+    if (_NCOM == 3) {
+      w      = &_w[i * T];
+      _z[i] += corrector[0] * U[i + 2*NPT];
+      for (j = 1; j <= N; j++) _z[i] += corrector[j] * w[j - 1];
+    }
+  }
+
+  _E = Ep; _r = rp; _s = sp;
+
+  this -> locate (NPT, &_x[0], &_y[0], _E, _r, _s);
+
+  // -- Maintain multilevel storage.
+
+  for (i = 0; i < NPT; i++) {
+    if (!_E[i]) {
 #if defined (DEBUG)
-	if (Femlib::ivalue ("VERBOSE") > 3) {
-	  char     str[StrMax];
-	  sprintf (str, "Particle %1d at (%f, %f, %f) left mesh",
-		   _id, _p.x, _p.y, _p.z);
-	  Veclib::alert (routine, str, WARNING);
-	}
-#endif
-	return;
+      if (Femlib::ivalue ("VERBOSE") > 3) {
+	char str[StrMax];
+	sprintf (str, "Particle %1d at (%f, %f, %f) left mesh",
+		 _id[i], _x[i], _y[i], _z[i]);
+	Veclib::alert (routine, str, WARNING);
       }
+#endif
+      continue;
     }
 
-    // -- Maintain multilevel storage.
+    rollv (&_u[i * T], T);
+    rollv (&_v[i * T], T);
 
-    rollv (_u, _TORD);
-    rollv (_v, _TORD);
+    if (_NCOM == 3) {
+      if   (_z[i] < 0.0) _z[i] = _Lz - fmod (fabs (_z[i]), _Lz);
+      else               _z[i] = fmod (_z[i], _Lz);
+      rollv (&_w[i * T], T);
+    }
+  }
 
-  } else {			// -- 3D integration.
-    
-    // -- Predictor.
+  this -> compact ();
+}
 
-    _u[0] = _Dom -> u[0] -> probe (_E, _r, _s, _p.z);
-    _v[0] = _Dom -> u[1] -> probe (_E, _r, _s, _p.z);
-    _w[0] = _Dom -> u[2] -> probe (_E, _r, _s, _p.z);
 
-    xp = _p.x;
-    yp = _p.y;
-    zp = _p.z;
-    for (i = 0; i < N; i++) {
-      xp += predictor[i] * _u[i];
-      yp += predictor[i] * _v[i];
-      zp += predictor[i] * _w[i];
-    }
+void ParticleSet::write (ostream& os) const
+// ---------------------------------------------------------------------------
+// Print up current particle locations, one per line:
+//   tag  time  ctime  x  y  z
+// ---------------------------------------------------------------------------
+{
+  int_t       i;
+  const int_t NPT = _id.size();
+
+  for (i = 0; i < NPT; i++)
+    os << setw (6) << _id[i]
+       << setw(14) << _Dom -> time
+       << setw(14) << _ctime[i]
+       << setw(14) << _x[i]
+       << setw(14) << _y[i]
+       << setw(14) << _z[i]
+       << endl;
+}
 
-    if (!_E -> locate (xp, yp, _r, _s, _Work)) {
-      _E = 0;
-      for (i = 0; i < _NEL; i++) {
-	_r = _s = 0.0;
-	if (_Dom -> elmt[i] -> locate (xp, yp, _r, _s, _Work, guess)) {
-	  _E = _Dom -> elmt[i];
-	  break;
-	}
-      }
-      if (!_E) return;
-    }
 
-    // -- Corrector.
+void ParticleSet::locate (const int_t             npt,
+			  const real_t*           x  ,
+			  const real_t*           y  ,
+			  vector<const Element*>& E  ,
+			  vector<real_t>&         r  ,
+			  vector<real_t>&         s  ) const
+// ---------------------------------------------------------------------------
+// Find new elements and r, s locations for particles now at x, y,
+// starting each search from the element the particle was in.
+// Particles which have already left the mesh (E = 0) are skipped.
+// ---------------------------------------------------------------------------
+{
+  int_t i;
 
-    up = _Dom -> u[0] -> probe (_E, _r, _s, zp);
-    vp = _Dom -> u[1] -> probe (_E, _r, _s, zp);
-    wp = _Dom -> u[2] -> probe (_E, _r, _s, zp);
+  for (i = 0; i < npt; i++)
+    if (E[i]) E[i] = _Loc -> locate (x[i], y[i], r[i], s[i], E[i]);
+}
 
-    _p.x += corrector[0] * up;
-    _p.y += corrector[0] * vp;
-    _p.z += corrector[0] * wp;
-    for (i = 1; i < NP; i++) {
-      _p.x += corrector[i] * _u[i - 1];
-      _p.y += corrector[i] * _v[i - 1];
-      _p.z += corrector[i] * _w[i - 1];
-    }
 
-    if (!_E -> locate (_p.x, _p.y, _r, _s, _Work)) {
-      _E = 0;
-      for (i = 0; i < _NEL; i++) {
-	_r = _s = 0.0;
-	if (_Dom -> elmt[i] -> locate (_p.x, _p.y, _r, _s, _Work, guess)) {
-	  _E = _Dom -> elmt[i];
-	  break;
-	}
+void ParticleSet::compact ()
+// ---------------------------------------------------------------------------
+// Remove data for particles that have left the mesh.
+// ---------------------------------------------------------------------------
+{
+  int_t       i, j, n;
+  const int_t NPT = _id.size();
+  const int_t T   = _TORD;
+
+  for (n = 0, i = 0; i < NPT; i++) {
+    if (!_E[i]) continue;
+    if (n != i) {
+      _id   [n] = _id   [i];
+      _ctime[n] = _ctime[i];
+      _step [n] = _step [i];
+      _E    [n] = _E    [i];
+      _r    [n] = _r    [i];
+      _s    [n] = _s    [i];
+      _x    [n] = _x    [i];
+      _y    [n] = _y    [i];
+      _z    [n] = _z    [i];
+      for (j = 0; j < T; j++) {
+	_u[n*T + j] = _u[i*T + j];
+	_v[n*T + j] = _v[i*T + j];
+	if (_NCOM == 3) _w[n*T + j] = _w[i*T + j];
       }
-      if (!_E) return;
     }
-    if   (_p.z < 0.0) _p.z = _Lz - fmod (fabs (_p.z), _Lz);
-    else              _p.z = fmod (_p.z, _Lz);
-
-    // -- Maintain multilevel storage.
-
-    rollv (_u, _TORD);
-    rollv (_v, _TORD);
-    rollv (_w, _TORD);
+    n++;
   }
-}
 
+  if (n == NPT) return;
+
+  _id   .resize (n);
+  _ctime.resize (n);
+  _step .resize (n);
+  _E    .resize (n);
+  _r    .resize (n);
+  _s    .resize (n);
+  _x    .resize (n);
+  _y    .resize (n);
+  _z    .resize (n);
+  _u    .resize (n * T);
+  _v    .resize (n * T);
+  if (_NCOM == 3) _w.resize (n * T);
+}
@@ -1,43 +1,52 @@
 #ifndef PARTICLE_H
 #define PARTICLE_H
 
-class FluidParticle
+class ParticleSet
 // ===========================================================================
 // Class used to locate and integrate positions of massless particles.
+//
+// Particle data are held as a structure of arrays and all particles
+// are advanced together, so that velocity evaluation can be batched
+// (see AuxField::probe).  Every process holds and integrates the
+// complete set; each contributes to velocity evaluation only for the
+// Fourier planes it owns.
 // ===========================================================================
 {
 public:
-  FluidParticle (Domain*, const int_t, Point&);
-  void            integrate (); 
-  int_t           ID        () const { return _id;     }
-  real_t          ctime     () const { return _ctime;  }
-  const  Element* inMesh    () const { return _E;      }
-  const  Point&   location  () const { return _p;      } 
-  static int_t    IDMax     ()       { return _ID_MAX; }
+  ParticleSet  (Domain*);
+  ~ParticleSet () { delete _Loc; }
+
+  bool  add       (const int_t, const Point&);
+  void  integrate ();
+  int_t size      () const { return _id.size(); }
+  void  write     (ostream&) const;
 
 private:
-  const int_t    _id   ;	// Numeric tag.
-  const real_t   _ctime;	// Time of initialisation.
-  int_t          _step ;	// Number of integration steps.
-  const Element* _E    ;        // Pointer to the element particle is in.
-  real_t         _r    ;        // Corresponding "r" location within element.
-  real_t         _s    ;	// likewise for "s".
-  Point          _p    ;	// Physical space location.
-  real_t*        _u    ;	// Multilevel "x" velocity storage.
-  real_t*        _v    ;	// Multilevel "y" velocity storage.
-  real_t*        _w    ;	// Multilevel "z" velocity storage.
+  Domain*                _Dom    ;	// Velocity fields and class functions.
+  Locator*               _Loc    ;	// Spatial search index for 2D mesh.
+  int_t                  _NCOM   ;	// Number of velocity components.
+  int_t                  _TORD   ;	// Order of N--S timestepping.
+  real_t                 _Lz     ;	// Periodic length.
+  vector<real_t>         _P_coeff;	// Integration (predictor) coefficients.
+  vector<real_t>         _C_coeff;	// Integration (corrector) coefficients.
+
+  vector<int_t>          _id     ;	// Numeric tags.
+  vector<real_t>         _ctime  ;	// Times of initialisation.
+  vector<int_t>          _step   ;	// Numbers of integration steps.
+  vector<const Element*> _E      ;	// Elements particles are in.
+  vector<real_t>         _r      ;	// Corresponding "r" locations.
+  vector<real_t>         _s      ;	// likewise for "s".
+  vector<real_t>         _x      ;	// Physical space locations.
+  vector<real_t>         _y      ;
+  vector<real_t>         _z      ;
+  vector<real_t>         _u      ;	// Multilevel velocity storage,
+  vector<real_t>         _v      ;	//   _TORD levels per particle.
+  vector<real_t>         _w      ;
 
-  static Domain* _Dom    ;	// Velocity fields and class functions.
-  static int_t   _NCOM   ;	// Number of velocity components.
-  static int_t   _NEL    ;	// Number of elements in mesh.
-  static int_t   _NZ     ;	// Number of z planes.
-  static int_t   _TORD   ;	// Order of N--S timestepping.
-  static int_t   _ID_MAX ;	// Highest issued id.
-  static real_t* _P_coeff;	// Integration (predictor) coefficients.
-  static real_t* _C_coeff;	// Integration (corrector) coefficients.
-  static real_t* _Work   ;	// Work area for point location routines.
-  static real_t  _DT     ;	// Time step.
-  static real_t  _Lz     ;	// Periodic length.
+  void locate  (const int_t, const real_t*, const real_t*,
+		vector<const Element*>&, vector<real_t>&, vector<real_t>&)
+    const;
+  void compact ();
 };
 
 #endif
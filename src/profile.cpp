@@ -0,0 +1,249 @@
+///////////////////////////////////////////////////////////////////////////////
+// profile.cpp: lightweight run-time profiler, see profile.h.
+//
+// Phase timings and counters are accumulated separately on each
+// process; at the end of the run each process appends its own table
+// (and, for PROFILE > 1, its timeline) to the output files in turn.
+///////////////////////////////////////////////////////////////////////////////
+
+#include <sem.h>
+#include <chrono>
+#include <algorithm>
+
+namespace Profile {
+
+  typedef std::chrono::steady_clock Clock;
+
+  struct Phase { double total, t0; long calls; int depth; };
+  struct Count { double total, mark, last, peak; };
+  struct Event { string phase; int_t step; double t0, t1; };
+
+  static int_t               level = 0;
+  static string              name;
+  static Clock::time_point   origin;
+  static map<string, Phase>  phases;
+  static map<string, int_t> index;	// -- Counter names and handles.
+  static vector<Count>       counters;
+  static long                nstep = 0;
+  static vector<Event>       events;
+
+
+  static double now ()
+  // ------------------------------------------------------------------------
+  // Wall-clock seconds since init.
+  // ------------------------------------------------------------------------
+  {
+    return std::chrono::duration<double> (Clock::now() - origin).count();
+  }
+
+
+  static bool longer (const pair<string, Phase>& a,
+		      const pair<string, Phase>& b)
+  // ------------------------------------------------------------------------
+  // Sort order for report: descending total time.
+  // ------------------------------------------------------------------------
+  {
+    return a.second.total > b.second.total;
+  }
+
+
+  void init (const char* session)
+  // ------------------------------------------------------------------------
+  // Switch on profiling if token PROFILE is set, zero all records.
+  // ------------------------------------------------------------------------
+  {
+    level  = Femlib::ivalue ("PROFILE");
+    name   = session;
+    origin = Clock::now();
+
+    phases  .clear();
+    events  .clear();
+    nstep = 0;
+
+    // -- Counters are zeroed rather than erased, so handles stay good.
+
+    const Count zero = { 0.0, 0.0, 0.0, 0.0 };
+    fill (counters.begin(), counters.end(), zero);
+  }
+
+
+  bool active ()
+  // ------------------------------------------------------------------------
+  // Is profiling on?  Use to avoid building counter names needlessly.
+  // ------------------------------------------------------------------------
+  {
+    return level > 0;
+  }
+
+
+  void start (const char* phase)
+  // ------------------------------------------------------------------------
+  // Start timing phase.  Re-entrant calls are absorbed.
+  // ------------------------------------------------------------------------
+  {
+    if (!level) return;
+
+    Phase& P = phases[phase];
+
+    if (P.depth++ == 0) P.t0 = now();
+  }
+
+
+  void stop (const char* phase)
+  // ------------------------------------------------------------------------
+  // Stop timing phase, add to its total and, if required, the timeline.
+  // ------------------------------------------------------------------------
+  {
+    if (!level) return;
+
+    Phase& P = phases[phase];
+
+    if (P.depth == 0 || --P.depth) return;
+
+    const double t1 = now();
+
+    P.total += t1 - P.t0;
+    P.calls++;
+
+    if (level > 1) {
+      Event E = { phase, Femlib::ivalue ("STEP"), P.t0, t1 };
+      events.push_back (E);
+    }
+  }
+
+
+  Counter counter (const char* name)
+  // ------------------------------------------------------------------------
+  // Return the handle of the named counter, creating it if required.
+  // ------------------------------------------------------------------------
+  {
+    map<string, int_t>::const_iterator c = index.find (name);
+
+    if (c != index.end()) return c -> second;
+
+    const Count zero = { 0.0, 0.0, 0.0, 0.0 };
+    counters.push_back (zero);
+
+    return index[name] = counters.size() - 1;
+  }
+
+
+  void count (const Counter c,
+	      const double  n)
+  // ------------------------------------------------------------------------
+  // Add n to the counter with handle c.
+  // ------------------------------------------------------------------------
+  {
+    if (!level) return;
+
+    counters[c].total += n;
+  }
+
+
+  void count (const char*  name,
+	      const double n   )
+  // ------------------------------------------------------------------------
+  // Add n to the named counter.
+  // ------------------------------------------------------------------------
+  {
+    if (!level) return;
+
+    counters[counter (name)].total += n;
+  }
+
+
+  void step ()
+  // ------------------------------------------------------------------------
+  // Mark the end of a timestep: note what each counter gained during
+  // it, and the peak gain over steps after the first (which includes
+  // start-up work), i.e. the steady-state per-step cost.
+  // ------------------------------------------------------------------------
+  {
+    if (!level) return;
+
+    vector<Count>::iterator c;
+
+    for (c = counters.begin(); c != counters.end(); c++) {
+      Count& C = *c;
+      C.last = C.total - C.mark;
+      C.mark = C.total;
+      if (nstep) C.peak = max (C.peak, C.last);
+    }
+    nstep++;
+  }
+
+
+  void report ()
+  // ------------------------------------------------------------------------
+  // Write summary table to session.prf and (PROFILE > 1) timeline to
+  // session.prf.csv, one process after another.
+  // ------------------------------------------------------------------------
+  {
+    if (!level) return;
+
+    const double elapsed = now();
+    const int_t  nProc   = Geometry::nProc();
+    const int_t  pid     = Geometry::procID();
+    int_t        i, p;
+    char         buf[StrMax];
+
+    vector<pair<string, Phase> > sorted (phases.begin(), phases.end());
+    sort (sorted.begin(), sorted.end(), longer);
+
+    for (p = 0; p < nProc; p++) {
+      if (p == pid) {
+	ios::openmode mode = (p) ? ios::app : ios::out;
+	ofstream      file ((name + ".prf").c_str(), mode);
+
+	sprintf (buf, "# Process %1d of %1d, elapsed time %.3f s",
+		 (int) pid, (int) nProc, elapsed);
+	file << buf << endl;
+	sprintf (buf, "# %-24s %10s %12s %12s %7s",
+		 "phase", "calls", "total (s)", "mean (ms)", "%");
+	file << buf << endl;
+
+	for (i = 0; i < sorted.size(); i++) {
+	  const Phase& P = sorted[i].second;
+	  sprintf (buf, "  %-24s %10ld %12.4f %12.4f %7.2f",
+		   sorted[i].first.c_str(), P.calls, P.total,
+		   (P.calls) ? 1.0e3 * P.total / P.calls : 0.0,
+		   (elapsed > 0.0) ? 100.0 * P.total / elapsed : 0.0);
+	  file << buf << endl;
+	}
+
+	if (counters.size()) {	// -- Those not counted since init are skipped.
+	  if (nstep > 1)
+	    sprintf (buf, "# %-24s %23s %12s %12s", "counter", "value",
+		     "last step", "peak/step");
+	  else
+	    sprintf (buf, "# %-24s %23s", "counter", "value");
+	  file << buf << endl;
+	  map<string, int_t>::const_iterator c;
+	  for (c = index.begin(); c != index.end(); c++) {
+	    const Count& C = counters[c -> second];
+	    if (C.total == 0.0) continue;
+	    if (nstep > 1)
+	      sprintf (buf, "  %-24s %23.0f %12.0f %12.0f",
+		       c -> first.c_str(), C.total, C.last, C.peak);
+	    else
+	      sprintf (buf, "  %-24s %23.0f", c -> first.c_str(), C.total);
+	    file << buf << endl;
+	  }
+	}
+	file << endl;
+
+	if (level > 1) {
+	  ofstream csv ((name + ".prf.csv").c_str(), mode);
+	  if (!p) csv << "process,step,phase,start,end" << endl;
+	  for (i = 0; i < events.size(); i++) {
+	    sprintf (buf, "%1d,%1d,%s,%.6f,%.6f", (int) pid,
+		     (int) events[i].step, events[i].phase.c_str(),
+		     events[i].t0, events[i].t1);
+	    csv << buf << endl;
+	  }
+	}
+      }
+      Message::sync();
+    }
+  }
+}
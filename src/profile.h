@@ -0,0 +1,52 @@
+#ifndef PROFILE_H
+#define PROFILE_H
+
+///////////////////////////////////////////////////////////////////////////////
+// profile.h: lightweight run-time profiler.
+//
+// Named phases are timed (wall clock) with Profile::start/stop or a
+// Profile::Scope object, and named counters accumulated with
+// Profile::count.  Counters bumped on hot paths should be looked up
+// once with Profile::counter and then counted by handle, which
+// avoids making a string key on each call.  Everything is a no-op
+// unless token PROFILE > 0:
+//
+//   PROFILE = 1: write a per-process summary table to session.prf at
+//                the end of the run;
+//   PROFILE = 2: also write every timed interval to session.prf.csv.
+//
+// Times for nested phases are inclusive.  If the caller marks the end
+// of each timestep with Profile::step, counters are also reported per
+// step: for each, the amount added during the last step, and the
+// largest amount added during any step after the first.
+///////////////////////////////////////////////////////////////////////////////
+
+#include <cfemdef.h>
+
+namespace Profile {
+  typedef int_t Counter;
+
+  void    init    (const char* session);
+  bool    active  ();
+  void    start   (const char* phase);
+  void    stop    (const char* phase);
+  Counter counter (const char* name);
+  void    count   (const Counter c,    const double n = 1.0);
+  void    count   (const char*   name, const double n = 1.0);
+  void    step    ();
+  void    report  ();
+
+  class Scope
+  // -------------------------------------------------------------------------
+  // Time the enclosing block as the named phase.
+  // -------------------------------------------------------------------------
+  {
+  public:
+    Scope  (const char* phase) : _phase (phase) { start (_phase); }
+    ~Scope ()                                   { stop  (_phase); }
+  private:
+    const char* _phase;
+  };
+}
+
+#endif
@@ -61,7 +61,9 @@ class Domain;
 class BCmgr;
 class Statistics;
 class HistoryPoint;
-class FluidParticle;
+class ParticleSet;
+class Locator;
+class SparseChol;
 class NumberSys;
 
 #include <analysis.h>
@@ -80,10 +82,15 @@ class NumberSys;
 #include <flowrate.h>
 #include <history.h>
 #include <integration.h>
+#include <locator.h>
 #include <message.h>
 #include <numbersys.h>
 #include <particle.h>
+#include <profile.h>
+#include <sparsechol.h>
 #include <statistics.h>
+#include <storage.h>
+#include <workspace.h>
 
 
 template<class T> inline void rollv (T* u, const int_t n)
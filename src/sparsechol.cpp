@@ -0,0 +1,420 @@
+///////////////////////////////////////////////////////////////////////////////
+// sparsechol.cpp: supernodal sparse Cholesky factorisation for the
+// statically-condensed global Helmholtz matrix.
+//
+// With RCM ordering and banded storage, the factor of a 2D mesh
+// problem with n unknowns has O(n^1.5) words and costs O(n^2) to
+// compute.  Nested dissection reduces these to O(n log n) and
+// O(n^1.5), which matters most for large unstructured meshes.
+//
+// Symbolic analysis follows the standard sequence (see e.g. Davis
+// 2006, Direct Methods for Sparse Linear Systems, SIAM): elimination
+// tree, postorder, column counts by row-subtree traversal, then
+// fundamental supernodes.  Numerical factorisation is right-looking:
+// each supernode's diagonal block is factored (POTRF), the block
+// below it solved for (TRSM), and the update (SYRK) scattered into
+// the supernodes of later columns.
+//
+// See also matrix.cpp and George & Liu (1981).
+///////////////////////////////////////////////////////////////////////////////
+
+#include <sem.h>
+#include <algorithm>
+
+
+static void lowerGraph (const int_t          n     ,
+			const vector<int_t>& xadj  ,
+			const vector<int_t>& adjncy,
+			const vector<int_t>& perm  ,
+			const vector<int_t>& iperm ,
+			vector<int_t>&       lx    ,
+			vector<int_t>&       ladj  )
+// ---------------------------------------------------------------------------
+// From the 0-based (xadj, adjncy) graph of global nodes, build for
+// each permuted node k the list of neighbours j < k in permuted
+// numbering, i.e. the strictly-lower pattern of row k of the
+// permuted matrix.  Global nodes numbered n or above are ignored.
+// ---------------------------------------------------------------------------
+{
+  int_t i, j, k, p;
+
+  lx.resize (n + 1);
+  ladj.clear ();
+
+  for (k = 0; k < n; k++) {
+    lx[k] = ladj.size();
+    for (i = perm[k], p = xadj[i]; p < xadj[i + 1]; p++)
+      if (adjncy[p] < n && (j = iperm[adjncy[p]]) < k) ladj.push_back (j);
+  }
+  lx[n] = ladj.size();
+}
+
+
+static void elimTree (const int_t          n     ,
+		      const vector<int_t>& lx    ,
+		      const vector<int_t>& ladj  ,
+		      vector<int_t>&       parent)
+// ---------------------------------------------------------------------------
+// Elimination tree of the permuted matrix (Liu's algorithm with path
+// compression).  Roots have parent -1.
+// ---------------------------------------------------------------------------
+{
+  vector<int_t> ancestor (n);
+  int_t         i, k, p, r;
+
+  parent.resize (n);
+
+  for (k = 0; k < n; k++) {
+    parent[k] = ancestor[k] = -1;
+    for (p = lx[k]; p < lx[k + 1]; p++) {
+      for (r = ladj[p]; ancestor[r] != -1 && ancestor[r] != k; r = i) {
+	i           = ancestor[r];
+	ancestor[r] = k;
+      }
+      if (ancestor[r] == -1) ancestor[r] = parent[r] = k;
+    }
+  }
+}
+
+
+static void postOrder (const int_t          n     ,
+		       const vector<int_t>& parent,
+		       vector<int_t>&       post  )
+// ---------------------------------------------------------------------------
+// Depth-first postorder of the elimination tree: post[k] is the node
+// visited k-th.
+// ---------------------------------------------------------------------------
+{
+  vector<int_t> head (n, -1), next (n, -1), stack;
+  int_t         j, k, p, c;
+
+  post.resize (n);
+
+  for (j = n - 1; j >= 0; j--)
+    if (parent[j] != -1) { next[j] = head[parent[j]]; head[parent[j]] = j; }
+
+  for (k = 0, j = 0; j < n; j++) {
+    if (parent[j] != -1) continue;
+    stack.push_back (j);
+    while (!stack.empty()) {
+      p = stack.back();
+      if ((c = head[p]) == -1) {
+	stack.pop_back();
+	post[k++] = p;
+      } else {
+	head[p] = next[c];
+	stack.push_back (c);
+      }
+    }
+  }
+}
+
+
+SparseChol::SparseChol (const AssemblyMap* A,
+			const int_t        n) :
+// ---------------------------------------------------------------------------
+// Carry out ordering and symbolic factorisation for the first n
+// (solved-for) global nodes of A, and allocate zeroed storage for
+// the matrix.  Normally n = A -> nSolve(), but it may be one less
+// for singular systems, see MatrixSys::MatrixSys.
+// ---------------------------------------------------------------------------
+  _n     (n),
+  _flops (0.0),
+  _perm  (n),
+  _iperm (n)
+{
+  vector<int_t> xadj, adjncy, lx, ladj, parent, post, cnt, mark;
+  int_t         i, j, k, p, s;
+
+  _super.assign (1, 0);
+  _xrow .assign (1, 0);
+  _xval .assign (1, 0);
+
+  if (!_n) return;
+
+  A -> buildAdjncySC (adjncy, xadj, 0);
+
+  // -- Nested-dissection ordering (SPARSEPAK, 1-based).
+
+  {
+    vector<int_t> gx (_n + 1), gadj, mask (_n), xls (_n + 1), ls (_n);
+
+    for (i = 0; i < _n; i++) {
+      gx[i] = gadj.size() + 1;
+      for (p = xadj[i]; p < xadj[i + 1]; p++)
+	if (adjncy[p] < _n) gadj.push_back (adjncy[p] + 1);
+    }
+    gx[_n] = gadj.size() + 1;
+    gadj.push_back (0);
+
+    Femlib::gennd (_n, &gx[0], &gadj[0], &mask[0], &_perm[0], &xls[0], &ls[0]);
+
+    for (k = 0; k < _n; k++) _iperm[--_perm[k]] = k;
+  }
+
+  // -- Postorder elimination tree so supernodes are contiguous.
+
+  lowerGraph (_n, xadj, adjncy, _perm, _iperm, lx, ladj);
+  elimTree   (_n, lx, ladj, parent);
+  postOrder  (_n, parent, post);
+
+  for (k = 0; k < _n; k++) post[k] = _perm[post[k]];
+  _perm = post;
+  for (k = 0; k < _n; k++) _iperm[_perm[k]] = k;
+
+  lowerGraph (_n, xadj, adjncy, _perm, _iperm, lx, ladj);
+  elimTree   (_n, lx, ladj, parent);
+
+  // -- Off-diagonal column counts of factor, by row subtrees.
+
+  cnt .assign (_n, 0);
+  mark.assign (_n, -1);
+
+  for (i = 0; i < _n; i++) {
+    mark[i] = i;
+    for (p = lx[i]; p < lx[i + 1]; p++)
+      for (k = ladj[p]; mark[k] != i; k = parent[k]) { cnt[k]++; mark[k] = i; }
+  }
+
+  // -- Fundamental supernodes: chains with nested column structure.
+
+  _snode.resize (_n);
+
+  for (s = 0, k = 0; k < _n; k++) {
+    if (k && !(parent[k - 1] == k && cnt[k - 1] == cnt[k] + 1)) {
+      _super.push_back (k);
+      s++;
+    }
+    _snode[k] = s;
+    _flops   += sqr (static_cast<double>(cnt[k] + 1));
+  }
+  _super.push_back (_n);
+
+  // -- Row structure of each supernode is that of its first column.
+
+  const int_t nsuper = _super.size() - 1;
+
+  _xrow.resize (nsuper + 1);
+  _xval.resize (nsuper + 1);
+
+  for (s = 0; s < nsuper; s++) {
+    j            = cnt[_super[s]] + 1;
+    _xrow[s + 1] = _xrow[s] + j;
+    _xval[s + 1] = _xval[s] + static_cast<size_t>(j) * (_super[s+1]-_super[s]);
+  }
+
+  _row.resize (_xrow[nsuper]);
+  for (s = 0; s < nsuper; s++) _row[_xrow[s]] = _super[s];
+
+  vector<int_t> next (_xrow.begin(), _xrow.end() - 1);
+  for (s = 0; s < nsuper; s++) next[s]++;
+
+  mark.assign (_n, -1);
+
+  for (i = 0; i < _n; i++) {
+    mark[i] = i;
+    for (p = lx[i]; p < lx[i + 1]; p++)
+      for (k = ladj[p]; mark[k] != i; k = parent[k]) {
+	mark[k] = i;
+	if (k == _super[s = _snode[k]]) _row[next[s]++] = i;
+      }
+  }
+
+  _val.assign (_xval[nsuper], 0.0);
+}
+
+
+void SparseChol::add (const int_t  i,
+		      const int_t  j,
+		      const real_t v)
+// ---------------------------------------------------------------------------
+// Add v to matrix entry (i, j), given in global numbering.  Since the
+// matrix is symmetric only one of (i, j) and (j, i) should be added.
+// ---------------------------------------------------------------------------
+{
+  const char routine[] = "SparseChol::add";
+  int_t      r = _iperm[i], c = _iperm[j];
+
+  if (r < c) swap (r, c);
+
+  const int_t  s    = _snode[c];
+  const int_t  nrow = _xrow[s + 1] - _xrow[s];
+  const int_t* rows = &_row[_xrow[s]];
+  const int_t  p    = lower_bound (rows, rows + nrow, r) - rows;
+
+  if (p == nrow || rows[p] != r)
+    Veclib::alert (routine, "entry outside symbolic structure", ERROR);
+
+  _val[_xval[s] + static_cast<size_t>(c - _super[s]) * nrow + p] += v;
+}
+
+
+bool SparseChol::factor ()
+// ---------------------------------------------------------------------------
+// Overwrite the assembled matrix by its Cholesky factor L.  Return
+// false if the matrix is found not to be positive definite.
+// ---------------------------------------------------------------------------
+{
+  const int_t    nsuper = _super.size() - 1;
+  vector<int_t>  relpos (_n);
+  vector<real_t> U;
+  int_t          s, t, f, ncol, nrow, m, ii, jj, c, ldt, info;
+  const int_t*   rows;
+  real_t         *L, *dst;
+
+  for (s = 0; s < nsuper; s++) {
+    f    = _super[s];
+    ncol = _super[s + 1] - f;
+    nrow = _xrow [s + 1] - _xrow[s];
+    m    = nrow - ncol;
+    L    = &_val[_xval[s]];
+
+    Lapack::potrf ("L", ncol, L, nrow, info);
+    if (info) return false;
+
+    if (!m) continue;
+
+    Blas::trsm ("R", "L", "T", "N", m, ncol, 1.0, L, nrow, L + ncol, nrow);
+
+    if (U.size() < static_cast<size_t>(m) * m) U.resize (static_cast<size_t>(m) * m);
+    Blas::syrk ("L", "N", m, ncol, 1.0, L + ncol, nrow, 0.0, &U[0], m);
+
+    // -- Subtract lower triangle of update from later supernodes.
+
+    rows = &_row[_xrow[s] + ncol];
+
+    for (t = -1, ldt = 0, jj = 0; jj < m; jj++) {
+      c = rows[jj];
+      if (_snode[c] != t) {
+	t   = _snode[c];
+	ldt = _xrow[t + 1] - _xrow[t];
+	for (ii = 0; ii < ldt; ii++) relpos[_row[_xrow[t] + ii]] = ii;
+      }
+      dst = &_val[_xval[t] + static_cast<size_t>(c - _super[t]) * ldt];
+      for (ii = jj; ii < m; ii++)
+	dst[relpos[rows[ii]]] -= U[ii + static_cast<size_t>(jj) * m];
+    }
+  }
+
+  return true;
+}
+
+
+void SparseChol::solve (real_t* x) const
+// ---------------------------------------------------------------------------
+// Solve L L^T y = x in place, where x (length n) has global numbering.
+// ---------------------------------------------------------------------------
+{
+  if (!_n) return;
+
+  const int_t       nsuper = _super.size() - 1;
+  Workspace::Vector work (2 * _n);
+  real_t            *y = &work[0], *w = y + _n;
+  const real_t*     L;
+  const int_t*      rows;
+  int_t             k, s, f, ncol, nrow, m;
+
+  for (k = 0; k < _n; k++) y[k] = x[_perm[k]];
+
+  // -- Forward substitution.
+
+  for (s = 0; s < nsuper; s++) {
+    f    = _super[s];
+    ncol = _super[s + 1] - f;
+    nrow = _xrow [s + 1] - _xrow[s];
+    m    = nrow - ncol;
+    L    = &_val[_xval[s]];
+    rows = &_row[_xrow[s] + ncol];
+
+    Blas::trsv ("L", "N", "N", ncol, L, nrow, y + f, 1);
+    if (m) {
+      Blas::gemv ("N", m, ncol, 1.0, L + ncol, nrow, y + f, 1, 0.0, w, 1);
+      for (k = 0; k < m; k++) y[rows[k]] -= w[k];
+    }
+  }
+
+  // -- Back substitution.
+
+  for (s = nsuper - 1; s >= 0; s--) {
+    f    = _super[s];
+    ncol = _super[s + 1] - f;
+    nrow = _xrow [s + 1] - _xrow[s];
+    m    = nrow - ncol;
+    L    = &_val[_xval[s]];
+    rows = &_row[_xrow[s] + ncol];
+
+    if (m) {
+      for (k = 0; k < m; k++) w[k] = y[rows[k]];
+      Blas::gemv ("T", m, ncol, -1.0, L + ncol, nrow, w, 1, 1.0, y + f, 1);
+    }
+    Blas::trsv ("L", "T", "N", ncol, L, nrow, y + f, 1);
+  }
+
+  for (k = 0; k < _n; k++) x[_perm[k]] = y[k];
+}
+
+
+void SparseChol::solve (real_t*     x   ,
+			const int_t nrhs,
+			const int_t ldx ) const
+// ---------------------------------------------------------------------------
+// As above, for nrhs right-hand sides at once, held as the columns
+// (each of leading dimension ldx) of x.  Supernode blocks are applied
+// with BLAS level 3 calls, so the factor is traversed once for all
+// columns.  A single column is solved exactly as above.
+// ---------------------------------------------------------------------------
+{
+  if (nrhs == 1) { this -> solve (x); return; }
+  if (!_n) return;
+
+  const int_t       nsuper = _super.size() - 1;
+  Workspace::Vector work (2 * _n * nrhs);
+  real_t            *y = &work[0], *w = y + _n * nrhs;
+  const real_t*     L;
+  const int_t*      rows;
+  int_t             j, k, s, f, ncol, nrow, m;
+
+  for (j = 0; j < nrhs; j++)
+    for (k = 0; k < _n; k++) y[j*_n + k] = x[j*ldx + _perm[k]];
+
+  // -- Forward substitution.
+
+  for (s = 0; s < nsuper; s++) {
+    f    = _super[s];
+    ncol = _super[s + 1] - f;
+    nrow = _xrow [s + 1] - _xrow[s];
+    m    = nrow - ncol;
+    L    = &_val[_xval[s]];
+    rows = &_row[_xrow[s] + ncol];
+
+    Blas::trsm ("L", "L", "N", "N", ncol, nrhs, 1.0, L, nrow, y + f, _n);
+    if (m) {
+      Blas::gemm ("N", "N", m, nrhs, ncol, 1.0, L + ncol, nrow,
+		  y + f, _n, 0.0, w, m);
+      for (j = 0; j < nrhs; j++)
+	for (k = 0; k < m; k++) y[j*_n + rows[k]] -= w[j*m + k];
+    }
+  }
+
+  // -- Back substitution.
+
+  for (s = nsuper - 1; s >= 0; s--) {
+    f    = _super[s];
+    ncol = _super[s + 1] - f;
+    nrow = _xrow [s + 1] - _xrow[s];
+    m    = nrow - ncol;
+    L    = &_val[_xval[s]];
+    rows = &_row[_xrow[s] + ncol];
+
+    if (m) {
+      for (j = 0; j < nrhs; j++)
+	for (k = 0; k < m; k++) w[j*m + k] = y[j*_n + rows[k]];
+      Blas::gemm ("T", "N", ncol, nrhs, m, -1.0, L + ncol, nrow,
+		  w, m, 1.0, y + f, _n);
+    }
+    Blas::trsm ("L", "L", "T", "N", ncol, nrhs, 1.0, L, nrow, y + f, _n);
+  }
+
+  for (j = 0; j < nrhs; j++)
+    for (k = 0; k < _n; k++) x[j*ldx + _perm[k]] = y[j*_n + k];
+}
@@ -0,0 +1,48 @@
+#ifndef SPARSECHOL_H
+#define SPARSECHOL_H
+
+
+class SparseChol
+// ===========================================================================
+// Supernodal sparse Cholesky factorisation of a statically-condensed
+// global Helmholtz matrix, used by MatrixSys as an alternative to
+// LAPACK symmetric-banded storage when token SPARSE_CHOL > 0.
+//
+// The unknowns are reordered by nested dissection (SPARSEPAK GENND)
+// applied to the element-boundary node graph of an AssemblyMap, then
+// postordered on the elimination tree so that columns with the same
+// sparsity pattern below the diagonal are contiguous and can be
+// grouped into supernodes.  Each supernode is stored as a dense
+// column-major block (rows = the structure of its first column), so
+// that factorisation and solution work through BLAS level 3 & 2 calls.
+//
+// Matrix entries are supplied (and solutions returned) with the
+// global numbering of the AssemblyMap; the permutation is internal.
+// ===========================================================================
+{
+public:
+  SparseChol  (const AssemblyMap*, const int_t);
+  ~SparseChol () { }
+
+  void   add    (const int_t, const int_t, const real_t);
+  bool   factor ();
+  void   solve  (real_t*) const;
+  void   solve  (real_t*, const int_t, const int_t) const;
+
+  size_t words  () const { return _val.size(); }
+  double flops  () const { return _flops;      }
+
+private:
+  int_t          _n    ;	// Number of unknowns.
+  double         _flops;	// Operation count estimate for factor.
+  vector<int_t>  _perm ;	// Elimination order: _perm[k] = global node.
+  vector<int_t>  _iperm;	// Inverse of _perm.
+  vector<int_t>  _super;	// First column of each supernode, + terminal.
+  vector<int_t>  _snode;	// Supernode owning each (permuted) column.
+  vector<int_t>  _xrow ;	// Start of each supernode's row list in _row.
+  vector<int_t>  _row  ;	// Row indices (permuted, ascending) by supernode.
+  vector<size_t> _xval ;	// Start of each supernode's block in _val.
+  vector<real_t> _val  ;	// Supernode blocks of matrix/Cholesky factor.
+};
+
+#endif
@@ -114,19 +114,19 @@ Statistics::Statistics (Domain* D) :
   if (_iavg > 0) // -- Set up buffers for averages of raw variables.
     for (i = 0; i < _nraw; i++)
       _avg[_base -> u[i] -> name()] =
-	new AuxField (new real_t[ntot],nz,_base->elmt,_base->u[i]->name());
+	new AuxField (Storage::allocate (ntot, nz),nz,_base->elmt,_base->u[i]->name());
 
   if (_iavg > 1) {// -- Set up buffers for Reynolds stress correlations.
     if(_nvel == 3 || (_nvel == 2 && !_do_scat))
       for (i = 0; i < _nrey; i++)
-        _avg['A' + i] = new AuxField (new real_t[ntot],nz,_base->elmt,'A'+i);
+        _avg['A' + i] = new AuxField (Storage::allocate (ntot, nz),nz,_base->elmt,'A'+i);
     else {
-      _avg['A'] = new AuxField (new real_t[ntot],nz,_base->elmt,'A');
-      _avg['B'] = new AuxField (new real_t[ntot],nz,_base->elmt,'B');
-      _avg['C'] = new AuxField (new real_t[ntot],nz,_base->elmt,'C');
-      _avg['G'] = new AuxField (new real_t[ntot],nz,_base->elmt,'G');
-      _avg['H'] = new AuxField (new real_t[ntot],nz,_base->elmt,'H');
-      _avg['J'] = new AuxField (new real_t[ntot],nz,_base->elmt,'J');
+      _avg['A'] = new AuxField (Storage::allocate (ntot, nz),nz,_base->elmt,'A');
+      _avg['B'] = new AuxField (Storage::allocate (ntot, nz),nz,_base->elmt,'B');
+      _avg['C'] = new AuxField (Storage::allocate (ntot, nz),nz,_base->elmt,'C');
+      _avg['G'] = new AuxField (Storage::allocate (ntot, nz),nz,_base->elmt,'G');
+      _avg['H'] = new AuxField (Storage::allocate (ntot, nz),nz,_base->elmt,'H');
+      _avg['J'] = new AuxField (Storage::allocate (ntot, nz),nz,_base->elmt,'J');
     }
   }
 
@@ -134,39 +134,39 @@ Statistics::Statistics (Domain* D) :
 
     // -- Scalar.
 
-    _avg['q'] = new AuxField (new real_t[ntot],nz,_base->elmt,'q'); ++_neng;
-    _avg['d'] = new AuxField (new real_t[ntot],nz,_base->elmt,'d'); ++_neng;
+    _avg['q'] = new AuxField (Storage::allocate (ntot, nz),nz,_base->elmt,'q'); ++_neng;
+    _avg['d'] = new AuxField (Storage::allocate (ntot, nz),nz,_base->elmt,'d'); ++_neng;
 
     // -- Vector.
 
-    _avg['m'] = new AuxField (new real_t[ntot],nz,_base->elmt,'m'); ++_neng;
-    _avg['n'] = new AuxField (new real_t[ntot],nz,_base->elmt,'n'); ++_neng;
+    _avg['m'] = new AuxField (Storage::allocate (ntot, nz),nz,_base->elmt,'m'); ++_neng;
+    _avg['n'] = new AuxField (Storage::allocate (ntot, nz),nz,_base->elmt,'n'); ++_neng;
     if (_nvel == 3) {
-      _avg['o'] = new AuxField (new real_t[ntot],nz,_base->elmt,'o'); ++_neng;
+      _avg['o'] = new AuxField (Storage::allocate (ntot, nz),nz,_base->elmt,'o'); ++_neng;
     }
 
-    _avg['r'] = new AuxField (new real_t[ntot],nz,_base->elmt,'r'); ++_neng;
-    _avg['s'] = new AuxField (new real_t[ntot],nz,_base->elmt,'s'); ++_neng;
+    _avg['r'] = new AuxField (Storage::allocate (ntot, nz),nz,_base->elmt,'r'); ++_neng;
+    _avg['s'] = new AuxField (Storage::allocate (ntot, nz),nz,_base->elmt,'s'); ++_neng;
     if (_nvel == 3) {
-      _avg['t'] = new AuxField (new real_t[ntot],nz,_base->elmt,'t'); ++_neng;
+      _avg['t'] = new AuxField (Storage::allocate (ntot, nz),nz,_base->elmt,'t'); ++_neng;
     }
 
-    _avg['R'] = new AuxField (new real_t[ntot],nz,_base->elmt,'R'); ++_neng;
-    _avg['S'] = new AuxField (new real_t[ntot],nz,_base->elmt,'S'); ++_neng;
+    _avg['R'] = new AuxField (Storage::allocate (ntot, nz),nz,_base->elmt,'R'); ++_neng;
+    _avg['S'] = new AuxField (Storage::allocate (ntot, nz),nz,_base->elmt,'S'); ++_neng;
     if (_nvel == 3) {
-      _avg['T'] = new AuxField (new real_t[ntot],nz,_base->elmt,'T'); ++_neng;
+      _avg['T'] = new AuxField (Storage::allocate (ntot, nz),nz,_base->elmt,'T'); ++_neng;
     }
       
     // -- Tensor.
     
-    _avg['K'] = new AuxField (new real_t[ntot],nz,_base->elmt,'K'); ++_neng;
-    _avg['L'] = new AuxField (new real_t[ntot],nz,_base->elmt,'L'); ++_neng;
-    _avg['M'] = new AuxField (new real_t[ntot],nz,_base->elmt,'M'); ++_neng;
+    _avg['K'] = new AuxField (Storage::allocate (ntot, nz),nz,_base->elmt,'K'); ++_neng;
+    _avg['L'] = new AuxField (Storage::allocate (ntot, nz),nz,_base->elmt,'L'); ++_neng;
+    _avg['M'] = new AuxField (Storage::allocate (ntot, nz),nz,_base->elmt,'M'); ++_neng;
 
     if (_nvel == 3) {
-      _avg['N'] = new AuxField (new real_t[ntot],nz,_base->elmt,'N'); ++_neng;
-      _avg['O'] = new AuxField (new real_t[ntot],nz,_base->elmt,'O'); ++_neng;
-      _avg['P'] = new AuxField (new real_t[ntot],nz,_base->elmt,'P'); ++_neng;
+      _avg['N'] = new AuxField (Storage::allocate (ntot, nz),nz,_base->elmt,'N'); ++_neng;
+      _avg['O'] = new AuxField (Storage::allocate (ntot, nz),nz,_base->elmt,'O'); ++_neng;
+      _avg['P'] = new AuxField (Storage::allocate (ntot, nz),nz,_base->elmt,'P'); ++_neng;
     }
   }
 }
@@ -481,6 +481,38 @@ void Statistics::dump (const char* filename)
 }
 
 
+void Statistics::writeState (ostream& strm)
+// ---------------------------------------------------------------------------
+// Binary write of the number of averages and the averaging buffers,
+// just as held internally (some in Fourier space), for an exact warm
+// restart.  Unlike dump, no transforms are made.
+// ---------------------------------------------------------------------------
+{
+  map<char, AuxField*>::iterator k;
+
+  ROOTONLY strm.write (reinterpret_cast<char*>(&_navg), sizeof (int_t));
+  for (k = _avg.begin(); k != _avg.end(); k++) strm << *(k -> second);
+}
+
+
+void Statistics::readState (istream& strm)
+// ---------------------------------------------------------------------------
+// Inverse of writeState.
+// ---------------------------------------------------------------------------
+{
+  const int_t nProc = Geometry::nProc();
+  int_t       i;
+  map<char, AuxField*>::iterator k;
+
+  ROOTONLY {
+    strm.read (reinterpret_cast<char*>(&_navg), sizeof (int_t));
+    for (i = 1; i < nProc; i++) Message::send (&_navg, 1, i);
+  } else Message::recv (&_navg, 1, 0);
+
+  for (k = _avg.begin(); k != _avg.end(); k++) strm >> *(k -> second);
+}
+
+
 ofstream& operator << (ofstream&   strm,
 		       Statistics& src )
 // ---------------------------------------------------------------------------
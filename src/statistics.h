@@ -14,6 +14,8 @@ public:
   void initialise  (const char*);
   void update      (AuxField**, AuxField**); // -- Two work arrays supplied.
   void dump        (const char*);
+  void writeState  (ostream&);
+  void readState   (istream&);
 
   void phaseUpdate (const int_t, AuxField**, AuxField**);
 
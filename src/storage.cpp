@@ -0,0 +1,104 @@
+///////////////////////////////////////////////////////////////////////////////
+// storage.cpp: aligned, first-touch, optionally huge-page storage, see
+// storage.h.
+///////////////////////////////////////////////////////////////////////////////
+
+#include <sem.h>
+#include <mutex>
+#include <sys/mman.h>
+
+namespace Storage {
+
+  static const size_t Align    = 64;
+  static const size_t HugePage = 2 << 20;
+
+  struct Block { size_t bytes; bool mapped; };
+
+  static map<real_t*, Block> blocks;
+  static mutex               lock;
+
+
+  static size_t roundUp (const size_t n, const size_t a)
+  // ------------------------------------------------------------------------
+  // Return n rounded up to a multiple of a.
+  // ------------------------------------------------------------------------
+  {
+    return ((n + a - 1) / a) * a;
+  }
+
+
+  real_t* allocate (const size_t n     ,
+		    const size_t nchunk)
+  // ------------------------------------------------------------------------
+  // Return a zeroed, aligned block of n words, first touched in nchunk
+  // contiguous pieces (e.g. planes) of n / nchunk words.
+  // ------------------------------------------------------------------------
+  {
+    const char    routine[] = "Storage::allocate";
+    static int_t  huge      = -1;
+    const size_t  bytes     = max (roundUp (n * sizeof (real_t), Align), Align);
+    void*         p         = 0;
+    Block         B         = { bytes, false };
+
+    if (huge < 0) huge = Femlib::ivalue ("HUGEPAGE");
+
+    if (huge > 1 && bytes >= HugePage) {
+      B.bytes = roundUp (bytes, HugePage);
+      p = mmap (0, B.bytes, PROT_READ | PROT_WRITE,
+		MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+      if (p == MAP_FAILED) {
+	Veclib::alert (routine, "no explicit huge pages available, "
+		       "using transparent huge pages", WARNING);
+	p = 0; huge = 1; B.bytes = bytes;
+      } else
+	B.mapped = true;
+    }
+
+    if (!p) {
+      const size_t align = (huge > 0 && bytes >= HugePage) ? HugePage : Align;
+      if (posix_memalign (&p, align, bytes))
+	Veclib::alert (routine, "allocation failed", ERROR);
+#if defined (MADV_HUGEPAGE)
+      if (align == HugePage) madvise (p, bytes, MADV_HUGEPAGE);
+#endif
+    }
+
+    // -- First touch, plane by plane.
+
+    real_t*      data  = static_cast<real_t*> (p);
+    const size_t chunk = (nchunk > 1) ? n / nchunk : n;
+    long         c;
+
+#if defined (_OPENMP)
+    #pragma omp parallel for schedule(static)
+#endif
+    for (c = 0; c < static_cast<long>(nchunk); c++)
+      Veclib::zero (chunk, data + c * chunk, 1);
+    if (chunk * nchunk < n)
+      Veclib::zero (n - chunk * nchunk, data + chunk * nchunk, 1);
+
+    lock_guard<mutex> guard (lock);
+    blocks[data] = B;
+
+    return data;
+  }
+
+
+  void release (real_t* data)
+  // ------------------------------------------------------------------------
+  // Free data, from allocate or from new[].
+  // ------------------------------------------------------------------------
+  {
+    if (!data) return;
+
+    lock_guard<mutex> guard (lock);
+    map<real_t*, Block>::iterator b = blocks.find (data);
+
+    if (b == blocks.end()) { delete[] data; return; }
+
+    if (b -> second.mapped) munmap (data, b -> second.bytes);
+    else                    free   (data);
+
+    blocks.erase (b);
+  }
+}
@@ -0,0 +1,35 @@
+#ifndef STORAGE_H
+#define STORAGE_H
+
+///////////////////////////////////////////////////////////////////////////////
+// storage.h: allocator for long-lived bulk real_t storage (AuxField
+// data areas, MatrixSys matrices and preconditioners).
+//
+// Every block is 64-byte (cache line, SIMD register) aligned; with
+// Geometry::planeSize a multiple of 8 words in 3D, every data plane
+// of an AuxField area is then aligned too.  Blocks are zeroed on
+// allocation, chunk by chunk (one chunk per data plane), which is the
+// first touch that places their pages in memory local to the process,
+// or with OpenMP to the thread, that works on each plane.
+//
+// Large blocks (2 MB and more) can be backed by huge pages, set by
+// token HUGEPAGE:
+//   0: ordinary pages (default);
+//   1: transparent huge pages, requested with madvise;
+//   2: explicit huge pages (mmap MAP_HUGETLB, which needs pages
+//      reserved via /proc/sys/vm/nr_hugepages); if none are
+//      available, a warning is issued and 1 is used instead.
+//
+// Storage::release must be used to free blocks from allocate.  It
+// also accepts storage from new[], so that owners such as Family that
+// hold a mixture can use it for everything.
+///////////////////////////////////////////////////////////////////////////////
+
+#include <cfemdef.h>
+
+namespace Storage {
+  real_t* allocate (const size_t n, const size_t nchunk = 1);
+  void    release  (real_t*);
+}
+
+#endif
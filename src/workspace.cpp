@@ -0,0 +1,100 @@
+///////////////////////////////////////////////////////////////////////////////
+// workspace.cpp: persistent scratch arena, see workspace.h.
+//
+// Each thread holds a stack of free blocks for each size class, class
+// c holding blocks of 2^c words, with separate stacks for real_t and
+// float blocks.  Blocks are only returned to the heap when the thread
+// exits.
+///////////////////////////////////////////////////////////////////////////////
+
+#include <sem.h>
+
+namespace Workspace {
+
+  static const int_t MinClass = 4;	// -- Smallest block: 16 words.
+  static const int_t NClass   = 8 * sizeof (size_t);
+
+  template<class T> struct Arena {
+    vector<T*> free[NClass];
+    ~Arena () {
+      for (int_t c = 0; c < NClass; c++)
+	for (size_t i = 0; i < free[c].size(); i++) delete [] free[c][i];
+    }
+  };
+
+  static thread_local Arena<real_t> arena;
+  static thread_local Arena<float>  farena;
+
+
+  template<class T>
+  static T* draw (Arena<T>&    A        ,
+		  const size_t n        ,
+		  int_t&       sizeClass)
+  // ------------------------------------------------------------------------
+  // Return a block of at least n words from A, and its size class.
+  // ------------------------------------------------------------------------
+  {
+    static const Profile::Counter requests = Profile::counter
+      ("scratch_requests");
+    static const Profile::Counter heapAllocs = Profile::counter
+      ("scratch_heap_allocs");
+    int_t c = MinClass;
+
+    while ((static_cast<size_t>(1) << c) < n) c++;
+
+    sizeClass = c;
+    Profile::count (requests);
+
+    vector<T*>& pool = A.free[c];
+
+    if (pool.empty()) {
+      Profile::count (heapAllocs);
+      return new T [static_cast<size_t>(1) << c];
+    }
+
+    T* block = pool.back();
+    pool.pop_back();
+
+    return block;
+  }
+
+
+  real_t* take (const size_t n        ,
+		int_t&       sizeClass)
+  // ------------------------------------------------------------------------
+  // Return a block of at least n real_t, and its size class for give.
+  // ------------------------------------------------------------------------
+  {
+    return draw (arena, n, sizeClass);
+  }
+
+
+  float* takeFloat (const size_t n        ,
+		    int_t&       sizeClass)
+  // ------------------------------------------------------------------------
+  // Return a block of at least n float, and its size class for give.
+  // ------------------------------------------------------------------------
+  {
+    return draw (farena, n, sizeClass);
+  }
+
+
+  void give (real_t*     block    ,
+	     const int_t sizeClass)
+  // ------------------------------------------------------------------------
+  // Return block, obtained from take, to the free pool.
+  // ------------------------------------------------------------------------
+  {
+    arena.free[sizeClass].push_back (block);
+  }
+
+
+  void give (float*      block    ,
+	     const int_t sizeClass)
+  // ------------------------------------------------------------------------
+  // Return block, obtained from takeFloat, to the free pool.
+  // ------------------------------------------------------------------------
+  {
+    farena.free[sizeClass].push_back (block);
+  }
+}
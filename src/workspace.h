@@ -0,0 +1,74 @@
+#ifndef WORKSPACE_H
+#define WORKSPACE_H
+
+///////////////////////////////////////////////////////////////////////////////
+// workspace.h: persistent arena for short-lived real_t scratch storage.
+//
+// Routines called every step (per plane, per element, per point)
+// need temporary vectors.  Allocating these from the heap on every
+// call costs a malloc/free pair each time.  Instead, Workspace::Vector
+// takes a block from a per-thread pool of power-of-two size classes
+// and returns it to the pool on destruction, so blocks are reused
+// from one call (and step) to the next.  Contents are not initialised.
+// Workspace::FloatVector does the same for the single-precision
+// scratch of MIXED_PREC solves, from a pool of its own.
+//
+// With token PROFILE > 0, Profile counters scratch_requests (number of
+// Workspace::Vectors made: each previously a heap allocation) and
+// scratch_heap_allocs (blocks the arena actually allocated) can be
+// compared to see the allocations saved per step.  Their per-step
+// columns in the dns profile report show the steady state: after
+// start-up, scratch_heap_allocs should not grow at all.
+///////////////////////////////////////////////////////////////////////////////
+
+#include <cfemdef.h>
+
+namespace Workspace {
+  real_t* take      (const size_t n, int_t& sizeClass);
+  float*  takeFloat (const size_t n, int_t& sizeClass);
+  void    give      (real_t* block, const int_t sizeClass);
+  void    give      (float*  block, const int_t sizeClass);
+
+  class Vector
+  // -------------------------------------------------------------------------
+  // Scratch vector of n real_t drawn from the arena for its lifetime.
+  // -------------------------------------------------------------------------
+  {
+  public:
+    Vector  (const size_t n) : _data (take (n, _class)) { }
+    ~Vector ()                                          { give (_data, _class); }
+
+    real_t&       operator[] (const size_t i)       { return _data[i]; }
+    const real_t& operator[] (const size_t i) const { return _data[i]; }
+
+  private:
+    int_t   _class;
+    real_t* _data ;
+
+    Vector (const Vector&);
+    Vector& operator = (const Vector&);
+  };
+
+
+  class FloatVector
+  // -------------------------------------------------------------------------
+  // Scratch vector of n float drawn from the arena for its lifetime.
+  // -------------------------------------------------------------------------
+  {
+  public:
+    FloatVector  (const size_t n) : _data (takeFloat (n, _class)) { }
+    ~FloatVector ()                                  { give (_data, _class); }
+
+    float&       operator[] (const size_t i)       { return _data[i]; }
+    const float& operator[] (const size_t i) const { return _data[i]; }
+
+  private:
+    int_t  _class;
+    float* _data ;
+
+    FloatVector (const FloatVector&);
+    FloatVector& operator = (const FloatVector&);
+  };
+}
+
+#endif
@@ -0,0 +1,204 @@
+/*****************************************************************************
+ * kernbench: micro-benchmarks of computational kernels.
+ *
+ * Usage
+ * -----
+ * kernbench [-h] [-t time] [-z nz] session
+ *
+ * Synopsis
+ * --------
+ * Set up the 2D mesh and elements described in session, then time the
+ * kernels that dominate solver run times:
+ *
+ *   mxm       : Blas::mxm of two N_P x N_P matrices;
+ *   grad2     : Femlib::grad2 over all element planes;
+ *   DFTr      : Femlib::DFTr, forward + inverse, of nz planes;
+ *   helmholtz : Element::HelmholtzOp applied on every element.
+ *
+ * Each kernel is repeated enough times that a sample takes at least
+ * time/NSAMP seconds (default time is 1 s), NSAMP samples are taken,
+ * and the median wall-clock time per call is reported.  Output is one
+ * "micro/kernel seconds" pair per line on cout, as read by testbench.
+ *
+ * The number of planes for DFTr is N_Z if that is greater than 2,
+ * otherwise the -z value (default 32).
+ *
+ * @file test/kernbench.cpp
+ *****************************************************************************/
+// Copyright (c) 1999+, Hugh M Blackburn
+
+#include <sem.h>
+#include <chrono>
+#include <algorithm>
+
+static char  prog[] = "kernbench";
+static const int_t NSAMP = 5;
+
+static void   getargs (int, char**, char*&, real_t&, int_t&);
+static real_t timeit  (void (*)(), const real_t);
+
+// -- Data used by kernels (set up in main).
+
+static int_t            NP, NEL, NZB, NPL;
+static const real_t     *DV, *DT;
+static vector<real_t>   A, B, C, U, UR, US, Z, W, K;
+static vector<Element*> Esys;
+
+static void kern_mxm   ()
+{ Blas::mxm (&A[0], NP, &B[0], NP, &C[0], NP); }
+
+static void kern_grad2 ()
+{ Femlib::grad2 (&U[0], &U[0], &UR[0], &US[0], DV, DT, NP, NP, NEL); }
+
+static void kern_DFTr  ()
+{
+  Femlib::DFTr (&Z[0], NZB, NPL, FORWARD);
+  Femlib::DFTr (&Z[0], NZB, NPL, INVERSE);
+}
+
+static void kern_helmholtz ()
+{
+  const int_t npnp = NP * NP;
+  real_t*     u    = &U[0];
+  real_t*     v    = &UR[0];
+  int_t       i;
+
+  for (i = 0; i < NEL; i++, u += npnp, v += npnp)
+    Esys[i] -> HelmholtzOp (1.0, &K[0], 1.0, u, v, &W[0]);
+}
+
+
+int main (int    argc,
+	  char** argv)
+// ---------------------------------------------------------------------------
+// Driver.
+// ---------------------------------------------------------------------------
+{
+  char*  session = 0;
+  real_t tmin    = 1.0;
+  int_t  nz      = 32;
+  int_t  i, NZ;
+  FEML*  F;
+  Mesh*  M;
+  char   buf[StrMax];
+
+  Femlib::init ();
+
+  getargs (argc, argv, session, tmin, nz);
+
+  F   = new FEML (session);
+  M   = new Mesh (F);
+
+  NEL = M -> nEl();
+  NP  = Femlib::ivalue ("N_P");
+  NZ  = Femlib::ivalue ("N_Z");
+  NZB = (NZ > 2) ? NZ : nz;
+
+  Geometry::set (NP, NZ, NEL, (Femlib::ivalue ("CYLINDRICAL")) ?
+		 Geometry::Cylindrical : Geometry::Cartesian);
+
+  Esys.resize (NEL);
+  for (i = 0; i < NEL; i++) Esys[i] = new Element (i, NP, M);
+
+  NPL = Geometry::planeSize();
+
+  Femlib::quadrature (0, 0, &DV, 0,   NP, GLJ, 0.0, 0.0);
+  Femlib::quadrature (0, 0, 0,   &DT, NP, GLJ, 0.0, 0.0);
+
+  A.resize  (NP * NP);        B.resize  (NP * NP);   C.resize (NP * NP);
+  U.resize  (NPL);            UR.resize (NPL);       US.resize (NPL);
+  Z.resize  (NZB * NPL);      W.resize  (2 * NP * NP);
+  K.resize  (NP * NP, Femlib::value ("KINVIS"));
+
+  for (i = 0; i < A.size(); i++) { A[i] = drand48(); B[i] = drand48(); }
+  for (i = 0; i < U.size(); i++)   U[i] = drand48();
+  for (i = 0; i < Z.size(); i++)   Z[i] = drand48();
+
+  cout << "micro/mxm "       << timeit (kern_mxm,       tmin) << endl;
+  cout << "micro/grad2 "     << timeit (kern_grad2,     tmin) << endl;
+  cout << "micro/DFTr "      << timeit (kern_DFTr,      tmin) << endl;
+  cout << "micro/helmholtz " << timeit (kern_helmholtz, tmin) << endl;
+
+  return EXIT_SUCCESS;
+}
+
+
+static real_t timeit (void         (*kernel)(),
+		      const real_t tmin       )
+// ---------------------------------------------------------------------------
+// Return median over NSAMP samples of wall-clock seconds per kernel call.
+// The number of calls per sample is doubled until a sample takes at
+// least tmin/NSAMP seconds.
+// ---------------------------------------------------------------------------
+{
+  typedef std::chrono::steady_clock Clock;
+
+  const real_t   tsamp = tmin / NSAMP;
+  long           reps  = 1, j;
+  int_t          i;
+  real_t         dt;
+  vector<real_t> sample (NSAMP);
+
+  kernel ();			// -- Warm up (caches, FFT set-up).
+
+  while (true) {
+    Clock::time_point t0 = Clock::now();
+    for (j = 0; j < reps; j++) kernel ();
+    dt = std::chrono::duration<real_t> (Clock::now() - t0).count();
+    if (dt >= tsamp) break;
+    reps *= 2;
+  }
+
+  for (i = 0; i < NSAMP; i++) {
+    Clock::time_point t0 = Clock::now();
+    for (j = 0; j < reps; j++) kernel ();
+    sample[i] = std::chrono::duration<real_t> (Clock::now() - t0).count();
+  }
+
+  sort (sample.begin(), sample.end());
+
+  return sample[NSAMP / 2] / reps;
+}
+
+
+static void getargs (int     argc   ,
+		     char**  argv   ,
+		     char*&  session,
+		     real_t& tmin   ,
+		     int_t&  nz     )
+// ---------------------------------------------------------------------------
+// Deal with command-line arguments.
+// ---------------------------------------------------------------------------
+{
+  char usage[] = "Usage: kernbench [options] session\n"
+    "options:\n"
+    "-h      ... print this message\n"
+    "-t time ... approximate seconds spent timing each kernel [Default: 1]\n"
+    "-z nz   ... number of planes for DFTr if session is 2D [Default: 32]\n";
+
+  while (--argc && **++argv == '-')
+    switch (*++argv[0]) {
+    case 'h':
+      cout << usage;
+      exit (EXIT_SUCCESS);
+      break;
+    case 't':
+      if (*++argv[0]) tmin = atof (*argv);
+      else { --argc;  tmin = atof (*++argv); }
+      break;
+    case 'z':
+      if (*++argv[0]) nz = atoi (*argv);
+      else { --argc;  nz = atoi (*++argv); }
+      break;
+    default:
+      cerr << usage;
+      exit (EXIT_FAILURE);
+      break;
+    }
+
+  if   (argc != 1) { cerr << usage; exit (EXIT_FAILURE); }
+  else session = *argv;
+
+  if (tmin <= 0.0) Veclib::alert (prog, "timing interval must be > 0", ERROR);
+  if (nz < 4 || nz & 1) Veclib::alert (prog, "nz must be even, >= 4", ERROR);
+}
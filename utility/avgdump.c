@@ -8,6 +8,7 @@
  * -h       ... print this message
  * -i       ... initialise averaging
  * -r <eps> ... weight new file by eps and old file by (1-eps)
+ * -n <num> ... take dump number <num> from new.file [Default: 1]
  *
  * Synopsis
  * --------
@@ -21,7 +22,10 @@
  * contributed to it, and "new.file"'s data is added in with
  * appropriate weight.  Averaging is initialised using the
  * command-line flag "-i", which adds the data in the two files with
- * equal weight.  Only the first dump in each file is dealt with.
+ * equal weight.  Only the first dump in "old.file" is dealt with;
+ * by default the same is true of "new.file", but another dump in it
+ * can be selected with "-n".  If "new.file" has a (valid) index file,
+ * new.file.idx, we seek directly to that dump (see femlib/fldindex.c).
  *
  * A new binary file is written to stdout.  The step number is set to
  * reflect the number of averages that have been done to the data.
@@ -69,8 +73,10 @@ static char RCS[] = "$Id$";
 
 #include <cfemdef.h>
 #include <cveclib.h>
+#include <cfemlib.h>
 
 static char  prog[]    = "avgdump";
+static char* newname   = 0;
 static const char* hdr_fmt[] = {	 /* -- Header output formatting. */
   "%-25s "             "Session\n",
   "%-25s "             "Created\n",
@@ -101,8 +107,9 @@ typedef struct {		 /* -- Data information structure. */
 } Dump;
 
 
-static void getargs   (int, char**, FILE**, FILE**, int*, double*);
+static void getargs   (int, char**, FILE**, FILE**, int*, double*, int*);
 static void getheader (FILE*, Dump*);
+static void seekdump  (FILE*, Dump*, int);
 static void getdata   (FILE*, Dump*);
 static void runavg    (Dump*, Dump*, int, double);
 static void printup   (FILE*, Dump*);
@@ -116,15 +123,16 @@ int main (int    argc,
 {
   FILE   *oldfile = 0, *newfile = 0;
   Dump   *olddump = 0, *newdump = 0;
-  int    init     = 0;
+  int    init     = 0, ndump = 1;
   double relax    = -1.0;	/* -- If positive we do relaxation. */
 
-  getargs (argc, argv, &oldfile, &newfile, &init, &relax);
+  getargs (argc, argv, &oldfile, &newfile, &init, &relax, &ndump);
 
   olddump = (Dump*) calloc (1, sizeof (Dump));
   newdump = (Dump*) calloc (1, sizeof (Dump));
 
   getheader (oldfile, olddump);
+  seekdump  (newfile, newdump, ndump);
   getheader (newfile, newdump);
 
   if (olddump -> nr  != newdump -> nr  ||
@@ -150,7 +158,8 @@ static void getargs (int     argc   ,
 		     FILE**  oldfile,
 		     FILE**  newfile,
 		     int*    init   ,
-		     double* relax  )
+		     double* relax  ,
+		     int*    ndump  )
 /* ------------------------------------------------------------------------- *
  * Parse command-line arguments.
  * ------------------------------------------------------------------------- */
@@ -160,7 +169,8 @@ static void getargs (int     argc   ,
     "options:\n"
     "  -h       ... display this message\n"
     "  -i       ... initialise averaging\n"
-    "  -r <eps> ... weight new file by eps and old file by (1-eps)\n";
+    "  -r <eps> ... weight new file by eps and old file by (1-eps)\n"
+    "  -n <num> ... take dump number <num> from new file [Default: 1]\n";
     
   char err[STR_MAX], c;
 
@@ -174,6 +184,10 @@ static void getargs (int     argc   ,
       if (*++argv[0]) *relax = atof (*argv);
       else {*relax = atof (*++argv); argc--;}
       break;
+    case 'n': 
+      if (*++argv[0]) *ndump = atoi (*argv);
+      else {*ndump = atoi (*++argv); argc--;}
+      break;
     default:
       sprintf (err, "illegal option: %c\n", c);
       message (prog, err, ERROR);
@@ -182,7 +196,7 @@ static void getargs (int     argc   ,
 
   if (argc == 2) {
     *oldfile = efopen (argv[0], "r");
-    *newfile = efopen (argv[1], "r");
+    *newfile = efopen (newname = argv[1], "r");
   } else {
     fprintf (stderr, usage); exit (EXIT_FAILURE);
   }  
@@ -222,6 +236,34 @@ static void getheader (FILE* f,
 }
 
 
+static void seekdump (FILE* f    ,
+		      Dump* h    ,
+		      int   ndump)
+/* ------------------------------------------------------------------------- *
+ * Position f at the start of dump number ndump, either directly via
+ * the file's index or by skipping over the headers and data of the
+ * dumps before it.
+ * ------------------------------------------------------------------------- */
+{
+  long offset;
+  int  i;
+
+  if (ndump < 2) return;
+
+  if ((offset = fldidx_offset (newname, ndump)) >= 0) {
+    fseek (f, offset, SEEK_SET);
+    return;
+  }
+
+  for (i = 1; i < ndump; i++) {
+    getheader (f, h);
+    if (fseek (f, (long) h -> nr * h -> ns * h -> nz * h -> nel *
+	       strlen (h -> field) * sizeof (double), SEEK_CUR) || feof (f))
+      message (prog, "requested dump not found in new file", ERROR);
+  }
+}
+
+
 static void getdata (FILE* f,
 		     Dump* h)
 /* ------------------------------------------------------------------------- *
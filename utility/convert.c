@@ -3,7 +3,7 @@
  *
  * Usage
  * -----
- * convert [-h] [-b|s|a] [-v] [-n dump] [-o output] [-z] [input[.fld]
+ * convert [-h] [-b|s|a] [-v] [-n dump|-t time] [-o output] [-z] [input[.fld]
  *
  *
  * Synopsis
@@ -18,6 +18,14 @@
  * If both -s & -b are specified then whichever is last on the comand line
  * takes precedence. -z sets the Step and Time to zero.
  *
+ * With -n, if the input file has a (valid) index file input.idx, we
+ * seek directly to the selected dump, otherwise the preceding dumps
+ * are read through in turn.  See femlib/fldindex.c and utility/fldindex.c.
+ *
+ * With -t, the dump selected is the first whose time is not less than
+ * the given time.  It is looked up in the index, which is (re)built
+ * first if it is missing or does not reach that time.
+ *
  * Each input is read into an internal buffer in machine's double binary
  * format prior to output.
  *
@@ -48,11 +56,15 @@
 #include <string.h>
 #include <ctype.h>
 
+#include <cfemdef.h>
+#include <cfemlib.h>
+
 typedef enum { UNKNOWN, ASCII, IEEE_BIG, IEEE_LITTLE } FORMAT;
 
 static char  prog[]  = "convert";
 
 static int   verbose = 0;
+static char  fldname[FILENAME_MAX];
 static char  usage[] = "Usage: convert [-format] [-h] [-v] [-o output] "
                        "[input[.fld]]\n"
                        "format can be one of:\n"
@@ -62,11 +74,13 @@ static char  usage[] = "Usage: convert [-format] [-h] [-v] [-o output] "
                        "other options are:\n"
                        "  -h        ... print this message\n"
                        "  -n dump   ... select dump number\n"
+                       "  -t time   ... select first dump at or after time\n"
                        "  -v        ... be verbose\n"
                        "  -o output ... output to named file\n"
                        "  -z        ... zero Time and Step in output\n";
     
-static void   getargs      (int, char**, FILE**, FILE**, FORMAT*, int*, int*);
+static void   getargs      (int, char**, FILE**, FILE**, FORMAT*, int*, int*,
+			    double*);
 static void   error        (const char*);
 static void   get_data     (FILE*, const int, const FORMAT, const FORMAT,
 			    const int, const int, double**);
@@ -89,13 +103,28 @@ int main (int    argc,
   double** data;
   int      nfields, npts, n, nr, ns, nz, nel;
   int      ndump = 0, nread = 0, selected = 1, zero = 0;
+  double   time = -1.0;
+  long     offset;
   FILE*    fp_in    = stdin;
   FILE*    fp_out   = stdout;
   FORMAT   inputF   = UNKNOWN,
            outputF  = UNKNOWN,
            machineF = architecture();
 
-  getargs (argc, argv, &fp_in, &fp_out, &outputF, &ndump, &zero);
+  getargs (argc, argv, &fp_in, &fp_out, &outputF, &ndump, &zero, &time);
+
+  if (time >= 0.0) {
+    if (fp_in == stdin) error ("-t needs a named input file");
+    if (!(ndump = fldidx_find (fldname, time)) && fldidx_build (fldname) > 0)
+      ndump = fldidx_find (fldname, time);
+    if (!ndump) error ("no dump at or after requested time");
+  }
+
+  if (ndump > 1 && fp_in != stdin &&
+      (offset = fldidx_offset (fldname, ndump)) >= 0) {
+    fseek (fp_in, offset, SEEK_SET);
+    nread = ndump - 1;
+  }
 
   while (fgets (buf, BUFSIZ, fp_in)) {
 
@@ -195,7 +224,8 @@ static void getargs (int     argc  ,
 		     FILE**  fp_out,
 		     FORMAT* outf  ,
 		     int*    ndump ,
-		     int*    zero  )
+		     int*    zero  ,
+		     double* time  )
 /* ------------------------------------------------------------------------- *
  * Parse command line arguments.
  * ------------------------------------------------------------------------- */
@@ -240,6 +270,15 @@ static void getargs (int     argc  ,
       }
       break;
       
+    case 't':
+      if (*++argv[0])
+	*time = atof (*argv);
+      else {
+	*time = atof (*++argv);
+	argc--;
+      }
+      break;
+
     case 's':
       i = iformat ();
       switch (i) {
@@ -283,15 +322,17 @@ static void getargs (int     argc  ,
       break;
     }
 
-  if (argc == 1)
-    if ((*fp_in = fopen (*argv, "r")) == (FILE*) NULL) {
-      sprintf (fname, "%s.fld", *argv);
-      if ((*fp_in = fopen (fname, "r")) == (FILE*) NULL) {
+  if (argc == 1) {
+    strcpy (fldname, *argv);
+    if ((*fp_in = fopen (fldname, "r")) == (FILE*) NULL) {
+      sprintf (fldname, "%s.fld", *argv);
+      if ((*fp_in = fopen (fldname, "r")) == (FILE*) NULL) {
 	fprintf(stderr, "%s: unable to open input file -- %s or %s\n",
-		prog, *argv, fname);
+		prog, *argv, fldname);
 	exit (EXIT_FAILURE);
       }
     }
+  }
 
   return;
 }
@@ -50,7 +50,7 @@ int main (int    argc,
 
     // - Create u[i].
 
-    u[i] = new Data2DF (h.nr, h.nz, h.nel, h.flds[i]);
+    u[i] = new Data2DF (h.nr, h.nz, h.nel, h.flds[i], h.sym);
 
     // -- Read in u[i] and byte-swap if necessary.
 
@@ -0,0 +1,85 @@
+/*****************************************************************************
+ * fldindex: build random-access index files for semtex field files.
+ *
+ * Usage
+ * -----
+ * fldindex [-h] [-v] file[.fld] [file[.fld] ...]
+ *
+ * Synopsis
+ * --------
+ * For each named field file, scan through the dumps it contains and
+ * write an ASCII index file "file.idx" which records the byte offset,
+ * step number, time and field names of every dump.  Utilities which
+ * select a particular dump (e.g. convert -n, sem2vtk -d, probe -d,
+ * avgdump -n) use the index to seek directly to it rather than
+ * reading through all preceding dumps.
+ *
+ * dns writes and maintains the index for session.fld as it runs, so
+ * this utility is only needed for field files from older runs, or
+ * those that have been concatenated or otherwise edited.
+ *
+ * See also femlib/fldindex.c.
+ *
+ * @file utility/fldindex.c
+ * @ingroup group_utility
+ *****************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <cfemdef.h>
+#include <cfemlib.h>
+
+static char prog[]  = "fldindex";
+static char usage[] = "Usage: fldindex [-h] [-v] file[.fld] [file[.fld] ...]\n"
+                      "  -h ... print this message\n"
+                      "  -v ... report number of dumps indexed\n";
+
+
+int main (int    argc,
+	  char** argv)
+/* ------------------------------------------------------------------------- *
+ * Driver.
+ * ------------------------------------------------------------------------- */
+{
+  char  fname[FILENAME_MAX];
+  int   i, verbose = 0, status = EXIT_SUCCESS;
+  int_t ndump;
+  FILE* fp;
+
+  while (--argc && **++argv == '-')
+    switch (*++argv[0]) {
+    case 'h':
+      fputs (usage, stderr);
+      exit  (EXIT_SUCCESS);
+      break;
+    case 'v':
+      verbose = 1;
+      break;
+    default:
+      fprintf (stderr, "%s: unknown option -- %c\n", prog, **argv);
+      fputs   (usage, stderr);
+      exit    (EXIT_FAILURE);
+      break;
+    }
+
+  if (!argc) {
+    fputs (usage, stderr);
+    exit  (EXIT_FAILURE);
+  }
+
+  for (i = 0; i < argc; i++) {
+    strcpy (fname, argv[i]);
+    if (!(fp = fopen (fname, "r"))) sprintf (fname, "%s.fld", argv[i]);
+    else                             fclose  (fp);
+
+    if ((ndump = fldidx_build (fname)) < 1) {
+      fprintf (stderr, "%s: no field dumps found in %s\n", prog, argv[i]);
+      status = EXIT_FAILURE;
+    } else if (verbose)
+      fprintf (stderr, "%s: %s: %1d dumps indexed\n", prog, fname, ndump);
+  }
+
+  return status;
+}
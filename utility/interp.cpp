@@ -272,15 +272,15 @@ static void findPoints (vector<Point*>&   point,
 			bool              quiet)
 // ---------------------------------------------------------------------------
 // Locate points within elements, set Element pointer & r--s locations.
+// Each search starts from the element in which the previous point was
+// found, since successive points are usually close together.
 // ---------------------------------------------------------------------------
 {
-  int_t          i, k, kold;
-  real_t         x, y, r, s;
-  const bool     guess = true;
-  const int_t    NEL   = Esys .size();
+  int_t          i;
+  real_t         x, y, r = 0.0, s = 0.0;
   const int_t    NPT   = point.size();
-  vector<real_t> work(static_cast<size_t>
-		      (max (2*Geometry::nTotElmt(), 5*Geometry::nP()+6)));
+  Element*       E, *hint = 0;
+  const Locator  L (Esys);
 
   elmt.resize (NPT);
   rloc.resize (NPT);
@@ -290,25 +290,13 @@ static void findPoints (vector<Point*>&   point,
 
   cerr.precision (8);
 
-  kold = 0;
   for (i = 0; i < NPT; i++) {
     x = point[i] -> x;
     y = point[i] -> y;
-    if (Esys[kold] -> locate (x, y, r, s, &work[0], guess)) {
-      elmt[i] = Esys[kold];
+    if (E = L.locate (x, y, r, s, hint)) {
+      elmt[i] = hint = E;
       rloc[i] = r;
       sloc[i] = s;
-    } else {
-      for (k = 0; k < NEL; k++) {
-	if (k == kold) continue;
-	if (Esys[k] -> locate (x, y, r, s, &work[0], guess)) {
-	  elmt[i] = Esys[k];
-	  rloc[i] = r;
-	  sloc[i] = s;
-	  kold    = k;
-	  break;
-	}
-      }
     }
 
     if (!elmt[i] && !quiet)
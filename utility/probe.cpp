@@ -16,6 +16,11 @@
  * The field file must be in binary format, and the value of BETA in the
  * session file will override the value given in the field file header.
  *
+ * By default data are extracted from the first dump in the field
+ * file; for all interfaces another can be chosen with "-d <num>".  If
+ * the field file has an index (see utility/fldindex.c) we seek
+ * straight to it.
+ *
  * Interface 1: Extract data at set of points
  * -----------
  *
@@ -81,6 +86,7 @@ typedef enum {			// -- Flags for coordinate axes.
 } AXIS;
 
 static char  *prog;
+static int_t dumpno = 1;
 static void  getargs     (int, char**, char*&, char*&, bool&, int_t&,
 			  char*&, char*&, char*&);
 static int_t loadPoints  (istream&, vector<Point*>&);
@@ -153,6 +159,8 @@ int main (int    argc,
 
   fldfile.open (dump, ios::in);
   if (!fldfile) Veclib::alert (prog, "no field file", ERROR);
+  if (dumpno > 1 && !seekDump (fldfile, dump, dumpno))
+    Veclib::alert (prog, "requested dump not found in field file", ERROR);
   
   // -- Set up 2D mesh information.
   
@@ -243,6 +251,7 @@ static void getargs (int    argc     ,
       "Usage: probe [options] -s session dump\n"
       "  options:\n"
       "  -h      ... print this message\n"
+      "  -d <num>... extract dump <num> from field file [Default: 1]\n"
       "  -m      ... minimal output\n"
       "  -p file ... name file of point data [Default: stdin]\n";
 
@@ -252,6 +261,10 @@ static void getargs (int    argc     ,
 	cout << usage;
 	exit (EXIT_SUCCESS);
 	break;
+      case 'd':
+	if (*++argv[0]) dumpno = atoi (*argv);
+	else { --argc;  dumpno = atoi (*++argv); }
+	break;
       case 'm':
 	minimal = true;
 	break;
@@ -280,7 +293,8 @@ static void getargs (int    argc     ,
   } else if (strcmp (interface, "probeline") == 0) {
 
     char usage[] =
-      "Usage: probeline [-h] -p \"[n:]x0,y0,z0,dx,dy,dz\" -s session dump\n";
+      "Usage: probeline [-h] [-d num] -p \"[n:]x0,y0,z0,dx,dy,dz\" "
+      "-s session dump\n";
     char *tok, *pspec;
     int set = 0;
 
@@ -290,6 +304,10 @@ static void getargs (int    argc     ,
 	cout << usage;
 	exit (EXIT_SUCCESS);
 	break;
+      case 'd':
+	if (*++argv[0]) dumpno = atoi (*argv);
+	else { --argc;  dumpno = atoi (*++argv); }
+	break;
       case 'p':
 	if (*++argv[0])
 	  pspec = *argv;
@@ -363,6 +381,7 @@ static void getargs (int    argc     ,
       "Usage: probeplane [options] -s session dump\n"
       "options:\n"
       "-h                ... print this message\n"
+      "-d #              ... extract dump # from field file [Default: 1]\n"
       "-xy \"x0,y0,dx,dy\" ... xy-cutting plane\n"
       "-xz \"x0,z0,dx,dz\" ... xz-cutting plane\n"
       "-yz \"y0,z0,dy,dz\" ... yz-cutting plane\n"
@@ -382,6 +401,10 @@ static void getargs (int    argc     ,
 	cout << usage;
 	exit (EXIT_SUCCESS);
 	break;
+      case 'd':
+	if (*++argv[0]) dumpno = atoi (*argv);
+	else { --argc;  dumpno = atoi (*++argv); }
+	break;
       case 'n':
 	switch (argv[0][1]) {
 	case 'x':
@@ -662,15 +685,15 @@ static void findPoints (vector<Point*>&   point,
 			vector<real_t>&   sloc )
 // ---------------------------------------------------------------------------
 // Locate points within elements, set Element pointer & r--s locations.
+// Each search starts from the element in which the previous point was
+// found, since successive points are usually close together.
 // ---------------------------------------------------------------------------
 {
-  int_t          i, k;
-  real_t         x, y, z, r, s;
-  const int_t    NEL   = Esys .size();
+  int_t          i;
+  real_t         x, y, z, r = 0.0, s = 0.0;
   const int_t    NPT   = point.size();
-  const bool     guess = true;
-  vector<real_t> work(static_cast<size_t>
-		      (max (2*Geometry::nTotElmt(), 5*Geometry::nP()+6)));
+  Element*       E, *hint = 0;
+  const Locator  L (Esys);
 
   elmt.resize (NPT);
   rloc.resize (NPT);
@@ -684,14 +707,10 @@ static void findPoints (vector<Point*>&   point,
     x = point[i] -> x;
     y = point[i] -> y;
     z = point[i] -> z;
-    for (k = 0; k < NEL; k++) {
-      r = s = 0.0;
-      if (Esys[k] -> locate (x, y, r, s, &work[0], guess)) {
-	elmt[i] = Esys[k];
-	rloc[i] = r;
-	sloc[i] = s;
-	break;
-      }
+    if (E = L.locate (x, y, r, s, hint)) {
+      elmt[i] = hint = E;
+      rloc[i] = r;
+      sloc[i] = s;
     }
 
     if (!elmt[i] && Femlib::ivalue ("PRINT_OUTSIDE") == 0){
@@ -60,6 +60,7 @@ static char usage[] =
 static FILE    *fp_fld = 0,          /* default input files */
                *fp_msh = 0;
 static char    *vtkfile;             /* output file name */
+static char    fldname[FILENAME_MAX];/* input field file name */
 
 static int     nr, ns, nz, nel, nfields;
 static int     nzp = 0, np = 1, dump = 1, cylindrical=0;
@@ -86,6 +87,7 @@ int main (int    argc,
   char fname[STR_MAX];
   char buf  [STR_MAX];
   FILE *fp, *fp_tec;
+  long offset;
 
   fp_msh = stdin;
   strcpy(fname, "tmp.XXXXXX");
@@ -98,6 +100,10 @@ int main (int    argc,
   parse_args  (argc, argv);
 
   read_mesh   (fp_msh);
+  if (dump > 1 && (offset = fldidx_offset (fldname, dump)) >= 0) {
+    fseek (fp_fld, offset, SEEK_SET);
+    dump = 1;
+  }
   while (dump--) read_data (fp_fld);
   interpolate ();
   wrap        ();
@@ -179,10 +185,11 @@ static void parse_args (int    argc,
 
   /* open the input file */
 
-  if ((fp_fld = fopen(*argv, "r")) == (FILE*) NULL) {
-    sprintf(fname, "%s.fld", *argv);
-    if ((fp_fld = fopen(fname, "r")) == (FILE*) NULL) {
-      fprintf(stderr, "sem2vtk: unable to open %s or %s\n", *argv, fname);
+  strcpy (fldname, *argv);
+  if ((fp_fld = fopen(fldname, "r")) == (FILE*) NULL) {
+    sprintf(fldname, "%s.fld", *argv);
+    if ((fp_fld = fopen(fldname, "r")) == (FILE*) NULL) {
+      fprintf(stderr, "sem2vtk: unable to open %s or %s\n", *argv, fldname);
       exit(EXIT_FAILURE);
     }
   }
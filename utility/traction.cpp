@@ -39,7 +39,7 @@ int main (int    argc,
   Domain*                    D;
   vector<Element*>           E;
   int_t                      _nwall, _nline, _npad, DIM;
-  vector<real_t>             _work;
+  vector<real_t>             _work, _swork;
 
   Femlib::init ();
 
@@ -63,7 +63,6 @@ int main (int    argc,
 
     // -- Set up to compute wall shear stresses.    
     
-    const int_t npr = Geometry::nProc();
     const int_t np  = Geometry::nP();
     const int_t nz  = Geometry::nZProc();
 
@@ -75,33 +74,47 @@ int main (int    argc,
 
     // -- Round up length for Fourier transform/exchange.
 
-    if   (npr > 1) _npad += 2 * npr - _npad % (2 * npr);
-    else           _npad += _npad % 2;
+    _npad = Geometry::padLength (_npad);
 
     _work.resize (_npad * nz);
 
+    // -- The spanwise traction is a sine series under symmetry.
+
+    if (Geometry::symmetric()) _swork.resize (_npad * nz);
+
     // --------------------------------------------------------------------
 
     const int_t    nP  = Geometry::nP();
     const int_t    nZ  = Geometry::nZ();
     int_t          i, j, k;
     real_t*        plane;
-    vector<real_t> buffer (_nline);
+    real_t*        stress;
 
     // -- Load the local storage area.
 
     Veclib::zero (_work.size(), &_work[0], 1);
+    if (Geometry::symmetric()) {
+      Veclib::zero (_swork.size(), &_swork[0], 1);
+      stress = &_swork[2*_nline];
+    } else
+      stress = &_work [2*_nline];
 
     if (DIM == 3 || D -> nField() == 4)
-      Field::traction (&_work[0], &_work[_nline], &_work[2*_nline], _nwall,
+      Field::traction (&_work[0], &_work[_nline], stress, _nwall,
 		       _npad, D->u[3],D->u[0],D->u[1],D->u[2]);
     else
-      Field::traction (&_work[0], &_work[_nline], &_work[2*_nline], _nwall,
+      Field::traction (&_work[0], &_work[_nline], stress, _nwall,
 		       _npad, D->u[2],D->u[0],D->u[1]);
 
     // -- Inverse Fourier transform (like Field::bTransform).
 
-    if (nZ > 1)
+    if (Geometry::symmetric()) {
+      Femlib::DCTr (&_work [0], nZ, _npad, INVERSE);
+      Femlib::DSTr (&_swork[0], nZ, _npad, INVERSE);
+      for (i = 0; i < nZ; i++)
+	Veclib::copy (_nline, &_swork[i*_npad + 2*_nline], 1,
+		              &_work [i*_npad + 2*_nline], 1);
+    } else if (nZ > 1)
       if (nZ == 2)
 	Veclib::copy (_npad, &_work[0], 1, &_work[_npad], 1);
       else
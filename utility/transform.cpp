@@ -162,6 +162,7 @@ static bool getDump (istream&          ifile,
   };
   char buf[StrMax], fmt[StrMax], fields[StrMax];
   int_t  i, j, swab, nf, np, nz, nel;
+  bool   sym;
 
   if (ifile.getline(buf, StrMax).eof()) return 0;
   
@@ -174,8 +175,9 @@ static bool getDump (istream&          ifile,
 
   ifile >> np >> nz >> nz >> nel;
   ifile.getline (buf, StrMax);
+  sym = strstr (buf, "sym") != 0;
   
-  sprintf (fmt, "%1d %1d %1d %1d", np, np, nz, nel);
+  sprintf (fmt, "%1d %1d %1d %1d%s", np, np, nz, nel, (sym) ? " sym" : "");
   sprintf (buf, hdr_fmt[2], fmt);
   ofile << buf;
 
@@ -207,7 +209,7 @@ static bool getDump (istream&          ifile,
 
   if (u.size() != nf) {
     u.resize (nf);
-    for (i = 0; i < nf; i++) u[i] = new Data2DF (np, nz, nel, fields[i]);
+    for (i = 0; i < nf; i++) u[i] = new Data2DF (np, nz, nel, fields[i], sym);
   }
 
   for (i = 0; i < nf; i++) {
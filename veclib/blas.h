@@ -87,6 +87,14 @@ extern "C" {
 			  const float& alpha, const float* ap,
 			  const float* x, const int_t& incx,
 			  const float& beta, float* y, const int_t& incy);
+  void    F77NAME(dtrsv) (const char* uplo, const char* trans,
+			  const char* diag, const int_t& n,
+			  const double* a, const int_t& lda,
+			  double* x, const int_t& incx);
+  void    F77NAME(strsv) (const char* uplo, const char* trans,
+			  const char* diag, const int_t& n,
+			  const float* a, const int_t& lda,
+			  float* x, const int_t& incx);
   void    F77NAME(dgemm) (const char* ta, const char* tb,
 			  const int_t& m, const int_t& n,
 			  const int_t& k, const double& alpha,
@@ -99,6 +107,24 @@ extern "C" {
 			  const float* a, const int_t& lda,
 			  const float* b, const int_t& ldb, 
 			  const float& beta, float* c, const int_t& ldc);
+  void    F77NAME(dtrsm) (const char* side, const char* uplo,
+			  const char* ta, const char* diag,
+			  const int_t& m, const int_t& n, const double& alpha,
+			  const double* a, const int_t& lda,
+			  double* b, const int_t& ldb);
+  void    F77NAME(strsm) (const char* side, const char* uplo,
+			  const char* ta, const char* diag,
+			  const int_t& m, const int_t& n, const float& alpha,
+			  const float* a, const int_t& lda,
+			  float* b, const int_t& ldb);
+  void    F77NAME(dsyrk) (const char* uplo, const char* trans,
+			  const int_t& n, const int_t& k, const double& alpha,
+			  const double* a, const int_t& lda,
+			  const double& beta, double* c, const int_t& ldc);
+  void    F77NAME(ssyrk) (const char* uplo, const char* trans,
+			  const int_t& n, const int_t& k, const float& alpha,
+			  const float* a, const int_t& lda,
+			  const float& beta, float* c, const int_t& ldc);
   void   F77NAME(dmxm)   (const double* a, const int_t& nra,
 			  const double* b, const int_t& nca,
 			        double* c, const int_t& ncb);
@@ -265,6 +291,17 @@ public:
     F77NAME(sspmv) (uplo,n,alpha,ap,x,incx,beta,y,incy);
   }
 
+  static void trsv (const char* uplo, const char* trans, const char* diag,
+		    const int_t& n, const double* a, const int_t& lda,
+		    double* x, const int_t& incx) {
+    F77NAME(dtrsv) (uplo,trans,diag,n,a,lda,x,incx);
+  }
+  static void trsv (const char* uplo, const char* trans, const char* diag,
+		    const int_t& n, const float* a, const int_t& lda,
+		    float* x, const int_t& incx) {
+    F77NAME(strsv) (uplo,trans,diag,n,a,lda,x,incx);
+  }
+
 #if 0
   static void mxv (const double* A, const int_t& nra, const double* x,
 		   const int_t& nca, double* y) {
@@ -302,6 +339,34 @@ public:
     F77NAME(sgemm) (ta,tb,m,n,k,alpha,a,lda,b,ldb,beta,c,ldc);
   }
 
+  static void trsm (const char* side, const char* uplo,
+		    const char* ta, const char* diag,
+		    const int_t& m, const int_t& n, const double& alpha,
+		    const double* a, const int_t& lda,
+		    double* b, const int_t& ldb) {
+    F77NAME(dtrsm) (side,uplo,ta,diag,m,n,alpha,a,lda,b,ldb);
+  }
+  static void trsm (const char* side, const char* uplo,
+		    const char* ta, const char* diag,
+		    const int_t& m, const int_t& n, const float&  alpha,
+		    const float* a, const int_t& lda,
+		    float* b, const int_t& ldb) {
+    F77NAME(strsm) (side,uplo,ta,diag,m,n,alpha,a,lda,b,ldb);
+  }
+
+  static void syrk (const char* uplo, const char* trans,
+		    const int_t& n, const int_t& k, const double& alpha,
+		    const double* a, const int_t& lda,
+		    const double& beta, double* c, const int_t& ldc) {
+    F77NAME(dsyrk) (uplo,trans,n,k,alpha,a,lda,beta,c,ldc);
+  }
+  static void syrk (const char* uplo, const char* trans,
+		    const int_t& n, const int_t& k, const float&  alpha,
+		    const float* a, const int_t& lda,
+		    const float&  beta, float* c, const int_t& ldc) {
+    F77NAME(ssyrk) (uplo,trans,n,k,alpha,a,lda,beta,c,ldc);
+  }
+
 #if defined (_SX)
 
   static void mxm (const double* A, const int_t& nra, const double* B,